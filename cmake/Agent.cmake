@@ -161,6 +161,7 @@ add_library(core
   fboss/agent/DsfStateUpdaterUtil.cpp
   fboss/agent/DsfSubscriber.cpp
   fboss/agent/DsfSubscription.cpp
+  fboss/agent/DsfUpdateAggregator.cpp
   fboss/agent/FabricConnectivityManager.cpp
   fboss/agent/EncapIndexAllocator.cpp
   fboss/agent/FibHelpers.cpp
@@ -196,7 +197,9 @@ add_library(core
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/NeighborUpdaterNoopImpl.cpp
+  fboss/agent/NexthopDependentsUpdater.cpp
   fboss/agent/PortUpdateHandler.cpp
+  fboss/agent/ResolutionDependencyIndex.cpp
   fboss/agent/ResolvedNexthopMonitor.cpp
   fboss/agent/ResolvedNexthopProbe.cpp
   fboss/agent/ResolvedNexthopProbeScheduler.cpp
@@ -225,10 +228,12 @@ add_library(
    agent_fsdb_sync_manager
    fboss/agent/AgentFsdbSyncManager.cpp
    fboss/agent/AgentFsdbSyncManager-computeOperDelta.cpp
+   fboss/agent/AgentStatsFsdbSyncManager.cpp
 )
 
 target_link_libraries(
   agent_fsdb_sync_manager
+  agent_stats_cpp2
   fsdb_syncer
   hwswitch_matcher
   state
@@ -266,6 +271,7 @@ set(core_libs
   standalone_rib
   state
   state_utils
+  switch_state_memory_usage
   exponential_back_off
   fboss_config_utils
   phy_cpp2
@@ -287,6 +293,7 @@ set(core_libs
   platform_mapping_utils
   sw_switch_warmboot_helper
   hw_write_behavior
+  stage_tracer
   hw_ctrl_cpp2
   loadbalancer_utils
   monolithic_switch_handler
@@ -401,6 +408,15 @@ target_link_libraries(async_logger
   Folly::folly
 )
 
+add_library(binary_trace_logger
+  fboss/agent/BinaryTraceLogger.cpp
+)
+
+target_link_libraries(binary_trace_logger
+  fboss_error
+  Folly::folly
+)
+
 add_library(sflow_shim_utils
   fboss/agent/SflowShimUtils.cpp
 )
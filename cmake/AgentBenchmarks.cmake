@@ -9,6 +9,7 @@ add_library(mono_agent_benchmarks
 
 target_link_libraries(mono_agent_benchmarks
   mono_agent_ensemble
+  function_call_time_reporter
   Folly::folly
 )
 
@@ -36,6 +37,7 @@ add_library(multi_switch_mono_sai_agent_benchmarks_main
 
 target_link_libraries(multi_switch_mono_sai_agent_benchmarks_main
   multi_switch_agent_benchmarks
+  function_call_time_reporter
   Folly::folly
   sai_platform
 )
@@ -100,6 +100,7 @@ target_link_libraries(sai_switch
   sai_platform
   sai_store
   ref_map
+  stage_tracer
   Folly::folly
   ${GTEST}
   ${LIBGMOCK_LIBRARIES}
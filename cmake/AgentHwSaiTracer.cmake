@@ -44,6 +44,7 @@ target_link_libraries(sai_tracer
   fboss_error
   fboss_types
   async_logger
+  binary_trace_logger
   sai_version
   function_call_time_reporter
   tuple_utils
@@ -64,3 +65,44 @@ target_link_options(sai_tracer
   "LINKER:-wrap,sai_api_uninitialize"
   "LINKER:-wrap,sai_get_object_key"
 )
+
+if(BUILD_SAI_FAKE)
+add_executable(sai_trace_decoder
+  fboss/agent/hw/sai/tracer/SaiTraceDecoder.cpp
+)
+
+target_link_libraries(sai_trace_decoder
+  sai_tracer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_trace_decoder PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+install(TARGETS sai_trace_decoder)
+
+add_executable(sai_trace_decoder_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/hw/sai/tracer/tests/SaiTraceDecoderTest.cpp
+)
+
+target_link_libraries(sai_trace_decoder_test
+  sai_tracer
+  fake_sai
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+set_target_properties(sai_trace_decoder_test PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+gtest_discover_tests(sai_trace_decoder_test)
+endif()
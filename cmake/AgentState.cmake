@@ -143,6 +143,17 @@ target_link_libraries(state_utils
   thrift_cow_serializer
 )
 
+add_library(switch_state_memory_usage
+  fboss/agent/state/SwitchStateMemoryUsage.cpp
+)
+
+target_link_libraries(switch_state_memory_usage
+  state
+  ctrl_cpp2
+  thrift_cow_visitors
+  Folly::folly
+)
+
 add_library(label_forwarding_action
   fboss/agent/state/LabelForwardingAction.cpp
 )
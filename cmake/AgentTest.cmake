@@ -85,6 +85,32 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(agent_stats_fsdb_sync_manager_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/test/AgentStatsFsdbSyncManagerTest.cpp
+)
+
+target_link_libraries(agent_stats_fsdb_sync_manager_test
+  agent_fsdb_sync_manager
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(agent_stats_fsdb_sync_manager_test)
+
+add_executable(binary_trace_logger_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/test/BinaryTraceLoggerTest.cpp
+)
+
+target_link_libraries(binary_trace_logger_test
+  binary_trace_logger
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(binary_trace_logger_test)
+
 add_library(agent_test_lib
   fboss/agent/test/AgentTest.cpp
 )
@@ -415,6 +415,7 @@ add_executable(fboss2
   fboss/cli/fboss2/utils/CmdUtilsCommon.cpp
   fboss/cli/fboss2/utils/Table.cpp
   fboss/cli/fboss2/utils/HostInfo.h
+  fboss/cli/fboss2/utils/ParallelHostQuery.h
   fboss/cli/fboss2/utils/FilterOp.h
   fboss/cli/fboss2/utils/AggregateOp.h
   fboss/cli/fboss2/utils/AggregateUtils.h
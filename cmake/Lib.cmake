@@ -58,6 +58,15 @@ target_link_libraries(function_call_time_reporter
   Folly::folly
 )
 
+add_library(stage_tracer
+  fboss/lib/StageTracer.cpp
+)
+
+target_link_libraries(stage_tracer
+  fb303::fb303
+  Folly::folly
+)
+
 add_library(fboss_i2c_lib
   fboss/lib/usb/GalaxyI2CBus.cpp
   fboss/lib/usb/BaseWedgeI2CBus.cpp
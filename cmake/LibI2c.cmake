@@ -13,3 +13,12 @@ target_link_libraries(i2c_ctrl
   i2c_controller_stats_cpp2
   Folly::folly
 )
+
+add_library(i2c_transaction_scheduler
+  fboss/lib/i2c/I2cTransactionScheduler.cpp
+)
+
+target_link_libraries(i2c_transaction_scheduler
+  i2c_controller_stats_cpp2
+  Folly::folly
+)
@@ -0,0 +1,17 @@
+# CMake to build libraries and binaries in fboss/lib/i2c/tests
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(i2c_transaction_scheduler_test
+  fboss/lib/i2c/tests/I2cTransactionSchedulerTest.cpp
+)
+
+target_link_libraries(i2c_transaction_scheduler_test
+  i2c_transaction_scheduler
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(i2c_transaction_scheduler_test)
@@ -41,12 +41,21 @@ add_fbthrift_cpp_library(
    platform_manager_snapshot_cpp2
 )
 
+add_library(platform_manager_device_waiter
+  fboss/platform/platform_manager/DeviceWaiter.cpp
+)
+
+target_link_libraries(platform_manager_device_waiter
+  Folly::folly
+)
+
 add_library(platform_manager_i2c_explorer
   fboss/platform/platform_manager/I2cExplorer.cpp
 )
 
 target_link_libraries(platform_manager_i2c_explorer
   fmt::fmt
+  platform_manager_device_waiter
   platform_manager_config_cpp2
   i2c_ctrl
   platform_utils
@@ -91,6 +100,7 @@ add_library(platform_manager_pci_explorer
 )
 
 target_link_libraries(platform_manager_pci_explorer
+  platform_manager_device_waiter
   platform_manager_i2c_explorer
   platform_manager_config_cpp2
   platform_manager_utils
@@ -142,6 +152,7 @@ target_link_libraries(platform_manager_config_validator
 add_executable(platform_manager
   fboss/platform/platform_manager/ConfigValidator.cpp
   fboss/platform/platform_manager/DataStore.cpp
+  fboss/platform/platform_manager/DeviceWaiter.cpp
   fboss/platform/platform_manager/I2cExplorer.cpp
   fboss/platform/platform_manager/Main.cpp
   fboss/platform/platform_manager/PciExplorer.cpp
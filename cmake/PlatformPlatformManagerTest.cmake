@@ -14,6 +14,17 @@ target_link_libraries(platform_manager_config_validator_test
   ${LIBGMOCK_LIBRARIES}
 )
 
+add_executable(platform_manager_device_waiter_test
+  fboss/platform/platform_manager/tests/DeviceWaiterTest.cpp
+)
+
+target_link_libraries(platform_manager_device_waiter_test
+  platform_manager_device_waiter
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
 add_executable(platform_manager_i2c_explorer_test
   fboss/platform/platform_manager/tests/I2cExplorerTest.cpp
 )
@@ -31,6 +31,7 @@ target_link_libraries(qsfp_lib
     qsfp_bsp_core
     thrift_cow_serializer
     io_stats_recorder
+    i2c_transaction_scheduler
 )
 
 add_library(qsfp_config
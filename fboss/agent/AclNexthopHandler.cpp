@@ -6,43 +6,76 @@
 #include "fboss/agent/SwitchIdScopeResolver.h"
 #include "fboss/agent/state/AclEntry.h"
 #include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/SwitchState.h"
 
 namespace facebook::fboss {
 
-using DeltaFunctions::isEmpty;
-
-AclNexthopHandler::AclNexthopHandler(SwSwitch* sw) : sw_(sw) {
-  sw_->registerStateObserver(this, "AclNexthopHandler");
-}
-AclNexthopHandler::~AclNexthopHandler() {
-  sw_->unregisterStateObserver(this);
-}
-bool AclNexthopHandler::hasAclChanges(const StateDelta& delta) {
-  bool aclsChanged = (sw_->getState()->getAcls()->numNodes() > 0) &&
-      (!isEmpty(delta.getAclsDelta()));
-  aclsChanged =
-      (aclsChanged || !isEmpty(delta.getFibsDelta()) ||
-       !isEmpty(delta.getLabelForwardingInformationBaseDelta()));
-  XLOG(DBG2) << "aclsChanged: " << aclsChanged;
-  return aclsChanged;
+namespace {
+bool hasRedirectToNextHop(const std::shared_ptr<AclEntry>& aclEntry) {
+  const auto& action = aclEntry->getAclAction();
+  return action && action->cref<switch_state_tags::redirectToNextHop>();
 }
 
-void AclNexthopHandler::stateUpdated(const StateDelta& delta) {
-  if (!hasAclChanges(delta)) {
-    return;
+ResolutionDependencyIndex::Dependencies getDependencies(
+    const std::shared_ptr<AclEntry>& aclEntry) {
+  ResolutionDependencyIndex::Dependencies deps;
+  // THRIFT_COPY
+  auto action = MatchAction::fromThrift(aclEntry->getAclAction()->toThrift());
+  for (const auto& nhIpStruct :
+       *action.getRedirectToNextHop().value().first.redirectNextHops()) {
+    deps.routeLookups.emplace_back(*nhIpStruct.ip());
   }
+  return deps;
+}
+} // namespace
+
+AclNexthopHandler::AclNexthopHandler(SwSwitch* sw) : sw_(sw) {}
 
-  auto updateAclsFn = [this](const std::shared_ptr<SwitchState>& state) {
-    return handleUpdate(state);
+bool AclNexthopHandler::processDelta(const StateDelta& delta) {
+  auto aclAddedOrChanged = [this](const std::shared_ptr<AclEntry>& aclEntry) {
+    if (!hasRedirectToNextHop(aclEntry)) {
+      dependencies_.removeDependent(aclEntry->getID());
+      pendingAcls_.erase(aclEntry->getID());
+      return;
+    }
+    dependencies_.setDependencies(
+        aclEntry->getID(), getDependencies(aclEntry));
+    pendingAcls_.insert(aclEntry->getID());
   };
-  sw_->updateState("Updating ACLs", updateAclsFn);
+  DeltaFunctions::forEachChanged(
+      MultiSwitchMapDelta<MultiSwitchAclMap>(
+          delta.oldState()->getAcls().get(), delta.newState()->getAcls().get()),
+      [&](const auto& /*oldAcl*/, const auto& newAcl) {
+        aclAddedOrChanged(newAcl);
+      },
+      aclAddedOrChanged,
+      [this](const std::shared_ptr<AclEntry>& aclEntry) {
+        dependencies_.removeDependent(aclEntry->getID());
+        pendingAcls_.erase(aclEntry->getID());
+      });
+
+  auto affected = dependencies_.getAffected(delta);
+  pendingAcls_.insert(affected.begin(), affected.end());
+  XLOG(DBG2) << "ACLs pending next hop resolution: " << pendingAcls_.size();
+  return !pendingAcls_.empty();
 }
 
-std::shared_ptr<SwitchState> AclNexthopHandler::handleUpdate(
+std::shared_ptr<SwitchState> AclNexthopHandler::resolvePendingAcls(
     const std::shared_ptr<SwitchState>& state) {
+  if (pendingAcls_.empty()) {
+    return nullptr;
+  }
   auto newState = state->clone();
-  if (!updateAcls(newState)) {
+  bool changed = false;
+  for (const auto& aclName : pendingAcls_) {
+    auto aclEntry = state->getAcls()->getNodeIf(aclName);
+    if (aclEntry && updateAcl(aclEntry, newState)) {
+      changed = true;
+    }
+  }
+  pendingAcls_.clear();
+  if (!changed) {
     return std::shared_ptr<SwitchState>(nullptr);
   }
   return newState;
@@ -89,24 +122,6 @@ void AclNexthopHandler::resolveActionNexthops(MatchAction& action) {
   action.setRedirectToNextHop(std::make_pair(redirect.value().first, nexthops));
 }
 
-std::shared_ptr<MultiSwitchAclMap> AclNexthopHandler::updateAcls(
-    std::shared_ptr<SwitchState>& newState) {
-  bool changed = false;
-  auto origmultiSwitchAcls = newState->getAcls();
-  for (const auto& mIter : std::as_const(*origmultiSwitchAcls)) {
-    auto origAcls = mIter.second;
-    for (const auto& iter : std::as_const(*origAcls)) {
-      if (updateAcl(iter.second, newState)) {
-        changed = true;
-      }
-    }
-  }
-  if (!changed) {
-    return nullptr;
-  }
-  return newState->getAcls();
-}
-
 AclEntry* FOLLY_NULLABLE AclNexthopHandler::updateAcl(
     const std::shared_ptr<AclEntry>& origAclEntry,
     std::shared_ptr<SwitchState>& newState) {
@@ -2,31 +2,43 @@
 
 #pragma once
 
-#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/ResolutionDependencyIndex.h"
 #include "fboss/agent/state/StateDelta.h"
 
+#include <set>
+#include <string>
+
 namespace facebook::fboss {
 class SwSwitch;
 
-class AclNexthopHandler : public StateObserver {
+/*
+ * Resolves the next hops of redirect ACLs. Driven by
+ * NexthopDependentsUpdater, which folds the result into the same state
+ * update as mirror resolution.
+ */
+class AclNexthopHandler {
  public:
   explicit AclNexthopHandler(SwSwitch* sw);
-  ~AclNexthopHandler() override;
 
-  void stateUpdated(const StateDelta& delta) override;
+  /*
+   * Queue redirect ACLs that were added or changed in delta, or whose next
+   * hops are covered by a changed route. Returns true if any are queued.
+   */
+  bool processDelta(const StateDelta& delta);
+  // Re-resolve queued ACLs. Returns null if none of them changed.
+  std::shared_ptr<SwitchState> resolvePendingAcls(
+      const std::shared_ptr<SwitchState>& state);
   void resolveActionNexthops(MatchAction& action);
 
  private:
-  std::shared_ptr<SwitchState> handleUpdate(
-      const std::shared_ptr<SwitchState>& state);
-  std::shared_ptr<MultiSwitchAclMap> updateAcls(
-      std::shared_ptr<SwitchState>& newState);
   AclEntry* FOLLY_NULLABLE updateAcl(
       const std::shared_ptr<AclEntry>& origAclEntry,
       std::shared_ptr<SwitchState>& newState);
-  bool hasAclChanges(const StateDelta& delta);
 
   SwSwitch* sw_;
+  // Redirect ACLs keyed by the next hop addresses they redirect to
+  ResolutionDependencyIndex dependencies_;
+  std::set<std::string> pendingAcls_;
 };
 
 } // namespace facebook::fboss
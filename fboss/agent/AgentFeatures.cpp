@@ -68,6 +68,13 @@ DEFINE_int32(
     1,
     "Number of threads to use for DSF remote stream pool");
 
+DEFINE_int32(
+    dsf_update_batch_window_ms,
+    0,
+    "Time to wait for updates from other DSF peers before applying remote "
+    "sysport and rif updates. Updates that arrive while a batch is being "
+    "applied are always merged into the next batch");
+
 DEFINE_bool(
     set_classid_for_my_subnet_and_ip_routes,
     false,
@@ -116,3 +123,26 @@ DEFINE_bool(
     "Enable wrong fabric connection. Done via SDK");
 
 DEFINE_bool(dsf_edsw_platform_mapping, false, "Use EDSW platform mapping");
+
+DEFINE_int32(
+    acl_priority_gap,
+    1,
+    "Spacing between the priorities of consecutive ACLs. With a spacing > 1, "
+    "ACLs keep their priorities across config changes and new ACLs take "
+    "priorities in the gaps, so inserting an ACL does not shift the "
+    "priority of the ACLs after it. 1 assigns contiguous priorities.");
+
+DEFINE_int32(
+    config_apply_threads,
+    0,
+    "Number of threads used to evaluate independent sections of a config "
+    "(e.g. ACLs, QoS policies, control plane) concurrently when applying it. "
+    "0 evaluates the config sequentially. The thread pool is sized on the "
+    "first config applied with a non zero value and is not resized after.");
+
+DEFINE_int32(
+    switch_state_memory_stats_interval_s,
+    0,
+    "Interval at which to export the memory used by each switch state "
+    "subtree, and how much of it is shared with other states, as fb303 "
+    "counters. Walks the entire state, 0 disables it.");
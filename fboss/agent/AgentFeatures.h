@@ -43,6 +43,7 @@ DECLARE_bool(dsf_flush_remote_sysports_and_rifs_on_gr);
 DECLARE_uint32(dsf_num_parallel_sessions_per_remote_interface_node);
 DECLARE_int32(dsf_num_fsdb_connect_threads);
 DECLARE_int32(dsf_num_fsdb_stream_threads);
+DECLARE_int32(dsf_update_batch_window_ms);
 DECLARE_bool(dsf_subscribe_patch);
 
 DECLARE_bool(set_classid_for_my_subnet_and_ip_routes);
@@ -55,3 +56,6 @@ DECLARE_bool(disable_neighbor_solicitation);
 DECLARE_bool(disable_looped_fabric_ports);
 DECLARE_bool(detect_wrong_fabric_connections);
 DECLARE_bool(dsf_edsw_platform_mapping);
+DECLARE_int32(acl_priority_gap);
+DECLARE_int32(config_apply_threads);
+DECLARE_int32(switch_state_memory_stats_interval_s);
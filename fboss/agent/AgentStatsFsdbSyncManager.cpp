@@ -0,0 +1,185 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/AgentStatsFsdbSyncManager.h"
+
+#include <thrift/lib/cpp2/reflection/reflection.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEFINE_bool(
+    publish_agent_stats_delta_to_fsdb,
+    false,
+    "Publish only the agent stats that changed since the previous interval "
+    "to fsdb instead of the full AgentStats struct");
+
+namespace {
+
+using apache::thrift::type_class::structure;
+
+template <typename TC>
+struct IsMapTypeClass : std::false_type {};
+
+template <typename KeyTC, typename MappedTC>
+struct IsMapTypeClass<apache::thrift::type_class::map<KeyTC, MappedTC>>
+    : std::true_type {
+  using MappedTypeClass = MappedTC;
+};
+
+// Structs and maps are diffed member by member and entry by entry, anything
+// else is replaced as a whole when it changes.
+template <typename TC>
+constexpr bool kDiffRecursively =
+    std::is_same_v<TC, structure> || IsMapTypeClass<TC>::value;
+
+template <typename Member>
+constexpr bool isOptional() {
+  return Member::optional::value == apache::thrift::optionality::optional;
+}
+
+// Whether a member or map entry of the published stats, i.e. either an
+// optional primitive or a pointer to a child node, holds value.
+template <typename TC, typename Stored, typename TType>
+bool storedEquals(const Stored& stored, const TType& value) {
+  if (!stored) {
+    return false;
+  }
+  if constexpr (std::is_same_v<TC, structure>) {
+    bool equal = true;
+    fatal::foreach<typename apache::thrift::reflect_struct<TType>::members>(
+        [&](auto indexed) {
+          using member = decltype(fatal::tag_type(indexed));
+          if (!equal) {
+            return;
+          }
+          const auto& storedMember =
+              stored->template cref<typename member::name>();
+          if (isOptional<member>() && !member::is_set(value)) {
+            equal = !storedMember;
+            return;
+          }
+          equal = storedEquals<typename member::type_class>(
+              storedMember, typename member::getter{}(value));
+        });
+    return equal;
+  } else if constexpr (IsMapTypeClass<TC>::value) {
+    using MappedTC = typename IsMapTypeClass<TC>::MappedTypeClass;
+    if (stored->size() != value.size()) {
+      return false;
+    }
+    for (const auto& [key, mapped] : value) {
+      auto it = std::as_const(*stored).find(key);
+      if (it == stored->cend() || !storedEquals<MappedTC>(it->second, mapped)) {
+        return false;
+      }
+    }
+    return true;
+  } else {
+    return stored->toThrift() == value;
+  }
+}
+
+template <typename TC, typename Node, typename TType>
+void updateChanged(std::shared_ptr<Node>& node, const TType& value);
+
+template <typename Node, typename TType>
+void updateChangedMembers(std::shared_ptr<Node>& node, const TType& value) {
+  fatal::foreach<typename apache::thrift::reflect_struct<TType>::members>(
+      [&](auto indexed) {
+        using member = decltype(fatal::tag_type(indexed));
+        using name = typename member::name;
+        using tc = typename member::type_class;
+
+        if (isOptional<member>() && !member::is_set(value)) {
+          if (node->template isSet<name>()) {
+            node->template remove<name>();
+          }
+          return;
+        }
+        const auto& memberValue = typename member::getter{}(value);
+        const auto& storedMember = node->template cref<name>();
+        if (storedEquals<tc>(storedMember, memberValue)) {
+          return;
+        }
+        if constexpr (kDiffRecursively<tc>) {
+          if (storedMember) {
+            updateChanged<tc>(node->template modify<name>(), memberValue);
+            return;
+          }
+        }
+        node->template set<name>(memberValue);
+      });
+}
+
+template <typename MappedTC, typename MapNode, typename ThriftMap>
+void updateChangedEntries(
+    std::shared_ptr<MapNode>& mapNode,
+    const ThriftMap& newMap) {
+  std::vector<typename MapNode::key_type> removed;
+  for (const auto& [key, _] : std::as_const(*mapNode)) {
+    if (newMap.find(key) == newMap.end()) {
+      removed.push_back(key);
+    }
+  }
+  for (const auto& key : removed) {
+    mapNode->remove(key);
+  }
+  for (const auto& [key, newVal] : newMap) {
+    auto oldIt = std::as_const(*mapNode).find(key);
+    if (oldIt == mapNode->cend()) {
+      mapNode->emplace(key, newVal);
+      continue;
+    }
+    if (storedEquals<MappedTC>(oldIt->second, newVal)) {
+      continue;
+    }
+    if constexpr (kDiffRecursively<MappedTC>) {
+      // e.g. only the counters and timestamp of a port's stats
+      mapNode->modifyTyped(key);
+      updateChanged<MappedTC>(mapNode->ref(key), newVal);
+    } else {
+      mapNode->remove(key);
+      mapNode->emplace(key, newVal);
+    }
+  }
+}
+
+// Update node, which must not be published, to hold value. Children which
+// did not change stay shared with the previously published stats, children
+// which did are cloned and updated the same way.
+template <typename TC, typename Node, typename TType>
+void updateChanged(std::shared_ptr<Node>& node, const TType& value) {
+  if constexpr (std::is_same_v<TC, structure>) {
+    updateChangedMembers(node, value);
+  } else {
+    using MappedTC = typename IsMapTypeClass<TC>::MappedTypeClass;
+    updateChangedEntries<MappedTC>(node, value);
+  }
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+AgentStatsFsdbSyncManager::AgentStatsFsdbSyncManager(
+    const std::shared_ptr<fsdb::FsdbPubSubManager>& pubSubMgr,
+    const std::vector<std::string>& basePath)
+    : Base(pubSubMgr, basePath, true /* isStats */, fsdb::PubSubType::DELTA) {}
+
+void AgentStatsFsdbSyncManager::statsUpdated(AgentStats&& stats) {
+  auto newStats = std::make_shared<const AgentStats>(std::move(stats));
+  updateState([newStats = std::move(newStats)](const auto& in) {
+    return applyStatsDelta(in, *newStats);
+  });
+}
+
+std::shared_ptr<AgentStatsFsdbSyncManager::CowAgentStats>
+AgentStatsFsdbSyncManager::applyStatsDelta(
+    const std::shared_ptr<CowAgentStats>& in,
+    const AgentStats& newStats) {
+  auto out = in->clone();
+  updateChanged<structure>(out, newStats);
+  return out;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,47 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/fsdb/client/FsdbSyncManager.h"
+
+#include <memory>
+
+DECLARE_bool(publish_agent_stats_delta_to_fsdb);
+
+namespace facebook::fboss {
+
+/*
+ * Publishes AgentStats to fsdb as deltas instead of full snapshots.
+ *
+ * Each stats interval only the counters that changed since the previous
+ * interval are applied to the thrift_cow copy of the published stats, so
+ * the delta computed by FsdbSyncManager (and the bytes serialized for it)
+ * scale with the number of changed counters rather than with the number
+ * of ports in the system.
+ */
+class AgentStatsFsdbSyncManager
+    : public fsdb::FsdbSyncManager<AgentStats, false /* EnablePatchAPIs */> {
+ public:
+  using Base = fsdb::FsdbSyncManager<AgentStats, false /* EnablePatchAPIs */>;
+  using CowAgentStats = Base::CowState;
+
+  AgentStatsFsdbSyncManager(
+      const std::shared_ptr<fsdb::FsdbPubSubManager>& pubSubMgr,
+      const std::vector<std::string>& basePath);
+
+  void statsUpdated(AgentStats&& stats);
+
+  /*
+   * Return a copy of in updated to newStats. Only the fields that differ
+   * from in are replaced, recursing into structs and map entries, so
+   * children of in that did not change, down to individual counters of a
+   * port, are shared with the returned node.
+   */
+  static std::shared_ptr<CowAgentStats> applyStatsDelta(
+      const std::shared_ptr<CowAgentStats>& in,
+      const AgentStats& newStats);
+};
+
+} // namespace facebook::fboss
@@ -11,7 +11,11 @@
 
 #include <fboss/thrift_cow/nodes/ThriftMapNode-inl.h>
 #include <folly/FileUtil.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/SpookyHashV2.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <memory>
 #include <optional>
@@ -19,6 +23,7 @@
 #include <string>
 
 #include "fboss/agent/AclNexthopHandler.h"
+#include "fboss/agent/AgentFeatures.h"
 
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/HwAsicTable.h"
@@ -75,6 +80,7 @@
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -112,6 +118,7 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibFromConfig(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const std::unordered_set<facebook::fboss::LabelID>* /*changedLabels*/,
     void* cookie) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
       resolver, vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
@@ -123,6 +130,191 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibFromConfig(
   return *nextStatePtr;
 }
 
+/*
+ * The pool is created on first use, so its size is that of
+ * --config_apply_threads when config was first applied with it set. Later
+ * changes of the flag only turn concurrent evaluation on or off.
+ */
+folly::Executor* configApplyExecutor() {
+  if (FLAGS_config_apply_threads <= 0) {
+    return nullptr;
+  }
+  static folly::CPUThreadPoolExecutor executor(
+      FLAGS_config_apply_threads,
+      std::make_shared<folly::NamedThreadFactory>("ConfigApply"));
+  return &executor;
+}
+
+/*
+ * Sections of a config evaluated apart from the rest of it. Given an
+ * executor, each section starts as soon as it is added and runs concurrently
+ * with the caller. Otherwise it runs on the caller's thread when joined.
+ * Sections still running are waited for on destruction, as they reference
+ * the caller's state.
+ */
+class ConfigSectionTasks {
+ public:
+  using TaskId = size_t;
+
+  explicit ConfigSectionTasks(folly::Executor* executor)
+      : executor_(executor) {}
+
+  ~ConfigSectionTasks() {
+    if (!executor_) {
+      return;
+    }
+    for (auto& task : tasks_) {
+      if (task.valid()) {
+        task.wait();
+      }
+    }
+  }
+
+  TaskId add(folly::Function<void()> fn) {
+    auto task = folly::makeSemiFuture().deferValue(
+        [fn = std::move(fn)](folly::Unit) mutable { fn(); });
+    if (executor_) {
+      task = std::move(task).via(folly::getKeepAliveToken(executor_)).semi();
+    }
+    tasks_.push_back(std::move(task));
+    return tasks_.size() - 1;
+  }
+
+  // Wait for a section to be evaluated, rethrowing any error it raised
+  void join(TaskId id) {
+    std::move(tasks_.at(id)).get();
+  }
+
+ private:
+  folly::Executor* executor_;
+  std::vector<folly::SemiFuture<folly::Unit>> tasks_;
+};
+
+/*
+ * Assign priorities to ACLs listed in precedence order, given the priority
+ * each of them had before, if any. Priorities are increasing and within
+ * [minPriority, maxPriority).
+ *
+ * With a gap > 1, the ACLs whose previous priorities are still in order keep
+ * them, and ACLs which are new or moved take priorities in the gaps between
+ * them, spaced by up to gap. Only when a gap is exhausted are the ACLs
+ * after it renumbered, over a window just wide enough to spread them out
+ * again. This way inserting an ACL reprograms a handful of ACLs in hardware,
+ * rather than every ACL after it.
+ */
+std::vector<int> allocateAclPriorities(
+    const std::vector<std::optional<int>>& origPriorities,
+    int minPriority,
+    int maxPriority,
+    int gap) {
+  auto numAcls = origPriorities.size();
+  std::vector<int> priorities(numAcls);
+  auto contiguous = [&]() {
+    for (size_t idx = 0; idx < numAcls; ++idx) {
+      priorities[idx] = minPriority + idx;
+    }
+    return priorities;
+  };
+  if (gap <= 1) {
+    return contiguous();
+  }
+
+  // ACLs keeping their priorities: longest increasing subsequence of the
+  // previous priorities
+  std::vector<bool> keep(numAcls, false);
+  {
+    // tails[len - 1] is the ACL ending the increasing subsequence of length
+    // len with the smallest last priority
+    std::vector<size_t> tails;
+    std::vector<std::optional<size_t>> prev(numAcls);
+    for (size_t idx = 0; idx < numAcls; ++idx) {
+      const auto& origPriority = origPriorities[idx];
+      if (!origPriority || *origPriority < minPriority ||
+          *origPriority >= maxPriority) {
+        continue;
+      }
+      size_t pos = std::lower_bound(
+                       tails.begin(),
+                       tails.end(),
+                       *origPriority,
+                       [&](size_t tail, int priority) {
+                         return *origPriorities[tail] < priority;
+                       }) -
+          tails.begin();
+      if (pos > 0) {
+        prev[idx] = tails[pos - 1];
+      }
+      if (pos == tails.size()) {
+        tails.push_back(idx);
+      } else {
+        tails[pos] = idx;
+      }
+    }
+    std::optional<size_t> idx;
+    if (!tails.empty()) {
+      idx = tails.back();
+    }
+    for (; idx; idx = prev[*idx]) {
+      keep[*idx] = true;
+    }
+  }
+
+  // Exclusive lower bound for the ACLs being placed
+  int64_t low = static_cast<int64_t>(minPriority) - 1;
+  size_t start = 0;
+  while (start < numAcls) {
+    if (keep[start]) {
+      priorities[start] = *origPriorities[start];
+      low = priorities[start];
+      ++start;
+      continue;
+    }
+    // ACLs to place, up to the next ACL keeping its priority
+    size_t end = start;
+    while (end < numAcls && !keep[end]) {
+      ++end;
+    }
+    int64_t high = end < numAcls ? *origPriorities[end] : maxPriority;
+    if (high - low - 1 < static_cast<int64_t>(end - start)) {
+      // The gap is exhausted. Renumber the following ACLs as well, until
+      // the ACLs can be spread at least gap / 8 apart, so that the next
+      // inserts here find room again.
+      auto minStep = std::max(1, gap / 8);
+      while (end < numAcls) {
+        keep[end] = false;
+        while (end < numAcls && !keep[end]) {
+          ++end;
+        }
+        high = end < numAcls ? *origPriorities[end] : maxPriority;
+        if ((high - low) / static_cast<int64_t>(end - start + 1) >= minStep) {
+          break;
+        }
+      }
+      if (high - low - 1 < static_cast<int64_t>(end - start)) {
+        // Out of priorities, fall back to packing all ACLs
+        return contiguous();
+      }
+    }
+    int64_t count = end - start;
+    int64_t step;
+    int64_t first;
+    if (end < numAcls) {
+      // Center the ACLs between their neighbors, leaving room on both sides
+      step = std::min<int64_t>(gap, (high - low) / (count + 1));
+      first = low + (high - low - step * (count - 1)) / 2;
+    } else {
+      step = std::min<int64_t>(gap, (high - low - 1) / count);
+      first = low < minPriority ? minPriority : low + step;
+    }
+    for (size_t idx = start; idx < end; ++idx) {
+      priorities[idx] = first + step * (idx - start);
+    }
+    low = priorities[end - 1];
+    start = end;
+  }
+  return priorities;
+}
+
 template <typename MultiMap, typename EntryT>
 std::shared_ptr<MultiMap> toMultiSwitchMap(
     const std::shared_ptr<EntryT>& entry,
@@ -148,6 +340,133 @@ std::shared_ptr<MultiMap> toMultiSwitchMap(
 
 namespace facebook::fboss {
 
+namespace {
+
+/*
+ * Sections of the config whose SwitchState is derived from config alone.
+ * These can be carried over from the previous config application when
+ * neither their config inputs nor their state have changed since.
+ */
+enum class ConfigSection {
+  CONTROL_PLANE,
+  BUFFER_POOLS,
+  PORT_FLOWLETS,
+  ACLS,
+  QOS_POLICIES,
+  SFLOW_COLLECTORS,
+};
+constexpr std::array<ConfigSection, 6> kConfigSections = {
+    ConfigSection::CONTROL_PLANE,
+    ConfigSection::BUFFER_POOLS,
+    ConfigSection::PORT_FLOWLETS,
+    ConfigSection::ACLS,
+    ConfigSection::QOS_POLICIES,
+    ConfigSection::SFLOW_COLLECTORS,
+};
+
+/*
+ * Hashes config fields into a 128 bit fingerprint. Thrift structs are
+ * compact serialized, lists and maps are length prefixed, so that only the
+ * fingerprint of the previous config needs to be kept around.
+ */
+class ConfigFingerprinter {
+ public:
+  ConfigFingerprinter() {
+    hasher_.Init(0, 0);
+  }
+
+  template <typename T>
+  ConfigFingerprinter& add(const T& input) {
+    if constexpr (apache::thrift::is_thrift_struct_v<T>) {
+      addBytes(
+          apache::thrift::CompactSerializer::serialize<std::string>(input));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      addBytes(input);
+    } else {
+      // Lists and maps of the above
+      addSize(input.size());
+      for (const auto& entry : input) {
+        add(entry);
+      }
+    }
+    return *this;
+  }
+
+  // Map entries
+  template <typename K, typename V>
+  ConfigFingerprinter& add(const std::pair<K, V>& entry) {
+    return add(entry.first).add(entry.second);
+  }
+
+  template <typename FieldRef>
+  ConfigFingerprinter& addOptional(FieldRef field) {
+    addSize(field.has_value() ? 1 : 0);
+    if (field.has_value()) {
+      add(*field);
+    }
+    return *this;
+  }
+
+  ConfigFingerprint finish() {
+    ConfigFingerprint fingerprint;
+    hasher_.Final(&fingerprint.first, &fingerprint.second);
+    return fingerprint;
+  }
+
+ private:
+  void addSize(uint64_t size) {
+    hasher_.Update(&size, sizeof(size));
+  }
+  void addBytes(const std::string& bytes) {
+    addSize(bytes.size());
+    hasher_.Update(bytes.data(), bytes.size());
+  }
+
+  folly::hash::SpookyHashV2 hasher_;
+};
+
+ConfigFingerprint sectionFingerprint(
+    ConfigSection section,
+    const cfg::SwitchConfig& cfg) {
+  ConfigFingerprinter fingerprinter;
+  switch (section) {
+    case ConfigSection::CONTROL_PLANE:
+      // Queues and scope of the CPU port depend on switch settings too
+      fingerprinter.add(*cfg.cpuQueues())
+          .add(*cfg.qosPolicies())
+          .add(*cfg.switchSettings())
+          .addOptional(cfg.cpuTrafficPolicy())
+          .addOptional(cfg.dataPlaneTrafficPolicy());
+      break;
+    case ConfigSection::BUFFER_POOLS:
+      fingerprinter.addOptional(cfg.bufferPoolConfigs());
+      break;
+    case ConfigSection::PORT_FLOWLETS:
+      fingerprinter.addOptional(cfg.portFlowletConfigs());
+      break;
+    case ConfigSection::ACLS:
+      // ACLs may reference mirrors, so a mirror change re-evaluates them
+      fingerprinter.add(*cfg.acls())
+          .add(*cfg.trafficCounters())
+          .add(*cfg.mirrors())
+          .addOptional(cfg.aclTableGroup())
+          .addOptional(cfg.udfConfig())
+          .addOptional(cfg.cpuTrafficPolicy())
+          .addOptional(cfg.dataPlaneTrafficPolicy());
+      break;
+    case ConfigSection::QOS_POLICIES:
+      fingerprinter.add(*cfg.qosPolicies())
+          .addOptional(cfg.dataPlaneTrafficPolicy());
+      break;
+    case ConfigSection::SFLOW_COLLECTORS:
+      fingerprinter.add(*cfg.sFlowCollectors());
+      break;
+  }
+  return fingerprinter.finish();
+}
+
+} // namespace
+
 /*
  * A class for implementing applyThriftConfig().
  *
@@ -164,7 +483,8 @@ class ThriftConfigApplier {
       RoutingInformationBase* rib,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      const PrevAppliedConfig* prevAppliedConfig = nullptr)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -172,7 +492,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        prev_(prevAppliedConfig) {}
 
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
@@ -181,7 +502,8 @@ class ThriftConfigApplier {
       RouteUpdateWrapper* routeUpdater,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      const PrevAppliedConfig* prevAppliedConfig = nullptr)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -189,7 +511,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        prev_(prevAppliedConfig) {}
 
   std::shared_ptr<SwitchState> run();
 
@@ -198,6 +521,8 @@ class ThriftConfigApplier {
   ThriftConfigApplier(ThriftConfigApplier const&) = delete;
   ThriftConfigApplier& operator=(ThriftConfigApplier const&) = delete;
 
+  bool isSectionUnchanged(ConfigSection section) const;
+
   template <typename Node, typename NodeMap>
   bool updateMap(
       NodeMap* map,
@@ -375,6 +700,10 @@ class ThriftConfigApplier {
       const MatchAction* action = nullptr,
       bool enable = true);
   void checkUdfAcl(const std::vector<std::string>& udfGroups) const;
+  std::shared_ptr<AclEntry> getOrigAcl(
+      cfg::AclStage aclStage,
+      const std::string& aclName,
+      const std::optional<std::string>& tableName) const;
   std::shared_ptr<AclEntry> updateAcl(
       cfg::AclStage aclStage,
       const cfg::AclEntry& acl,
@@ -508,6 +837,10 @@ class ThriftConfigApplier {
   SwitchIdScopeResolver scopeResolver_;
   const PlatformMapping* platformMapping_{nullptr};
   const HwAsicTable* hwAsicTable_{nullptr};
+  const PrevAppliedConfig* prev_{nullptr};
+  // Mirrors of new_ as seen by ACLs, which may be evaluated while other
+  // sections are updating new_
+  std::shared_ptr<MultiSwitchMirrorMap> newMirrors_;
 
   struct InterfaceIpInfo {
     InterfaceIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -529,38 +862,97 @@ class ThriftConfigApplier {
   flat_map<PortID, std::vector<int32_t>> port2InterfaceId_;
 };
 
+bool ThriftConfigApplier::isSectionUnchanged(ConfigSection section) const {
+  auto idx = static_cast<size_t>(section);
+  if (!prev_ || !prev_->state || idx >= prev_->fingerprints.size()) {
+    return false;
+  }
+  const auto& prevState = prev_->state;
+  bool sameState = false;
+  switch (section) {
+    case ConfigSection::CONTROL_PLANE:
+      sameState = orig_->getControlPlane() == prevState->getControlPlane();
+      break;
+    case ConfigSection::BUFFER_POOLS:
+      sameState = orig_->getBufferPoolCfgs() == prevState->getBufferPoolCfgs();
+      break;
+    case ConfigSection::PORT_FLOWLETS:
+      sameState =
+          orig_->getPortFlowletCfgs() == prevState->getPortFlowletCfgs();
+      break;
+    case ConfigSection::ACLS:
+      sameState = orig_->getAcls() == prevState->getAcls() &&
+          orig_->getAclTableGroups() == prevState->getAclTableGroups();
+      break;
+    case ConfigSection::QOS_POLICIES:
+      sameState = orig_->getQosPolicies() == prevState->getQosPolicies();
+      break;
+    case ConfigSection::SFLOW_COLLECTORS:
+      sameState =
+          orig_->getSflowCollectors() == prevState->getSflowCollectors();
+      break;
+  }
+  // The state check is a pointer compare, only fingerprint if it passes
+  return sameState &&
+      sectionFingerprint(section, *cfg_) == prev_->fingerprints[idx];
+}
+
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
 
-  {
-    auto newControlPlane = updateControlPlane();
-    if (newControlPlane) {
-      new_->resetControlPlane(std::move(newControlPlane));
-      changed = true;
+  /*
+   * Sections which only read the config and orig_ are evaluated as tasks,
+   * concurrently with the sections after them when --config_apply_threads
+   * is set. Each is joined and merged into new_ before the first section
+   * which reads it from new_, or where it used to be evaluated otherwise.
+   *
+   * The outputs of the tasks are declared ahead of tasks, so that if a
+   * section throws, they outlive the tasks still running when tasks waits
+   * for them on destruction.
+   */
+  std::shared_ptr<MultiControlPlane> newControlPlane;
+  bool bufferPoolConfigChanged = false;
+  std::shared_ptr<MultiSwitchBufferPoolCfgMap> newBufferPoolCfg;
+  bool portFlowletConfigChanged = false;
+  std::shared_ptr<MultiSwitchPortFlowletCfgMap> newPortFlowletCfg;
+  std::shared_ptr<QosPolicyMap> newQosPolicies;
+  std::shared_ptr<SflowCollectorMap> newCollectors;
+  std::shared_ptr<AclTableGroupMap> newAclTableGroups;
+  std::shared_ptr<AclMap> newAcls;
+  ConfigSectionTasks tasks(configApplyExecutor());
+
+  auto controlPlaneTask = tasks.add([&] {
+    if (!isSectionUnchanged(ConfigSection::CONTROL_PLANE)) {
+      newControlPlane = updateControlPlane();
     }
-  }
+  });
 
-  processVlanPorts();
+  auto bufferPoolTask = tasks.add([&] {
+    if (!isSectionUnchanged(ConfigSection::BUFFER_POOLS)) {
+      newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
+    }
+  });
 
-  {
-    bool bufferPoolConfigChanged = false;
-    auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
-    if (bufferPoolConfigChanged) {
-      new_->resetBufferPoolCfgs(newBufferPoolCfg);
-      changed = true;
+  auto portFlowletTask = tasks.add([&] {
+    if (!isSectionUnchanged(ConfigSection::PORT_FLOWLETS)) {
+      newPortFlowletCfg = updatePortFlowletConfigs(&portFlowletConfigChanged);
     }
-  }
+  });
 
-  {
-    bool portFlowletConfigChanged = false;
-    auto newPortFlowletCfg =
-        updatePortFlowletConfigs(&portFlowletConfigChanged);
-    if (portFlowletConfigChanged) {
-      new_->resetPortFlowletCfgs(newPortFlowletCfg);
-      changed = true;
+  auto qosPolicyTask = tasks.add([&] {
+    if (!isSectionUnchanged(ConfigSection::QOS_POLICIES)) {
+      newQosPolicies = updateQosPolicies();
     }
-  }
+  });
+
+  auto sflowCollectorTask = tasks.add([&] {
+    if (!isSectionUnchanged(ConfigSection::SFLOW_COLLECTORS)) {
+      newCollectors = updateSflowCollectors();
+    }
+  });
+
+  processVlanPorts();
 
   auto newMultiSwitchSettings = updateMultiSwitchSettings();
   if (newMultiSwitchSettings) {
@@ -570,6 +962,18 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processInterfaceForPort();
 
+  // updatePorts reads buffer pool and port flowlet configs from new_
+  tasks.join(bufferPoolTask);
+  if (bufferPoolConfigChanged) {
+    new_->resetBufferPoolCfgs(newBufferPoolCfg);
+    changed = true;
+  }
+  tasks.join(portFlowletTask);
+  if (portFlowletConfigChanged) {
+    new_->resetPortFlowletCfgs(newPortFlowletCfg);
+    changed = true;
+  }
+
   {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
@@ -604,31 +1008,23 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  newMirrors_ = new_->getMirrors();
+  auto aclTask = tasks.add([&] {
+    if (isSectionUnchanged(ConfigSection::ACLS)) {
+      return;
+    }
     if (FLAGS_enable_acl_table_group) {
-      auto newAclTableGroups = updateAclTableGroups();
-      if (newAclTableGroups) {
-        new_->resetAclTableGroups(toMultiSwitchMap<MultiSwitchAclTableGroupMap>(
-            newAclTableGroups, scopeResolver_));
-        changed = true;
-      }
+      newAclTableGroups = updateAclTableGroups();
     } else {
-      auto newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls());
-      if (newAcls) {
-        new_->resetAcls(toMultiSwitchMap<MultiSwitchAclMap>(
-            std::move(newAcls), scopeResolver_));
-        changed = true;
-      }
+      newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls());
     }
-  }
+  });
 
-  {
-    auto newQosPolicies = updateQosPolicies();
-    if (newQosPolicies) {
-      new_->resetQosPolicies(toMultiSwitchMap<MultiSwitchQosPolicyMap>(
-          newQosPolicies, scopeResolver_));
-      changed = true;
-    }
+  tasks.join(qosPolicyTask);
+  if (newQosPolicies) {
+    new_->resetQosPolicies(toMultiSwitchMap<MultiSwitchQosPolicyMap>(
+        newQosPolicies, scopeResolver_));
+    changed = true;
   }
 
   {
@@ -702,6 +1098,18 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     changed = true;
   }
 
+  tasks.join(aclTask);
+  if (newAclTableGroups) {
+    new_->resetAclTableGroups(toMultiSwitchMap<MultiSwitchAclTableGroupMap>(
+        newAclTableGroups, scopeResolver_));
+    changed = true;
+  }
+  if (newAcls) {
+    new_->resetAcls(toMultiSwitchMap<MultiSwitchAclMap>(
+        std::move(newAcls), scopeResolver_));
+    changed = true;
+  }
+
   auto newVlans = new_->getVlans();
   VlanID dfltVlan(*cfg_->defaultVlan());
   if (orig_->getDefaultVlan() != dfltVlan) {
@@ -736,13 +1144,17 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
-    auto newCollectors = updateSflowCollectors();
-    if (newCollectors) {
-      new_->resetSflowCollectors(toMultiSwitchMap<MultiSwitchSflowCollectorMap>(
-          newCollectors, scopeResolver_));
-      changed = true;
-    }
+  tasks.join(sflowCollectorTask);
+  if (newCollectors) {
+    new_->resetSflowCollectors(toMultiSwitchMap<MultiSwitchSflowCollectorMap>(
+        newCollectors, scopeResolver_));
+    changed = true;
+  }
+
+  tasks.join(controlPlaneTask);
+  if (newControlPlane) {
+    new_->resetControlPlane(std::move(newControlPlane));
+    changed = true;
   }
 
   {
@@ -3066,8 +3478,6 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAclsImpl(
   AclMap::NodeContainer newAcls;
   bool changed = false;
   int numExistingProcessed = 0;
-  int dataPriority = AclTable::kDataplaneAclMaxPriority;
-  int cpuPriority = 1;
 
   flat_map<std::string, const cfg::TrafficCounter*> counterByName;
   folly::gen::from(*cfg_->trafficCounters()) |
@@ -3096,10 +3506,57 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAclsImpl(
         folly::gen::appendTo(dataPolicyByName);
   }
 
+  // CPU and dataplane ACLs each get priorities in the order in which they
+  // are listed in the config
+  std::vector<int> priorities(configEntries.size());
+  {
+    std::vector<size_t> cpuAcls, dataAcls;
+    std::vector<std::optional<int>> cpuOrigPriorities, dataOrigPriorities;
+    for (size_t idx = 0; idx < configEntries.size(); ++idx) {
+      const auto& aclName = *configEntries[idx].name();
+      auto origAcl = getOrigAcl(aclStage, aclName, tableName);
+      std::optional<int> origPriority;
+      if (origAcl) {
+        origPriority = origAcl->getPriority();
+      }
+      if (cpuPolicyByName.find(aclName) != cpuPolicyByName.end()) {
+        cpuAcls.push_back(idx);
+        cpuOrigPriorities.push_back(origPriority);
+      } else {
+        dataAcls.push_back(idx);
+        dataOrigPriorities.push_back(origPriority);
+      }
+    }
+    auto cpuPriorities = allocateAclPriorities(
+        cpuOrigPriorities,
+        1,
+        AclTable::kDataplaneAclMaxPriority,
+        FLAGS_acl_priority_gap);
+    // Hardware maps sw priorities onto a bounded range of its own (e.g.
+    // SaiAclTableManager::swPriorityToSaiPriority), so gapped dataplane
+    // priorities are kept within a window as wide as the CPU ACL range. Past
+    // that, ACLs are spread with a smaller gap, and only too many ACLs to fit
+    // at all make the window grow, as with contiguous priorities.
+    auto dataPriorityRange = std::max<int>(
+        AclTable::kDataplaneAclMaxPriority, dataAcls.size());
+    auto dataPriorities = allocateAclPriorities(
+        dataOrigPriorities,
+        AclTable::kDataplaneAclMaxPriority,
+        AclTable::kDataplaneAclMaxPriority + dataPriorityRange,
+        FLAGS_acl_priority_gap);
+    for (size_t idx = 0; idx < cpuAcls.size(); ++idx) {
+      priorities[cpuAcls[idx]] = cpuPriorities[idx];
+    }
+    for (size_t idx = 0; idx < dataAcls.size(); ++idx) {
+      priorities[dataAcls[idx]] = dataPriorities[idx];
+    }
+  }
+
   // Generates new acls from template
   auto addToAcls = [&]()
       -> const std::vector<std::pair<std::string, std::shared_ptr<AclEntry>>> {
     std::vector<std::pair<std::string, std::shared_ptr<AclEntry>>> entries;
+    size_t aclIdx = 0;
     for (const auto& aclCfg : configEntries) {
       bool enableAcl = true;
 
@@ -3186,7 +3643,7 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAclsImpl(
       auto acl = updateAcl(
           aclStage,
           aclCfg,
-          isCoppAcl ? cpuPriority++ : dataPriority++,
+          priorities[aclIdx++],
           &numExistingProcessed,
           &changed,
           tableName,
@@ -3198,10 +3655,10 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAclsImpl(
             aclAction->cref<switch_state_tags::ingressMirror>();
         const auto& egMirror =
             aclAction->cref<switch_state_tags::egressMirror>();
-        if (inMirror && !new_->getMirrors()->getNodeIf(inMirror->cref())) {
+        if (inMirror && !newMirrors_->getNodeIf(inMirror->cref())) {
           throw FbossError("Mirror ", inMirror->cref(), " is undefined");
         }
-        if (egMirror && !new_->getMirrors()->getNodeIf(egMirror->cref())) {
+        if (egMirror && !newMirrors_->getNodeIf(egMirror->cref())) {
           throw FbossError("Mirror ", egMirror->cref(), " is undefined");
         }
       }
@@ -3240,6 +3697,25 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAclsImpl(
   return std::make_shared<AclMap>(std::move(newAcls));
 }
 
+std::shared_ptr<AclEntry> ThriftConfigApplier::getOrigAcl(
+    cfg::AclStage aclStage,
+    const std::string& aclName,
+    const std::optional<std::string>& tableName) const {
+  if (FLAGS_enable_acl_table_group) { // multiple acl tables implementation
+    CHECK(tableName.has_value());
+
+    if (orig_->getAclsForTable(aclStage, tableName.value())) {
+      return orig_->getAclsForTable(aclStage, tableName.value())
+          ->getEntryIf(aclName);
+    }
+    return nullptr;
+  }
+  // single acl table implementation
+  CHECK(!tableName.has_value());
+  // orig_ empty in coldboot, or comes from follydynamic in warmboot
+  return orig_->getAcls()->getNodeIf(aclName);
+}
+
 std::shared_ptr<AclEntry> ThriftConfigApplier::updateAcl(
     cfg::AclStage aclStage,
     const cfg::AclEntry& acl,
@@ -3249,22 +3725,7 @@ std::shared_ptr<AclEntry> ThriftConfigApplier::updateAcl(
     std::optional<std::string> tableName,
     const MatchAction* action,
     bool enable) {
-  std::shared_ptr<AclEntry> origAcl;
-
-  if (FLAGS_enable_acl_table_group) { // multiple acl tables implementation
-    CHECK(tableName.has_value());
-
-    if (orig_->getAclsForTable(aclStage, tableName.value())) {
-      origAcl = orig_->getAclsForTable(aclStage, tableName.value())
-                    ->getEntryIf(*acl.name());
-    }
-  } else { // single acl table implementation
-    CHECK(!tableName.has_value());
-    origAcl = orig_->getAcls()->getNodeIf(
-        *acl.name()); // orig_ empty in coldboot, or comes from
-                      // follydynamic in warmboot
-  }
-
+  auto origAcl = getOrigAcl(aclStage, *acl.name(), tableName);
   auto newAcl =
       createAcl(&acl, priority, action, enable); // new always comes from config
 
@@ -5222,6 +5683,29 @@ void ThriftConfigApplier::addRemoteIntfRoute() {
   }
 }
 
+std::vector<ConfigFingerprint> configSectionFingerprints(
+    const cfg::SwitchConfig& config) {
+  std::vector<ConfigFingerprint> fingerprints;
+  fingerprints.reserve(kConfigSections.size());
+  for (auto section : kConfigSections) {
+    fingerprints.push_back(sectionFingerprint(section, config));
+  }
+  return fingerprints;
+}
+
+std::shared_ptr<SwitchState> configDerivedSections(
+    const std::shared_ptr<SwitchState>& state) {
+  auto sections = std::make_shared<SwitchState>();
+  sections->resetControlPlane(state->getControlPlane());
+  sections->resetBufferPoolCfgs(state->getBufferPoolCfgs());
+  sections->resetPortFlowletCfgs(state->getPortFlowletCfgs());
+  sections->resetAcls(state->getAcls());
+  sections->resetAclTableGroups(state->getAclTableGroups());
+  sections->resetQosPolicies(state->getQosPolicies());
+  sections->resetSflowCollectors(state->getSflowCollectors());
+  return sections;
+}
+
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
@@ -5229,7 +5713,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    const PrevAppliedConfig* prevAppliedConfig) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5237,7 +5722,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              rib,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             prevAppliedConfig)
       .run();
 }
 
@@ -5248,7 +5734,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    const PrevAppliedConfig* prevAppliedConfig) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5256,7 +5743,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              routeUpdater,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             prevAppliedConfig)
       .run();
 }
 
@@ -10,7 +10,10 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -27,6 +30,37 @@ class AclNexthopHandler;
 class PlatformMapping;
 class HwAsicTable;
 
+using ConfigFingerprint = std::pair<uint64_t, uint64_t>;
+
+/*
+ * Fingerprints of the config inputs and the config-derived SwitchState
+ * sections from the last successful config application. When passed back to
+ * applyThriftConfig, sections whose config inputs are unchanged and whose
+ * state was not modified since are carried over without being re-evaluated.
+ *
+ * Only sections derived purely from config are carried over. Ports, VLANs,
+ * interfaces and routes are always re-evaluated: they merge in runtime state
+ * and fill in the interface addresses and routes later sections read.
+ */
+struct PrevAppliedConfig {
+  // From configSectionFingerprints() of the applied config
+  std::vector<ConfigFingerprint> fingerprints;
+  // Only the sections derived purely from config are populated
+  std::shared_ptr<SwitchState> state;
+};
+
+/*
+ * Fingerprint the config inputs of each section which can be carried over.
+ */
+std::vector<ConfigFingerprint> configSectionFingerprints(
+    const cfg::SwitchConfig& config);
+
+/*
+ * Extract the config-derived sections of state for use in PrevAppliedConfig.
+ */
+std::shared_ptr<SwitchState> configDerivedSections(
+    const std::shared_ptr<SwitchState>& state);
+
 /*
  * Apply a thrift config structure to a SwitchState object.
  *
@@ -41,7 +75,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const PrevAppliedConfig* prevAppliedConfig = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
@@ -50,6 +85,7 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const PrevAppliedConfig* prevAppliedConfig = nullptr);
 
 } // namespace facebook::fboss
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/BinaryTraceLogger.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/SysError.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+namespace {
+std::atomic_uint64_t nextLoggerId{1};
+} // namespace
+
+namespace facebook::fboss {
+
+/*
+ * Byte ring with exactly one producer (the owning thread) and one consumer
+ * (whoever holds flushLock_). head_ and tail_ only ever grow, so the amount
+ * of data in the ring is always tail_ - head_.
+ */
+class BinaryTraceLogger::Ring {
+ public:
+  explicit Ring(uint32_t size) : buffer_(size) {}
+
+  bool tryPush(
+      const void* header,
+      size_t headerSize,
+      const void* payload,
+      size_t payloadSize) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    auto head = head_.load(std::memory_order_acquire);
+    if (buffer_.size() - (tail - head) < headerSize + payloadSize) {
+      return false;
+    }
+    copyIn(tail, header, headerSize);
+    copyIn(tail + headerSize, payload, payloadSize);
+    tail_.store(tail + headerSize + payloadSize, std::memory_order_release);
+    return true;
+  }
+
+  void drain(std::string& out) {
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_acquire);
+    auto pos = head % buffer_.size();
+    auto size = tail - head;
+    auto first = std::min<uint64_t>(size, buffer_.size() - pos);
+    out.append(buffer_.data() + pos, first);
+    out.append(buffer_.data(), size - first);
+    head_.store(tail, std::memory_order_release);
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+        tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  void copyIn(uint64_t offset, const void* data, size_t size) {
+    auto pos = offset % buffer_.size();
+    auto first = std::min<uint64_t>(size, buffer_.size() - pos);
+    std::memcpy(buffer_.data() + pos, data, first);
+    std::memcpy(
+        buffer_.data(), static_cast<const char*>(data) + first, size - first);
+  }
+
+  std::vector<char> buffer_;
+  alignas(64) std::atomic_uint64_t head_{0};
+  alignas(64) std::atomic_uint64_t tail_{0};
+};
+
+BinaryTraceLogger::BinaryTraceLogger(
+    const std::string& filePath,
+    uint32_t logTimeout,
+    uint32_t ringSize,
+    const std::string& context)
+    : id_(nextLoggerId++),
+      ringSize_(ringSize),
+      logTimeout_(std::chrono::milliseconds(logTimeout)) {
+  try {
+    logFile_ = folly::File(filePath, O_WRONLY | O_CREAT | O_TRUNC);
+  } catch (const std::system_error&) {
+    auto fileName = filePath.substr(filePath.find_last_of('/') + 1);
+    XLOG(WARN) << "[Binary Trace Logger] Failed to create " << filePath
+               << ". Logging binary trace at /tmp/" << fileName;
+    logFile_ = folly::File("/tmp/" + fileName, O_WRONLY | O_CREAT | O_TRUNC);
+  }
+
+  FileHeader header{kMagic, kVersion, static_cast<uint32_t>(context.size())};
+  if (folly::writeFull(logFile_.fd(), &header, sizeof(header)) < 0 ||
+      folly::writeFull(logFile_.fd(), context.data(), context.size()) < 0) {
+    throw SysError(errno, "error writing binary trace header");
+  }
+}
+
+BinaryTraceLogger::~BinaryTraceLogger() {
+  stopFlushThread();
+}
+
+void BinaryTraceLogger::startFlushThread() {
+  std::lock_guard<std::mutex> guard(latch_);
+  if (flushThread_) {
+    return;
+  }
+  stopFlush_ = false;
+  flushThread_ =
+      std::make_unique<std::thread>(&BinaryTraceLogger::flushThread, this);
+}
+
+void BinaryTraceLogger::stopFlushThread() {
+  {
+    std::lock_guard<std::mutex> guard(latch_);
+    if (!flushThread_) {
+      return;
+    }
+    stopFlush_ = true;
+  }
+  cv_.notify_one();
+  flushThread_->join();
+  flushThread_.reset();
+  // Pick up whatever was appended after the last periodic flush
+  flushRings();
+}
+
+void BinaryTraceLogger::forceFlush() {
+  flushRings();
+}
+
+bool BinaryTraceLogger::appendRecord(
+    uint8_t type,
+    const void* payload,
+    uint32_t size) {
+  RecordHeader header{};
+  header.sequence = sequence_++;
+  header.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  header.size = size;
+  header.type = type;
+
+  if (!threadRing()->tryPush(&header, sizeof(header), payload, size)) {
+    droppedCount_++;
+    return false;
+  }
+  return true;
+}
+
+BinaryTraceLogger::Ring* BinaryTraceLogger::threadRing() {
+  // Rings are cached per thread and keyed by logger id, so a thread only
+  // registers once per logger.
+  thread_local std::shared_ptr<Ring> ring;
+  thread_local uint64_t ringOwner{0};
+  if (ringOwner != id_) {
+    ring = std::make_shared<Ring>(ringSize_);
+    ringOwner = id_;
+    std::lock_guard<std::mutex> guard(ringsLock_);
+    rings_.push_back(ring);
+  }
+  return ring.get();
+}
+
+void BinaryTraceLogger::flushThread() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (!stopFlush_) {
+    cv_.wait_for(lock, logTimeout_, [this] { return stopFlush_; });
+    lock.unlock();
+    flushRings();
+    lock.lock();
+  }
+}
+
+void BinaryTraceLogger::flushRings() {
+  std::lock_guard<std::mutex> flushGuard(flushLock_);
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> guard(ringsLock_);
+    rings = rings_;
+  }
+
+  flushBuffer_.clear();
+  for (auto& ring : rings) {
+    ring->drain(flushBuffer_);
+  }
+  rings.clear();
+
+  if (!flushBuffer_.empty()) {
+    flushCount_++;
+    if (folly::writeFull(
+            logFile_.fd(), flushBuffer_.data(), flushBuffer_.size()) < 0) {
+      // Runs on the flush thread, where an exception would terminate the
+      // process. The records are lost, so log and count the failure instead.
+      writeErrorCount_++;
+      XLOG(ERR) << "error writing " << flushBuffer_.size()
+                << " bytes to binary trace: " << folly::errnoStr(errno);
+    }
+  }
+
+  // Forget rings of threads that have exited once they are drained
+  std::lock_guard<std::mutex> guard(ringsLock_);
+  rings_.erase(
+      std::remove_if(
+          rings_.begin(),
+          rings_.end(),
+          [](const auto& ring) {
+            return ring.use_count() == 1 && ring->empty();
+          }),
+      rings_.end());
+}
+
+std::vector<BinaryTraceLogger::Record> BinaryTraceLogger::readTrace(
+    const std::string& filePath,
+    std::string& context) {
+  std::string contents;
+  if (!folly::readFile(filePath.c_str(), contents)) {
+    throw SysError(errno, "error reading binary trace ", filePath);
+  }
+
+  FileHeader fileHeader;
+  if (contents.size() < sizeof(fileHeader)) {
+    throw FbossError("Binary trace ", filePath, " is missing its header");
+  }
+  std::memcpy(&fileHeader, contents.data(), sizeof(fileHeader));
+  if (fileHeader.magic != kMagic || fileHeader.version != kVersion) {
+    throw FbossError(
+        "Binary trace ",
+        filePath,
+        " has unsupported magic/version ",
+        fileHeader.magic,
+        "/",
+        fileHeader.version);
+  }
+  size_t offset = sizeof(fileHeader);
+  if (contents.size() - offset < fileHeader.contextSize) {
+    throw FbossError("Binary trace ", filePath, " has truncated context");
+  }
+  context = contents.substr(offset, fileHeader.contextSize);
+  offset += fileHeader.contextSize;
+
+  std::vector<Record> records;
+  while (contents.size() - offset >= sizeof(RecordHeader)) {
+    Record record;
+    std::memcpy(&record.header, contents.data() + offset, sizeof(RecordHeader));
+    offset += sizeof(RecordHeader);
+    if (contents.size() - offset < record.header.size) {
+      XLOG(WARN) << "Ignoring truncated record " << record.header.sequence
+                 << " at the end of " << filePath;
+      break;
+    }
+    record.payload = contents.substr(offset, record.header.size);
+    offset += record.header.size;
+    records.push_back(std::move(record));
+  }
+
+  // Rings are drained one after the other, so restore global call order
+  std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+    return a.header.sequence < b.header.sequence;
+  });
+  return records;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/File.h>
+
+namespace facebook::fboss {
+
+/*
+ * BinaryTraceLogger is the binary counterpart of AsyncLogger. Instead of
+ * formatted text appended under a single lock, callers append fixed-layout
+ * records and every producer thread gets its own single-producer ring.
+ * appendRecord() is therefore lock free and never blocks: if the calling
+ * thread's ring is full the record is dropped and counted instead.
+ *
+ * A background thread drains all rings into the trace file every logTimeout
+ * milliseconds. Each record carries a process wide sequence number, so
+ * readTrace() can restore the original call order across threads.
+ *
+ * The payload of a record is opaque to the logger; the record type and the
+ * context blob written in the file header let the producer (e.g. SaiTracer)
+ * decode its own records offline.
+ */
+class BinaryTraceLogger {
+ public:
+  static constexpr uint64_t kMagic = 0x4543415254535342; // "BSSTRACE"
+  static constexpr uint32_t kVersion = 1;
+
+  struct FileHeader {
+    uint64_t magic;
+    uint32_t version;
+    // Size of the producer defined context that follows the header
+    uint32_t contextSize;
+  };
+
+  struct RecordHeader {
+    uint64_t sequence;
+    int64_t timestampNs;
+    uint32_t size;
+    uint8_t type;
+    uint8_t reserved[3];
+  };
+
+  struct Record {
+    RecordHeader header;
+    std::string payload;
+  };
+
+  BinaryTraceLogger(
+      const std::string& filePath,
+      uint32_t logTimeout,
+      uint32_t ringSize,
+      const std::string& context);
+
+  ~BinaryTraceLogger();
+
+  void startFlushThread();
+  void stopFlushThread();
+  void forceFlush();
+
+  // Returns false if the record was dropped because the ring of the calling
+  // thread is full.
+  bool appendRecord(uint8_t type, const void* payload, uint32_t size);
+
+  uint64_t getDroppedCount() const {
+    return droppedCount_;
+  }
+
+  // Number of flushes whose records could not be written to the trace file
+  uint64_t getWriteErrorCount() const {
+    return writeErrorCount_;
+  }
+
+  // Expose these variables for testing purpose
+  uint32_t getFlushCount() const {
+    return flushCount_;
+  }
+
+  /*
+   * Read back a trace written by BinaryTraceLogger. Records are returned in
+   * sequence order. A truncated trailing record (e.g. from an unclean exit)
+   * is ignored.
+   */
+  static std::vector<Record> readTrace(
+      const std::string& filePath,
+      std::string& context);
+
+ private:
+  class Ring;
+
+  Ring* threadRing();
+  void flushThread();
+  void flushRings();
+
+  // Identifies this logger in the thread local ring cache
+  const uint64_t id_;
+  const uint32_t ringSize_;
+  const std::chrono::milliseconds logTimeout_;
+
+  folly::File logFile_;
+
+  std::atomic_uint64_t sequence_{0};
+  std::atomic_uint64_t droppedCount_{0};
+  std::atomic_uint64_t writeErrorCount_{0};
+  std::atomic_uint32_t flushCount_{0};
+
+  std::mutex ringsLock_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  // Rings are single consumer, so drains are serialized
+  std::mutex flushLock_;
+  std::string flushBuffer_;
+
+  std::mutex latch_;
+  std::condition_variable cv_;
+  bool stopFlush_{false};
+  std::unique_ptr<std::thread> flushThread_;
+};
+
+} // namespace facebook::fboss
@@ -19,6 +19,7 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibForRemoteConnectedRoutes(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const std::unordered_set<facebook::fboss::LabelID>* /*changedLabels*/,
     void* cookie) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
       resolver, vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
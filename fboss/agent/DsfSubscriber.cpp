@@ -72,6 +72,10 @@ DsfSubscriber::DsfSubscriber(SwSwitch* sw)
   // evb as was passed to that DSFSubscription object on
   // construction
   CHECK_EQ(hwUpdatePool_->numThreads(), 1);
+  // Updates from all peers are merged and applied on the same hw update
+  // thread the subscriptions are created with
+  updateAggregator_ = std::make_unique<DsfUpdateAggregator>(
+      sw_, hwUpdatePool_->getEventBase());
 }
 
 DsfSubscriber::~DsfSubscriber() {
@@ -155,7 +159,8 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
                   sw_->getState()->getDsfNodes(), nodeSwitchId),
               srcIPAddr,
               dstIPAddr,
-              sw_));
+              sw_,
+              updateAggregator_.get()));
     }
   };
   auto rmDsfNode = [&](const std::shared_ptr<DsfNode>& node) {
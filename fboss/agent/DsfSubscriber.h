@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/agent/DsfSubscription.h"
+#include "fboss/agent/DsfUpdateAggregator.h"
 #include "fboss/agent/StateObserver.h"
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 
@@ -60,6 +61,9 @@ class DsfSubscriber : public StateObserver {
   folly::Synchronized<
       folly::F14FastMap<std::string, std::unique_ptr<DsfSubscription>>>
       subscriptions_;
+  // Declared ahead of the pools so it outlives the hw update thread, which
+  // may still run a batch while the subscriber is torn down
+  std::unique_ptr<DsfUpdateAggregator> updateAggregator_;
   std::unique_ptr<folly::IOThreadPoolExecutor> streamConnectPool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> streamServePool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> hwUpdatePool_;
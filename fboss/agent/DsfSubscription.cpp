@@ -3,6 +3,7 @@
 #include "fboss/agent/DsfSubscription.h"
 #include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/DsfStateUpdaterUtil.h"
+#include "fboss/agent/DsfUpdateAggregator.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
@@ -70,7 +71,8 @@ DsfSubscription::DsfSubscription(
     std::set<SwitchID> remoteNodeSwitchIds,
     folly::IPAddress localIp,
     folly::IPAddress remoteIp,
-    SwSwitch* sw)
+    SwSwitch* sw,
+    DsfUpdateAggregator* updateAggregator)
     : opts_(std::move(options)),
       hwUpdateEvb_(hwUpdateEvb),
       fsdbPubSubMgr_(new fsdb::FsdbPubSubManager(
@@ -88,6 +90,7 @@ DsfSubscription::DsfSubscription(
       localIp_(std::move(localIp)),
       remoteIp_(std::move(remoteIp)),
       sw_(sw),
+      updateAggregator_(updateAggregator),
       session_(makeRemoteEndpoint(remoteNodeName_, remoteIp_)) {
   // Subscription is not established until state becomes CONNECTED
   sw->stats()->failedDsfSubscription(remoteNodeName_, 1);
@@ -114,6 +117,9 @@ void DsfSubscription::stop() {
   tearDownSubscription();
   // Nullify any pending update lambdas already scheduled on
   // hwUpdateEvb_
+  if (updateAggregator_) {
+    updateAggregator_->cancelUpdate(remoteEndpointStr());
+  }
   auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
   nextDsfUpdateWlock->reset();
   stopped_ = true;
@@ -300,6 +306,14 @@ void DsfSubscription::queueRemoteStateChanged(
 }
 
 void DsfSubscription::queueDsfUpdate(DsfUpdate&& dsfUpdate) {
+  if (updateAggregator_) {
+    updateAggregator_->queueUpdate(
+        remoteEndpointStr(),
+        std::move(dsfUpdate.switchId2SystemPorts),
+        std::move(dsfUpdate.switchId2Intfs),
+        [this]() { handleDsfUpdateFailure(); });
+    return;
+  }
   bool needsScheduling = false;
 
   {
@@ -343,22 +357,31 @@ void DsfSubscription::queueDsfUpdate(DsfUpdate&& dsfUpdate) {
             update.switchId2SystemPorts, update.switchId2Intfs);
 
       } catch (std::exception& e) {
-        XLOG(DBG2) << kDsfCtrlLogPrefix
-                   << " update failed for : " << remoteEndpointStr();
-        sw_->stats()->dsfUpdateFailed();
-        // Tear down subscription so no more updates come for this
-        // subscription
-        tearDownSubscription();
-        // Clear any queued updates
-        auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
-        nextDsfUpdateWlock->reset();
-        // Setup subscription again to trigger a full resync
-        setupSubscription();
+        handleDsfUpdateFailure();
       }
     });
   }
 }
 
+void DsfSubscription::handleDsfUpdateFailure() {
+  XLOG(DBG2) << kDsfCtrlLogPrefix
+             << " update failed for : " << remoteEndpointStr();
+  sw_->stats()->dsfUpdateFailed();
+  // Tear down subscription so no more updates come for this
+  // subscription
+  tearDownSubscription();
+  // Clear any queued updates
+  if (updateAggregator_) {
+    updateAggregator_->cancelUpdate(remoteEndpointStr());
+  }
+  {
+    auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
+    nextDsfUpdateWlock->reset();
+  }
+  // Setup subscription again to trigger a full resync
+  setupSubscription();
+}
+
 bool DsfSubscription::isLocal(SwitchID nodeSwitchId) const {
   auto localSwitchIds = sw_->getSwitchInfoTable().getSwitchIDs();
   return localSwitchIds.find(nodeSwitchId) != localSwitchIds.end();
@@ -18,6 +18,7 @@ class InterfaceMap;
 class SystemPortMap;
 class SwSwitch;
 class SwitchState;
+class DsfUpdateAggregator;
 
 class DsfSubscription {
  public:
@@ -31,7 +32,8 @@ class DsfSubscription {
       std::set<SwitchID> remoteNodeSwitchIds,
       folly::IPAddress localIp,
       folly::IPAddress remoteIp,
-      SwSwitch* sw);
+      SwSwitch* sw,
+      DsfUpdateAggregator* updateAggregator = nullptr);
 
   ~DsfSubscription();
 
@@ -80,6 +82,7 @@ class DsfSubscription {
       const MultiSwitchSystemPortMap& newPortMap,
       const MultiSwitchInterfaceMap& newInterfaceMap);
   void queueDsfUpdate(DsfUpdate&& dsfUpdate);
+  void handleDsfUpdateFailure();
   fsdb::FsdbStreamClient::State getStreamState() const;
 
   fsdb::SubscriptionOptions opts_;
@@ -92,6 +95,8 @@ class DsfSubscription {
   folly::IPAddress localIp_;
   folly::IPAddress remoteIp_;
   SwSwitch* sw_;
+  // When set, updates are applied together with those of other peers
+  DsfUpdateAggregator* updateAggregator_;
   DsfSession session_;
   folly::Synchronized<std::unique_ptr<DsfUpdate>> nextDsfUpdate_;
   // Cache current state of sysports and intfs received from remote
@@ -0,0 +1,181 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/DsfUpdateAggregator.h"
+#include "fboss/agent/AgentFeatures.h"
+#include "fboss/agent/DsfStateUpdaterUtil.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/SystemPortMap.h"
+
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace facebook::fboss {
+
+DsfUpdateAggregator::DsfUpdateAggregator(
+    SwSwitch* sw,
+    folly::EventBase* hwUpdateEvb)
+    : sw_(sw), hwUpdateEvb_(hwUpdateEvb) {}
+
+void DsfUpdateAggregator::queueUpdate(
+    const std::string& peer,
+    std::map<SwitchID, std::shared_ptr<SystemPortMap>> switchId2SystemPorts,
+    std::map<SwitchID, std::shared_ptr<InterfaceMap>> switchId2Intfs,
+    FailureHandler onFailure) {
+  bool needsScheduling = false;
+  {
+    auto pending = pending_.wlock();
+    if (pending->peerUpdates.empty()) {
+      pending->firstQueued = std::chrono::steady_clock::now();
+    }
+    auto& peerUpdate = pending->peerUpdates[peer];
+    peerUpdate.switchId2SystemPorts = std::move(switchId2SystemPorts);
+    peerUpdate.switchId2Intfs = std::move(switchId2Intfs);
+    peerUpdate.onFailure = std::move(onFailure);
+    peerUpdate.seqNum = pending->nextSeqNum++;
+    // A batch already scheduled will pick this update up as well
+    needsScheduling = !pending->batchScheduled;
+    pending->batchScheduled = true;
+  }
+  if (!needsScheduling) {
+    return;
+  }
+  hwUpdateEvb_->runInEventBaseThread([this]() {
+    if (FLAGS_dsf_update_batch_window_ms > 0) {
+      hwUpdateEvb_->runAfterDelay(
+          [this]() { processBatch(); }, FLAGS_dsf_update_batch_window_ms);
+    } else {
+      processBatch();
+    }
+  });
+}
+
+void DsfUpdateAggregator::cancelUpdate(const std::string& peer) {
+  pending_.wlock()->peerUpdates.erase(peer);
+}
+
+void DsfUpdateAggregator::processBatch() {
+  std::map<std::string, PeerUpdate> peerUpdates;
+  std::chrono::steady_clock::time_point firstQueued;
+  {
+    auto pending = pending_.wlock();
+    peerUpdates.swap(pending->peerUpdates);
+    firstQueued = pending->firstQueued;
+    pending->batchScheduled = false;
+  }
+
+  // Merge in the order the updates were queued, so that when several
+  // sessions report the same remote switch, the latest one wins.
+  std::vector<std::pair<const std::string*, const PeerUpdate*>> batch;
+  batch.reserve(peerUpdates.size());
+  for (const auto& [peer, update] : peerUpdates) {
+    if (hasLocalSwitchId(update)) {
+      XLOG(ERR) << "Got updates for a local switch ID from: " << peer;
+      handleFailure(peer, update);
+      continue;
+    }
+    batch.emplace_back(&peer, &update);
+  }
+  if (batch.empty()) {
+    // Nothing queued, or all updates were cancelled or rejected
+    return;
+  }
+  std::sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second->seqNum < rhs.second->seqNum;
+  });
+
+  std::map<SwitchID, std::shared_ptr<SystemPortMap>> switchId2SystemPorts;
+  std::map<SwitchID, std::shared_ptr<InterfaceMap>> switchId2Intfs;
+  for (const auto& [_, update] : batch) {
+    for (const auto& [switchId, sysPorts] : update->switchId2SystemPorts) {
+      switchId2SystemPorts[switchId] = sysPorts;
+    }
+    for (const auto& [switchId, intfs] : update->switchId2Intfs) {
+      switchId2Intfs[switchId] = intfs;
+    }
+  }
+
+  auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - firstQueued);
+  sw_->stats()->dsfUpdateBatch(batch.size(), latency);
+  XLOG(DBG2) << "Applying DSF updates of " << batch.size()
+             << " peers, first queued " << latency.count() << "ms ago";
+
+  auto batchName = batch.size() == 1
+      ? *batch.front().first
+      : folly::to<std::string>(batch.size(), " DSF peers");
+  try {
+    applyUpdate(batchName, switchId2SystemPorts, switchId2Intfs);
+    return;
+  } catch (const std::exception& ex) {
+    if (batch.size() == 1) {
+      handleFailure(*batch.front().first, *batch.front().second);
+      return;
+    }
+    XLOG(ERR) << "Batched update of " << batch.size()
+              << " DSF peers failed, applying them one at a time: "
+              << ex.what();
+  }
+  // The batch was rolled back, find out which peers can't be programmed
+  for (const auto& [peer, update] : batch) {
+    try {
+      applyUpdate(*peer, update->switchId2SystemPorts, update->switchId2Intfs);
+    } catch (const std::exception&) {
+      handleFailure(*peer, *update);
+    }
+  }
+}
+
+bool DsfUpdateAggregator::hasLocalSwitchId(const PeerUpdate& update) const {
+  auto localSwitchIds = sw_->getSwitchInfoTable().getSwitchIDs();
+  auto isLocal = [&localSwitchIds](const auto& switchId2Objects) {
+    for (const auto& [switchId, _] : switchId2Objects) {
+      if (localSwitchIds.find(switchId) != localSwitchIds.end()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  return isLocal(update.switchId2SystemPorts) ||
+      isLocal(update.switchId2Intfs);
+}
+
+void DsfUpdateAggregator::applyUpdate(
+    const std::string& name,
+    const std::map<SwitchID, std::shared_ptr<SystemPortMap>>&
+        switchId2SystemPorts,
+    const std::map<SwitchID, std::shared_ptr<InterfaceMap>>& switchId2Intfs) {
+  auto updateDsfStateFn = [this, switchId2SystemPorts, switchId2Intfs](
+                              const std::shared_ptr<SwitchState>& in) {
+    auto out = DsfStateUpdaterUtil::getUpdatedState(
+        in,
+        sw_->getScopeResolver(),
+        sw_->getRib(),
+        switchId2SystemPorts,
+        switchId2Intfs);
+    if (!FLAGS_dsf_subscriber_skip_hw_writes) {
+      return out;
+    }
+    return std::shared_ptr<SwitchState>{};
+  };
+
+  sw_->getRib()->updateStateInRibThread([this, &name, updateDsfStateFn]() {
+    sw_->updateStateWithHwFailureProtection(
+        folly::sformat("Update state for: {}", name), updateDsfStateFn);
+  });
+}
+
+void DsfUpdateAggregator::handleFailure(
+    const std::string& peer,
+    const PeerUpdate& update) {
+  XLOG(DBG2) << "DSF update failed for : " << peer;
+  if (update.onFailure) {
+    update.onFailure();
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,85 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include "fboss/agent/types.h"
+
+#include <folly/Synchronized.h>
+#include <folly/io/async/EventBase.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace facebook::fboss {
+class InterfaceMap;
+class SwSwitch;
+class SwitchState;
+class SystemPortMap;
+
+/*
+ * Merges the remote sysport and rif updates of all DSF peers into a single
+ * state update.
+ *
+ * A fabric event makes every peer publish at once, and applying each of them
+ * as its own state update serializes hundreds of state and hw transactions.
+ * Instead, peers queue their latest update here and one batch is applied on
+ * the hw update thread for everything that was queued, either within
+ * FLAGS_dsf_update_batch_window_ms or while the previous batch was running.
+ *
+ * The batch is applied with hw failure protection. If it fails, the updates
+ * of the batch are retried one peer at a time, so only the peers whose
+ * updates can't be programmed are rolled back and resynced.
+ */
+class DsfUpdateAggregator {
+ public:
+  using FailureHandler = std::function<void()>;
+
+  DsfUpdateAggregator(SwSwitch* sw, folly::EventBase* hwUpdateEvb);
+
+  /*
+   * Queue the latest sysports and rifs of a peer, replacing any update of
+   * the same peer still waiting for the next batch. onFailure is called on
+   * the hw update thread if this update could not be applied.
+   */
+  void queueUpdate(
+      const std::string& peer,
+      std::map<SwitchID, std::shared_ptr<SystemPortMap>> switchId2SystemPorts,
+      std::map<SwitchID, std::shared_ptr<InterfaceMap>> switchId2Intfs,
+      FailureHandler onFailure);
+
+  // Drop the update of a peer that has not been applied yet
+  void cancelUpdate(const std::string& peer);
+
+ private:
+  struct PeerUpdate {
+    std::map<SwitchID, std::shared_ptr<SystemPortMap>> switchId2SystemPorts;
+    std::map<SwitchID, std::shared_ptr<InterfaceMap>> switchId2Intfs;
+    FailureHandler onFailure;
+    // Order in which peers queued their updates
+    uint64_t seqNum{0};
+  };
+  struct PendingUpdates {
+    std::map<std::string, PeerUpdate> peerUpdates;
+    std::chrono::steady_clock::time_point firstQueued;
+    bool batchScheduled{false};
+    uint64_t nextSeqNum{0};
+  };
+
+  void processBatch();
+  bool hasLocalSwitchId(const PeerUpdate& update) const;
+  void applyUpdate(
+      const std::string& name,
+      const std::map<SwitchID, std::shared_ptr<SystemPortMap>>&
+          switchId2SystemPorts,
+      const std::map<SwitchID, std::shared_ptr<InterfaceMap>>& switchId2Intfs);
+  void handleFailure(const std::string& peer, const PeerUpdate& update);
+
+  SwSwitch* sw_;
+  folly::EventBase* hwUpdateEvb_;
+  folly::Synchronized<PendingUpdates> pending_;
+};
+
+} // namespace facebook::fboss
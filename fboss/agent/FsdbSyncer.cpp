@@ -2,6 +2,7 @@
 
 #include "fboss/agent/FsdbSyncer.h"
 #include "fboss/agent/AgentFsdbSyncManager.h"
+#include "fboss/agent/AgentStatsFsdbSyncManager.h"
 #ifndef IS_OSS
 #include "fboss/facebook/bitsflow/BitsflowHelper.h"
 #endif
@@ -57,7 +58,10 @@ FsdbSyncer::FsdbSyncer(SwSwitch* sw)
   agentFsdbSyncManager_ =
       std::make_unique<AgentFsdbSyncManager>(fsdbPubSubMgr_);
 
-  if (FLAGS_publish_stats_to_fsdb) {
+  if (FLAGS_publish_stats_to_fsdb && FLAGS_publish_agent_stats_delta_to_fsdb) {
+    agentStatsSyncManager_ = std::make_unique<AgentStatsFsdbSyncManager>(
+        fsdbPubSubMgr_, getAgentStatsPath());
+  } else if (FLAGS_publish_stats_to_fsdb) {
     fsdbPubSubMgr_->createStatPathPublisher(
         getAgentStatsPath(), [this](auto oldState, auto newState) {
           fsdbStatPublisherStateChanged(oldState, newState);
@@ -79,6 +83,9 @@ void FsdbSyncer::start() {
           bitsflow::BitsflowHelper::getCurrentBitsflowLockdownLevel()));
 #endif
   agentFsdbSyncManager_->start();
+  if (agentStatsSyncManager_) {
+    agentStatsSyncManager_->start();
+  }
 }
 
 FsdbSyncer::~FsdbSyncer() {
@@ -90,6 +97,10 @@ void FsdbSyncer::stop(bool gracefulStop) {
   // with any inflight updates happening in updateEvb
   agentFsdbSyncManager_->stop(gracefulStop);
   agentFsdbSyncManager_.reset();
+  if (agentStatsSyncManager_) {
+    agentStatsSyncManager_->stop(gracefulStop);
+    agentStatsSyncManager_.reset();
+  }
   readyForStatPublishing_.store(false);
   fsdbPubSubMgr_.reset();
 }
@@ -118,7 +129,13 @@ void FsdbSyncer::switchReachabilityChanged(
       switchId, std::move(newReachability));
 }
 
-void FsdbSyncer::statsUpdated(const AgentStats& stats) {
+void FsdbSyncer::statsUpdated(AgentStats stats) {
+  if (agentStatsSyncManager_) {
+    // Delta publisher tracks its own connection state and needs every
+    // update to keep its copy of the published stats current.
+    agentStatsSyncManager_->statsUpdated(std::move(stats));
+    return;
+  }
   if (!readyForStatPublishing_.load()) {
     return;
   }
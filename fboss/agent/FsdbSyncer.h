@@ -12,6 +12,7 @@
 namespace facebook::fboss {
 class SwSwitch;
 class AgentFsdbSyncManager;
+class AgentStatsFsdbSyncManager;
 class StateDelta;
 
 namespace fsdb {
@@ -26,7 +27,7 @@ class FsdbSyncer {
   explicit FsdbSyncer(SwSwitch* sw);
   ~FsdbSyncer();
   void stateUpdated(const StateDelta& stateDelta);
-  void statsUpdated(const AgentStats& stats);
+  void statsUpdated(AgentStats stats);
 
   // TODO - change to AgentConfig once SwSwitch can pass us that
   void cfgUpdated(
@@ -74,6 +75,8 @@ class FsdbSyncer {
   std::atomic<bool> readyForStatePublishing_{false};
   std::atomic<bool> readyForStatPublishing_{false};
   std::unique_ptr<AgentFsdbSyncManager> agentFsdbSyncManager_;
+  // only set when publishing stats as deltas
+  std::unique_ptr<AgentStatsFsdbSyncManager> agentStatsSyncManager_;
 };
 
 } // namespace facebook::fboss
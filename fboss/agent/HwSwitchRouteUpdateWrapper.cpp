@@ -17,9 +17,15 @@ std::shared_ptr<SwitchState> hwSwitchFibUpdate(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const std::unordered_set<facebook::fboss::LabelID>* changedLabels,
     const std::shared_ptr<SwitchState> oldState) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
-      resolver, vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      resolver,
+      vrf,
+      v4NetworkToRoute,
+      v6NetworkToRoute,
+      labelToRoute,
+      changedLabels);
   return fibUpdater(oldState);
 }
 
@@ -36,6 +42,8 @@ HwSwitchRouteUpdateWrapper::HwSwitchRouteUpdateWrapper(
               const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
               const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
               const facebook::fboss::LabelToRouteMap& labelToRoute,
+              const std::unordered_set<facebook::fboss::LabelID>*
+                  changedLabels,
               void* cookie) {
             auto hwSwitch = static_cast<HwSwitch*>(cookie);
             auto oldState = hwSwitch->getProgrammedState();
@@ -45,6 +53,7 @@ HwSwitchRouteUpdateWrapper::HwSwitchRouteUpdateWrapper(
                 v4NetworkToRoute,
                 v6NetworkToRoute,
                 labelToRoute,
+                changedLabels,
                 oldState);
             if (apply) {
               apply(StateDelta(oldState, newState));
@@ -74,32 +74,37 @@ void LookupClassRouteUpdater::removeNextHopsForSubnet(
     const std::shared_ptr<Vlan>& vlan) {
   auto& [ipAddress, mask] = subnet;
 
-  auto it = nextHopAndVlan2Prefixes_.begin();
-  while (it != nextHopAndVlan2Prefixes_.end()) {
-    const auto& [nextHop, vlanID] = it->first;
-
-    // Element pointed by the iterator would be deleted from
-    // nextHopAndVlan2Prefixes_ as part of processNeighborRemoved processing.
-    // Thus, advance the iterator to next element.
-    ++it;
-
-    if (vlanID == vlan->getID() && nextHop.inSubnet(ipAddress, mask)) {
-      if (nextHop.isV6()) {
-        auto ndpEntry =
-            getNeighborTableForVlan<NdpTable>(
-                stateDelta.newState(), vlan->getID(), FLAGS_intf_nbr_tables)
-                ->getEntryIf(nextHop.asV6());
-        if (ndpEntry) {
-          processNeighborRemoved(stateDelta, vlan->getID(), ndpEntry);
-        }
-      } else if (nextHop.isV4()) {
-        auto arpEntry =
-            getNeighborTableForVlan<ArpTable>(
-                stateDelta.newState(), vlan->getID(), FLAGS_intf_nbr_tables)
-                ->getEntryIf(nextHop.asV4());
-        if (arpEntry) {
-          processNeighborRemoved(stateDelta, vlan->getID(), arpEntry);
-        }
+  auto vlanIter = vlan2NextHops_.find(vlan->getID());
+  if (vlanIter == vlan2NextHops_.end()) {
+    return;
+  }
+
+  // Entries would be deleted from nextHopAndVlan2Prefixes_ (and thus
+  // vlan2NextHops_) as part of processNeighborRemoved processing. Thus,
+  // collect the nexthops of this subnet before processing them.
+  std::vector<folly::IPAddress> nextHopsInSubnet;
+  for (const auto& nextHop : vlanIter->second) {
+    if (nextHop.inSubnet(ipAddress, mask)) {
+      nextHopsInSubnet.push_back(nextHop);
+    }
+  }
+
+  for (const auto& nextHop : nextHopsInSubnet) {
+    if (nextHop.isV6()) {
+      auto ndpEntry =
+          getNeighborTableForVlan<NdpTable>(
+              stateDelta.newState(), vlan->getID(), FLAGS_intf_nbr_tables)
+              ->getEntryIf(nextHop.asV6());
+      if (ndpEntry) {
+        processNeighborRemoved(stateDelta, vlan->getID(), ndpEntry);
+      }
+    } else if (nextHop.isV4()) {
+      auto arpEntry =
+          getNeighborTableForVlan<ArpTable>(
+              stateDelta.newState(), vlan->getID(), FLAGS_intf_nbr_tables)
+              ->getEntryIf(nextHop.asV4());
+      if (arpEntry) {
+        processNeighborRemoved(stateDelta, vlan->getID(), arpEntry);
       }
     }
   }
@@ -174,17 +179,73 @@ LookupClassRouteUpdater::getClassIDForNeighbor(
 bool LookupClassRouteUpdater::belongsToSubnetInCache(
     VlanID vlanID,
     const folly::IPAddress& ipToSearch) {
-  auto it = vlan2SubnetsCache_.find(vlanID);
-  if (it != vlan2SubnetsCache_.end()) {
-    auto subnetsCache = it->second;
-    for (const auto& [ipAddress, mask] : subnetsCache) {
-      if (ipToSearch.inSubnet(ipAddress, mask)) {
-        return true;
-      }
-    }
+  auto it = vlan2SubnetsIndex_.find(vlanID);
+  if (it == vlan2SubnetsIndex_.end()) {
+    return false;
   }
 
-  return false;
+  const auto& subnetsIndex = it->second;
+  return subnetsIndex.longestMatch(ipToSearch, ipToSearch.bitCount()) !=
+      subnetsIndex.end();
+}
+
+bool LookupClassRouteUpdater::addSubnetToCache(
+    VlanID vlanID,
+    const folly::CIDRNetwork& subnet) {
+  if (!vlan2SubnetsCache_[vlanID].insert(subnet).second) {
+    return false;
+  }
+
+  auto& subnetsIndex = vlan2SubnetsIndex_[vlanID];
+  auto [it, inserted] = subnetsIndex.insert(subnet.first, subnet.second, 1);
+  if (!inserted) {
+    it.value()++;
+  }
+  return true;
+}
+
+void LookupClassRouteUpdater::removeSubnetFromCache(
+    VlanID vlanID,
+    const folly::CIDRNetwork& subnet) {
+  if (vlan2SubnetsCache_[vlanID].erase(subnet) == 0) {
+    return;
+  }
+
+  auto indexIter = vlan2SubnetsIndex_.find(vlanID);
+  CHECK(indexIter != vlan2SubnetsIndex_.end());
+  auto& subnetsIndex = indexIter->second;
+  auto it = subnetsIndex.exactMatch(subnet.first, subnet.second);
+  CHECK(it != subnetsIndex.end());
+  if (--it.value() == 0) {
+    subnetsIndex.erase(it);
+  }
+  if (subnetsIndex.size() == 0) {
+    vlan2SubnetsIndex_.erase(indexIter);
+  }
+}
+
+// Methods for dealing with nextHopAndVlan2Prefixes_
+
+LookupClassRouteUpdater::WithAndWithoutClassIDPrefixes&
+LookupClassRouteUpdater::getOrCreateNextHopEntry(
+    const folly::IPAddress& nextHop,
+    VlanID vlanID) {
+  vlan2NextHops_[vlanID].insert(nextHop);
+  return nextHopAndVlan2Prefixes_[std::make_pair(nextHop, vlanID)];
+}
+
+void LookupClassRouteUpdater::eraseNextHopEntry(
+    NextHopAndVlan nextHopAndVlan) {
+  const auto& [nextHop, vlanID] = nextHopAndVlan;
+  nextHopAndVlan2Prefixes_.erase(nextHopAndVlan);
+
+  auto it = vlan2NextHops_.find(vlanID);
+  if (it != vlan2NextHops_.end()) {
+    it->second.erase(nextHop);
+    if (it->second.empty()) {
+      vlan2NextHops_.erase(it);
+    }
+  }
 }
 
 void LookupClassRouteUpdater::updateSubnetsCache(
@@ -201,14 +262,15 @@ void LookupClassRouteUpdater::updateSubnetsCache(
       continue;
     }
 
-    auto& subnetsCache = vlan2SubnetsCache_[vlanID];
+    // Track the vlan even if it has no interface yet
+    std::ignore = vlan2SubnetsCache_[vlanID];
     auto interface =
         newState->getInterfaces()->getNodeIf(vlan->getInterfaceID());
     if (interface) {
       for (auto iter : std::as_const(*interface->getAddresses())) {
         auto address =
             std::make_pair(folly::IPAddress(iter.first), iter.second->cref());
-        subnetCacheUpdated = subnetsCache.insert(address).second;
+        subnetCacheUpdated = addSubnetToCache(vlanID, address);
       }
     }
   }
@@ -264,12 +326,11 @@ void LookupClassRouteUpdater::processPortRemovedForVlan(
     return;
   }
 
-  auto& subnetsCache = vlan2SubnetsCache_[vlanID];
   for (auto iter : std::as_const(*interface->getAddresses())) {
     std::pair<folly::IPAddress, uint8_t> address(
         folly::IPAddress(iter.first), iter.second->ref());
     removeNextHopsForSubnet(stateDelta, address, vlan);
-    subnetsCache.erase(address);
+    removeSubnetFromCache(vlanID, address);
   }
 }
 
@@ -387,8 +448,7 @@ void LookupClassRouteUpdater::processInterfaceAdded(
         std::pair<folly::IPAddress, uint8_t> address(
             folly::IPAddress(iter.first), iter.second->ref());
         if (blockedNeighborIP.inSubnet(address.first, address.second)) {
-          auto& subnetsCache = vlan2SubnetsCache_[vlanID];
-          subnetsCache.insert(address);
+          addSubnetToCache(vlanID, address);
         }
       }
     }
@@ -437,8 +497,7 @@ void LookupClassRouteUpdater::processInterfaceAdded(
             folly::IPAddress(iter.first), iter.second->ref());
         for (auto& neighborIP : neighborIPAddr) {
           if (neighborIP.inSubnet(address.first, address.second)) {
-            auto& subnetsCache = vlan2SubnetsCache_[vlanID];
-            subnetsCache.insert(address);
+            addSubnetToCache(vlanID, address);
             break;
           }
         }
@@ -582,7 +641,7 @@ void LookupClassRouteUpdater::processNeighborAdded(
   // If the neighbor is nextHop for a route that is already processed, the
   // neighbor would be present in the cache.
   auto& [withClassIDPrefixes, withoutClassIDPrefixes] =
-      nextHopAndVlan2Prefixes_[std::make_pair(addedNeighborIP, vlanID)];
+      getOrCreateNextHopEntry(addedNeighborIP, vlanID);
 
   if (!neighborClassID.has_value()) {
     return;
@@ -600,12 +659,11 @@ void LookupClassRouteUpdater::processNeighborAdded(
    * classID associated with it, then assign *this* nexthop's classID.
    */
   std::vector<RidAndCidr> toBeUpdatedPrefixes;
-  std::set_difference(
-      withoutClassIDPrefixes.begin(),
-      withoutClassIDPrefixes.end(),
-      allPrefixesWithClassID_.begin(),
-      allPrefixesWithClassID_.end(),
-      std::inserter(toBeUpdatedPrefixes, toBeUpdatedPrefixes.end()));
+  for (const auto& ridAndCidr : withoutClassIDPrefixes) {
+    if (!allPrefixesWithClassID_.contains(ridAndCidr)) {
+      toBeUpdatedPrefixes.push_back(ridAndCidr);
+    }
+  }
 
   auto routeClassID = neighborClassID.value();
 
@@ -655,7 +713,7 @@ void LookupClassRouteUpdater::processNeighborRemoved(
 
   if (withClassIDPrefixes.empty() && withoutClassIDPrefixes.empty()) {
     // neighbor being removed is not a nexthop for any route
-    nextHopAndVlan2Prefixes_.erase(it);
+    eraseNextHopEntry(it->first);
     return;
   }
 
@@ -880,7 +938,7 @@ LookupClassRouteUpdater::addRouteAndFindClassID(
      * retrieve previously cached entry, and if absent, create new entry.
      */
     auto& [withClassIDPrefixes, withoutClassIDPrefixes] =
-        nextHopAndVlan2Prefixes_[std::make_pair(nextHop.addr(), vlanID)];
+        getOrCreateNextHopEntry(nextHop.addr(), vlanID);
 
     /*
      * In the current implementation, route inherits classID of the 'first'
@@ -1098,14 +1156,14 @@ void LookupClassRouteUpdater::processRouteRemoved(
                               newState, vlanID, FLAGS_intf_nbr_tables)
                               ->getEntryIf(nextHop.addr().asV6());
           if (!ndpEntry) {
-            nextHopAndVlan2Prefixes_.erase(it);
+            eraseNextHopEntry(it->first);
           }
         } else if (nextHop.addr().isV4()) {
           auto arpEntry = getNeighborTableForVlan<ArpTable>(
                               newState, vlanID, FLAGS_intf_nbr_tables)
                               ->getEntryIf(nextHop.addr().asV4());
           if (!arpEntry) {
-            nextHopAndVlan2Prefixes_.erase(it);
+            eraseNextHopEntry(it->first);
           }
         }
       }
@@ -1306,8 +1364,7 @@ void LookupClassRouteUpdater::processBlockNeighborAdded(
     auto address =
         getInterfaceSubnetForIPIf(newState, vlanID, blockedNeighborIP);
     if (address.has_value()) {
-      auto& subnetsCache = vlan2SubnetsCache_[vlanID];
-      subnetCacheUpdated |= subnetsCache.insert(address.value()).second;
+      subnetCacheUpdated |= addSubnetToCache(vlanID, address.value());
     }
   }
 
@@ -1345,9 +1402,8 @@ void LookupClassRouteUpdater::processBlockNeighborRemoved(
         continue;
       }
 
-      auto& subnetsCache = vlan2SubnetsCache_[vlanID];
       removeNextHopsForSubnet(stateDelta, address.value(), vlan);
-      subnetsCache.erase(address.value());
+      removeSubnetFromCache(vlanID, address.value());
     }
   }
 }
@@ -1414,8 +1470,7 @@ bool LookupClassRouteUpdater::addBlockedNeighborIPtoSubnetCache(
     auto address =
         getInterfaceSubnetForIPIf(newState, vlanID, neighborIPToBlock);
     if (address.has_value()) {
-      auto& subnetsCache = vlan2SubnetsCache_[vlanID];
-      subnetCacheUpdated |= subnetsCache.insert(address.value()).second;
+      subnetCacheUpdated |= addSubnetToCache(vlanID, address.value());
     }
   }
   return subnetCacheUpdated;
@@ -1446,9 +1501,8 @@ void LookupClassRouteUpdater::removeBlockedNeighborIPfromSubnetCache(
      */
     if (address.has_value() &&
         !isSubnetCachedByLookupClasses(newState, vlanID, address.value())) {
-      auto& subnetsCache = vlan2SubnetsCache_[vlanID];
       removeNextHopsForSubnet(stateDelta, address.value(), vlan);
-      subnetsCache.erase(address.value());
+      removeSubnetFromCache(vlanID, address.value());
     }
   }
 }
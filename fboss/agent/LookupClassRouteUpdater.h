@@ -12,6 +12,7 @@
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/StateDelta.h"
+#include "fboss/lib/RadixTree.h"
 
 #include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
@@ -57,6 +58,8 @@ class LookupClassRouteUpdater : public StateObserver {
   bool belongsToSubnetInCache(
       VlanID vlanID,
       const folly::IPAddress& ipToSearch);
+  bool addSubnetToCache(VlanID vlanID, const folly::CIDRNetwork& subnet);
+  void removeSubnetFromCache(VlanID vlanID, const folly::CIDRNetwork& subnet);
 
   void updateSubnetsCache(
       const StateDelta& stateDelta,
@@ -171,6 +174,12 @@ class LookupClassRouteUpdater : public StateObserver {
   using RouteAndClassID =
       std::pair<RidAndCidr, std::optional<cfg::AclLookupClass>>;
 
+  // Methods for dealing with nextHopAndVlan2Prefixes_
+  WithAndWithoutClassIDPrefixes& getOrCreateNextHopEntry(
+      const folly::IPAddress& nextHop,
+      VlanID vlanID);
+  void eraseNextHopEntry(NextHopAndVlan nextHopAndVlan);
+
   template <typename RouteT>
   bool addRouteToMultiNextHopMap(
       const std::shared_ptr<SwitchState>& newState,
@@ -254,13 +263,22 @@ class LookupClassRouteUpdater : public StateObserver {
    * Thus, we discover and maintain a list of subnets for ports that have
    * non-empty lookupClasses list.
    *
-   * Today, the list of subnets we need to cache is very small. Thus,
-   * std::set is good enough. In future, if we need to cache a large
-   * number of subnets, we could use a Radix tree.
+   * Every neighbor and route nexthop is checked against these subnets, so
+   * lookups go through vlan2SubnetsIndex_ instead of walking the list.
+   * Always modify the cache with addSubnetToCache/removeSubnetFromCache to
+   * keep both in sync.
    */
   boost::container::flat_map<VlanID, folly::F14FastSet<folly::CIDRNetwork>>
       vlan2SubnetsCache_;
 
+  /*
+   * Longest prefix match index over vlan2SubnetsCache_. Subnets are stored
+   * masked, so the value counts the cached entries (e.g. two interface
+   * addresses of the same subnet) that map to a node.
+   */
+  folly::F14FastMap<VlanID, network::RadixTree<folly::IPAddress, uint32_t>>
+      vlan2SubnetsIndex_;
+
   /*
    * Route inherits classID of one of its reachable next hops.
    *
@@ -323,20 +341,25 @@ class LookupClassRouteUpdater : public StateObserver {
    * In theory, same IP may exist in different Vlans, thus maintain IP + Vlan
    * to prefixes mapping.
    *
-   * Today, the list of subnets we need to cache is very small. Thus,
-   * std::set is good enough. In future, if we need to cache a large
-   * number of subnets, we could use Radix tree.
-   *
    * This maintains the list of prefixes that inherit classID from this
    * [nexthop, vlan] separately from the list of prefixes that don't.
+   * Always modify it with getOrCreateNextHopEntry/eraseNextHopEntry to keep
+   * vlan2NextHops_ in sync.
    */
   folly::F14FastMap<NextHopAndVlan, WithAndWithoutClassIDPrefixes>
       nextHopAndVlan2Prefixes_;
 
+  /*
+   * NextHops of nextHopAndVlan2Prefixes_ grouped by Vlan, so that removing a
+   * subnet only visits the nexthops of its own Vlan.
+   */
+  folly::F14FastMap<VlanID, folly::F14FastSet<folly::IPAddress>>
+      vlan2NextHops_;
+
   /*
    * Set of prefixes with classID (from any [nexthop + vlan]).
    */
-  std::set<RidAndCidr> allPrefixesWithClassID_;
+  folly::F14FastSet<RidAndCidr> allPrefixesWithClassID_;
 
   /*
    * Map of prefixes with multiple nexthops associated to class IDs.
@@ -12,7 +12,6 @@
 #include "fboss/agent/state/SwitchState.h"
 
 using boost::container::flat_set;
-using facebook::fboss::DeltaFunctions::isEmpty;
 using folly::IPAddress;
 using std::optional;
 
@@ -21,77 +20,66 @@ namespace facebook::fboss {
 MirrorManager::MirrorManager(SwSwitch* sw)
     : sw_(sw),
       v4Manager_(std::make_unique<MirrorManagerV4>(sw)),
-      v6Manager_(std::make_unique<MirrorManagerV6>(sw)) {
-  sw_->registerStateObserver(this, "MirrorManager");
-}
-MirrorManager::~MirrorManager() {
-  sw_->unregisterStateObserver(this);
-}
-void MirrorManager::stateUpdated(const StateDelta& delta) {
-  if (!hasMirrorChanges(delta)) {
-    return;
-  }
+      v6Manager_(std::make_unique<MirrorManagerV6>(sw)) {}
+MirrorManager::~MirrorManager() {}
 
-  auto updateMirrorsFn = [this](const std::shared_ptr<SwitchState>& state) {
-    return resolveMirrors(state);
+bool MirrorManager::processDelta(const StateDelta& delta) {
+  auto mirrorAddedOrChanged = [this](const std::shared_ptr<Mirror>& mirror) {
+    if (!mirror->getDestinationIp()) {
+      /* SPAN mirror does not require resolving */
+      dependencies_.removeDependent(mirror->getID());
+      pendingMirrors_.erase(mirror->getID());
+      return;
+    }
+    pendingMirrors_.insert(mirror->getID());
   };
-  sw_->updateState("Updating mirrors", updateMirrorsFn);
-}
+  DeltaFunctions::forEachChanged(
+      delta.getMirrorsDelta(),
+      [&](const auto& /*oldMirror*/, const auto& newMirror) {
+        mirrorAddedOrChanged(newMirror);
+      },
+      mirrorAddedOrChanged,
+      [this](const std::shared_ptr<Mirror>& mirror) {
+        dependencies_.removeDependent(mirror->getID());
+        pendingMirrors_.erase(mirror->getID());
+      });
 
-std::shared_ptr<SwitchState> MirrorManager::resolveMirrors(
-    const std::shared_ptr<SwitchState>& state) {
-  auto updatedState = state->clone();
-  auto mnpuMirrors = state->getMirrors()->modify(&updatedState);
-  bool mirrorsUpdated = false;
-
-  for (auto mniter = mnpuMirrors->cbegin(); mniter != mnpuMirrors->cend();
-       ++mniter) {
-    HwSwitchMatcher matcher(mniter->first);
-    auto& mirrors = std::as_const(mniter->second);
-    for (auto iter = mirrors->cbegin(); iter != mirrors->cend(); ++iter) {
-      auto mirror = iter->second;
-      if (!mirror->getDestinationIp()) {
-        /* SPAN mirror does not require resolving */
-        continue;
-      }
-      const auto destinationIp = mirror->getDestinationIp().value();
-      std::shared_ptr<Mirror> updatedMirror = destinationIp.isV4()
-          ? v4Manager_->updateMirror(mirror)
-          : v6Manager_->updateMirror(mirror);
-      if (updatedMirror) {
-        XLOG(DBG2) << "Mirror: " << updatedMirror->getID() << " updated.";
-        mirrors->updateNode(updatedMirror);
-        mirrorsUpdated = true;
-      }
-    }
-  }
-  if (!mirrorsUpdated) {
-    return std::shared_ptr<SwitchState>(nullptr);
-  }
-  return updatedState;
+  auto affected = dependencies_.getAffected(delta);
+  pendingMirrors_.insert(affected.begin(), affected.end());
+  return !pendingMirrors_.empty();
 }
 
-bool MirrorManager::hasMirrorChanges(const StateDelta& delta) {
-  if (!sw_->getState()->getMirrors()->numNodes()) {
-    return false;
-  }
-  if (!isEmpty(delta.getMirrorsDelta()) || !isEmpty(delta.getFibsDelta())) {
-    return true;
+std::shared_ptr<SwitchState> MirrorManager::resolvePendingMirrors(
+    const std::shared_ptr<SwitchState>& state) {
+  if (pendingMirrors_.empty()) {
+    return nullptr;
   }
+  std::shared_ptr<SwitchState> updatedState;
+  MultiSwitchMirrorMap* mnpuMirrors = nullptr;
 
-  for (const auto& entry : delta.getVlansDelta()) {
-    if (!isEmpty(entry.getArpDelta()) || !isEmpty(entry.getNdpDelta())) {
-      return true;
+  for (const auto& mirrorName : pendingMirrors_) {
+    auto mirror = state->getMirrors()->getNodeIf(mirrorName);
+    if (!mirror || !mirror->getDestinationIp()) {
+      continue;
     }
-  }
-
-  for (const auto& entry : delta.getIntfsDelta()) {
-    if (!isEmpty(entry.getArpDelta()) || !isEmpty(entry.getNdpDelta())) {
-      return true;
+    ResolutionDependencyIndex::Dependencies deps;
+    const auto destinationIp = mirror->getDestinationIp().value();
+    std::shared_ptr<Mirror> updatedMirror = destinationIp.isV4()
+        ? v4Manager_->updateMirror(state, mirror, &deps)
+        : v6Manager_->updateMirror(state, mirror, &deps);
+    dependencies_.setDependencies(mirrorName, std::move(deps));
+    if (updatedMirror) {
+      XLOG(DBG2) << "Mirror: " << updatedMirror->getID() << " updated.";
+      if (!mnpuMirrors) {
+        updatedState = state->clone();
+        mnpuMirrors = state->getMirrors()->modify(&updatedState);
+      }
+      auto matcher = mnpuMirrors->getNodeAndScope(mirrorName).second;
+      mnpuMirrors->updateNode(updatedMirror, matcher);
     }
   }
-
-  return false;
+  pendingMirrors_.clear();
+  return updatedState;
 }
 
 } // namespace facebook::fboss
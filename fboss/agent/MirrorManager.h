@@ -3,29 +3,42 @@
 #pragma once
 
 #include "fboss/agent/MirrorManagerImpl.h"
-#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/ResolutionDependencyIndex.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/StateDelta.h"
 
+#include <set>
+#include <string>
+
 namespace facebook::fboss {
 
-class MirrorManager : public StateObserver {
+/*
+ * Resolves the tunnel and egress port of ERSPAN and sFlow mirrors. Driven
+ * by NexthopDependentsUpdater, which folds the result into the same state
+ * update as redirect ACL resolution.
+ */
+class MirrorManager {
  public:
   explicit MirrorManager(SwSwitch* sw);
-  ~MirrorManager() override;
-
-  void stateUpdated(const StateDelta& delta) override;
+  ~MirrorManager();
+
+  /*
+   * Queue mirrors that were added or changed in delta, or whose route,
+   * neighbors or egress interfaces changed. Returns true if any are queued.
+   */
+  bool processDelta(const StateDelta& delta);
+  // Re-resolve queued mirrors. Returns null if none of them changed.
+  std::shared_ptr<SwitchState> resolvePendingMirrors(
+      const std::shared_ptr<SwitchState>& state);
 
  private:
   SwSwitch* sw_;
   std::unique_ptr<MirrorManagerV4> v4Manager_;
   std::unique_ptr<MirrorManagerV6> v6Manager_;
-
-  bool hasMirrorChanges(const StateDelta& delta);
-
-  std::shared_ptr<SwitchState> resolveMirrors(
-      const std::shared_ptr<SwitchState>& state);
+  // Routes, neighbors and interfaces each mirror was last resolved over
+  ResolutionDependencyIndex dependencies_;
+  std::set<std::string> pendingMirrors_;
 };
 
 } // namespace facebook::fboss
@@ -69,11 +69,23 @@ PortID MirrorManagerImpl<AddrT>::getEventorPortForSflowMirror(
 
 template <typename AddrT>
 std::shared_ptr<Mirror> MirrorManagerImpl<AddrT>::updateMirror(
-    const std::shared_ptr<Mirror>& mirror) {
+    const std::shared_ptr<SwitchState>& state,
+    const std::shared_ptr<Mirror>& mirror,
+    ResolutionDependencyIndex::Dependencies* deps) {
   const AddrT destinationIp =
       getIPAddress<AddrT>(mirror->getDestinationIp().value());
-  const auto state = sw_->getState();
   const auto nexthops = resolveMirrorNextHops(state, destinationIp);
+  if (deps) {
+    deps->routeLookups.emplace_back(destinationIp);
+    // Directly connected destinations resolve to their own neighbor entry
+    deps->neighbors.emplace_back(destinationIp);
+    for (const auto& nexthop : nexthops) {
+      if (nexthop.isResolved()) {
+        deps->neighbors.emplace_back(nexthop.addr());
+        deps->interfaces.push_back(nexthop.intf());
+      }
+    }
+  }
 
   auto newMirror = std::make_shared<Mirror>(
       mirror->getID(),
@@ -5,6 +5,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 
+#include "fboss/agent/ResolutionDependencyIndex.h"
 #include "fboss/agent/state/ArpEntry.h"
 #include "fboss/agent/state/Mirror.h"
 #include "fboss/agent/state/NdpEntry.h"
@@ -28,7 +29,15 @@ class MirrorManagerImpl {
   explicit MirrorManagerImpl(SwSwitch* sw) : sw_(sw) {}
   ~MirrorManagerImpl() {}
 
-  std::shared_ptr<Mirror> updateMirror(const std::shared_ptr<Mirror>& mirror);
+  /*
+   * Resolve mirror against state. Returns null if resolution is unchanged.
+   * If deps is given, the routes, neighbors and interfaces consulted are
+   * recorded there.
+   */
+  std::shared_ptr<Mirror> updateMirror(
+      const std::shared_ptr<SwitchState>& state,
+      const std::shared_ptr<Mirror>& mirror,
+      ResolutionDependencyIndex::Dependencies* deps = nullptr);
 
  private:
   NextHopSet resolveMirrorNextHops(
@@ -9,11 +9,13 @@
  */
 #pragma once
 
+#include <folly/ExceptionString.h>
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/logging/xlog.h>
+#include <exception>
 #include <list>
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/EncapIndexAllocator.h"
@@ -30,6 +32,7 @@
 #include "fboss/agent/types.h"
 
 DECLARE_bool(intf_nbr_tables);
+DECLARE_bool(coalesce_neighbor_updates);
 
 namespace facebook::fboss {
 
@@ -104,6 +107,11 @@ void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
           "Programming entry is not supported for switch type: ", switchType);
   }
 
+  if (FLAGS_coalesce_neighbor_updates) {
+    queueUpdate(
+        entry->getFields().ip, QueuedUpdateType::PROGRAM, std::move(updateFn));
+    return;
+  }
   sw_->updateState(
       folly::to<std::string>("add neighbor ", entry->getFields().ip),
       std::move(updateFn));
@@ -279,6 +287,12 @@ void NeighborCacheImpl<NTable>::programPendingEntry(
     bool force) {
   SwSwitch::StateUpdateFn updateFn;
 
+  if (FLAGS_coalesce_neighbor_updates &&
+      getQueuedUpdateType(entry->getFields().ip) == QueuedUpdateType::FLUSH) {
+    // The flushed entry may not be removed from the SwitchState yet
+    force = true;
+  }
+
   auto switchType = sw_->getSwitchInfoTable().l3SwitchType();
   switch (switchType) {
     case cfg::SwitchType::NPU:
@@ -299,11 +313,100 @@ void NeighborCacheImpl<NTable>::programPendingEntry(
           "Programming entry is not supported for switch type: ", switchType);
   }
 
+  if (FLAGS_coalesce_neighbor_updates) {
+    queueUpdate(
+        entry->getFields().ip,
+        QueuedUpdateType::PROGRAM_PENDING,
+        std::move(updateFn));
+    return;
+  }
   sw_->updateStateNoCoalescing(
       folly::to<std::string>("add pending entry ", entry->getFields().ip),
       std::move(updateFn));
 }
 
+template <typename NTable>
+void NeighborCacheImpl<NTable>::queueUpdate(
+    AddressType ip,
+    QueuedUpdateType type,
+    SwSwitch::StateUpdateFn fn) {
+  bool schedule{false};
+  {
+    auto queued = queuedUpdates_.wlock();
+    auto it = queued->updates.find(ip);
+    if (it != queued->updates.end() &&
+        it->second.type == QueuedUpdateType::FLUSH) {
+      // Flush first, rather than dropping the flush, so that it still
+      // reports to a blocking flushEntry() whether the entry was flushed.
+      // Until then, the entry may still be in the SwitchState.
+      fn = [flushFn = std::move(it->second.fn), fn = std::move(fn)](
+               const std::shared_ptr<SwitchState>& state) {
+        auto flushedState = flushFn(state);
+        auto newState = fn(flushedState ? flushedState : state);
+        return newState ? newState : flushedState;
+      };
+      type = QueuedUpdateType::FLUSH;
+    }
+    queued->updates.insert_or_assign(ip, QueuedUpdate{type, std::move(fn)});
+    schedule = !queued->scheduled;
+    queued->scheduled = true;
+  }
+  if (!schedule) {
+    // Will be applied by the state update already scheduled
+    return;
+  }
+  // Non coalescing, so that a burst of neighbor changes is programmed as one
+  // delta of its own, as pending entries used to be
+  sw_->updateStateNoCoalescing(
+      folly::to<std::string>("update neighbors of interface ", intfID_),
+      [this](const std::shared_ptr<SwitchState>& state) {
+        return applyQueuedUpdates(state);
+      });
+}
+
+template <typename NTable>
+std::optional<typename NeighborCacheImpl<NTable>::QueuedUpdateType>
+NeighborCacheImpl<NTable>::getQueuedUpdateType(AddressType ip) const {
+  auto queued = queuedUpdates_.rlock();
+  auto it = queued->updates.find(ip);
+  if (it == queued->updates.end()) {
+    return std::nullopt;
+  }
+  return it->second.type;
+}
+
+template <typename NTable>
+std::shared_ptr<SwitchState> NeighborCacheImpl<NTable>::applyQueuedUpdates(
+    const std::shared_ptr<SwitchState>& state) {
+  std::map<AddressType, QueuedUpdate> updates;
+  {
+    auto queued = queuedUpdates_.wlock();
+    updates.swap(queued->updates);
+    queued->scheduled = false;
+  }
+
+  std::shared_ptr<SwitchState> newState{state};
+  bool changed{false};
+  for (auto& [ip, update] : updates) {
+    // Update functions validate the vlan or interface before modifying the
+    // state, so a failed one leaves newState as is and the rest still apply
+    try {
+      auto updatedState = update.fn(newState);
+      if (updatedState) {
+        newState = std::move(updatedState);
+        changed = true;
+      }
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Failed to apply queued update of neighbor " << ip
+                << " on interface " << intfID_ << ": "
+                << folly::exceptionStr(ex);
+    }
+  }
+  XLOG(DBG3) << "Applied " << updates.size()
+             << " neighbor updates of interface " << intfID_;
+  return changed ? newState : nullptr;
+}
+
 template <typename NTable>
 SwSwitch::StateUpdateFn
 NeighborCacheImpl<NTable>::getUpdateFnToProgramPendingEntryForVlan(
@@ -721,7 +824,37 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
     return nullptr;
   };
 
-  if (flushed) {
+  if (FLAGS_coalesce_neighbor_updates) {
+    if (!flushed) {
+      queueUpdate(ip, QueuedUpdateType::FLUSH, std::move(updateFn));
+      return;
+    }
+    // The flush may be applied by the update already scheduled rather than
+    // by ours, so its error is carried back here instead of only being
+    // logged by applyQueuedUpdates()
+    std::exception_ptr flushError;
+    queueUpdate(
+        ip,
+        QueuedUpdateType::FLUSH,
+        [updateFn = std::move(updateFn),
+         &flushError](const std::shared_ptr<SwitchState>& state) {
+          try {
+            return updateFn(state);
+          } catch (...) {
+            flushError = std::current_exception();
+            throw;
+          }
+        });
+    // Apply the queued updates, including this flush, before returning
+    sw_->updateStateBlocking(
+        "flush neighbor entry",
+        [this](const std::shared_ptr<SwitchState>& state) {
+          return applyQueuedUpdates(state);
+        });
+    if (flushError) {
+      std::rethrow_exception(flushError);
+    }
+  } else if (flushed) {
     // need a blocking state update if the caller wants to know if an entry
     // was actually flushed
     sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
@@ -18,7 +18,9 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/Synchronized.h>
 #include <list>
+#include <map>
 #include <optional>
 #include <string>
 
@@ -147,10 +149,37 @@ class NeighborCacheImpl {
       bool force,
       cfg::SwitchType switchType);
 
+  enum class QueuedUpdateType {
+    PROGRAM,
+    PROGRAM_PENDING,
+    FLUSH,
+  };
+  struct QueuedUpdate {
+    // FLUSH if a flush is queued, possibly followed by a later update
+    QueuedUpdateType type;
+    SwSwitch::StateUpdateFn fn;
+  };
+  struct QueuedUpdates {
+    // Only the latest update of each neighbor is kept, after any flush
+    std::map<AddressType, QueuedUpdate> updates;
+    bool scheduled{false};
+  };
+
+  // With --coalesce_neighbor_updates, neighbor table changes are queued and
+  // applied together in a single state update
+  void queueUpdate(
+      AddressType ip,
+      QueuedUpdateType type,
+      SwSwitch::StateUpdateFn fn);
+  std::optional<QueuedUpdateType> getQueuedUpdateType(AddressType ip) const;
+  std::shared_ptr<SwitchState> applyQueuedUpdates(
+      const std::shared_ptr<SwitchState>& state);
+
   void processEntry(AddressType ip);
 
   // Pass in a non-null flushed if you care whether an entry
-  // was actually flushed from the switch state
+  // was actually flushed from the switch state. The flush is then blocking
+  // and throws if it fails.
   void flushEntry(AddressType ip, bool* flushed = nullptr);
 
   template <typename VlanOrIntfT>
@@ -182,6 +211,10 @@ class NeighborCacheImpl {
 
   // Map of all entries
   std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+
+  // Neighbor table changes yet to be applied to the SwitchState. These are
+  // drained on the update thread, so are synchronized apart from the cache.
+  folly::Synchronized<QueuedUpdates> queuedUpdates_;
 };
 
 } // namespace facebook::fboss
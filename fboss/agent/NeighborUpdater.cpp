@@ -43,6 +43,13 @@ DEFINE_bool(
     false,
     "Disable neighbor updater in agent");
 
+DEFINE_bool(
+    coalesce_neighbor_updates,
+    false,
+    "Queue neighbor table changes of each VLAN/interface and apply all of "
+    "those queued before the update thread gets to them in one state update, "
+    "rather than one state update per neighbor");
+
 DECLARE_bool(intf_nbr_tables);
 
 namespace facebook::fboss {
@@ -0,0 +1,43 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/NexthopDependentsUpdater.h"
+
+#include "fboss/agent/AclNexthopHandler.h"
+#include "fboss/agent/MirrorManager.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/SwitchState.h"
+
+namespace facebook::fboss {
+
+NexthopDependentsUpdater::NexthopDependentsUpdater(
+    SwSwitch* sw,
+    MirrorManager* mirrorManager,
+    AclNexthopHandler* aclNexthopHandler)
+    : sw_(sw),
+      mirrorManager_(mirrorManager),
+      aclNexthopHandler_(aclNexthopHandler) {
+  sw_->registerStateObserver(this, "NexthopDependentsUpdater");
+}
+
+NexthopDependentsUpdater::~NexthopDependentsUpdater() {
+  sw_->unregisterStateObserver(this);
+}
+
+void NexthopDependentsUpdater::stateUpdated(const StateDelta& delta) {
+  // Both handlers must see every delta to keep their indices current
+  bool mirrorsPending = mirrorManager_->processDelta(delta);
+  bool aclsPending = aclNexthopHandler_->processDelta(delta);
+  if (!mirrorsPending && !aclsPending) {
+    return;
+  }
+
+  auto updateFn = [this](const std::shared_ptr<SwitchState>& state) {
+    auto newState = mirrorManager_->resolvePendingMirrors(state);
+    auto aclState =
+        aclNexthopHandler_->resolvePendingAcls(newState ? newState : state);
+    return aclState ? aclState : newState;
+  };
+  sw_->updateState("Updating mirrors and ACLs", updateFn);
+}
+
+} // namespace facebook::fboss
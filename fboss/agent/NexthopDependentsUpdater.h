@@ -0,0 +1,35 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/state/StateDelta.h"
+
+namespace facebook::fboss {
+class AclNexthopHandler;
+class MirrorManager;
+class SwSwitch;
+
+/*
+ * Re-resolves mirrors and redirect ACLs whose routes, neighbors or
+ * interfaces changed. Both are resolved in a single state update, so a
+ * route or neighbor churn costs one extra update rather than one per
+ * handler.
+ */
+class NexthopDependentsUpdater : public StateObserver {
+ public:
+  NexthopDependentsUpdater(
+      SwSwitch* sw,
+      MirrorManager* mirrorManager,
+      AclNexthopHandler* aclNexthopHandler);
+  ~NexthopDependentsUpdater() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+ private:
+  SwSwitch* sw_;
+  MirrorManager* mirrorManager_;
+  AclNexthopHandler* aclNexthopHandler_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,169 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/ResolutionDependencyIndex.h"
+
+#include "fboss/agent/FibHelpers.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/Vlan.h"
+
+#include <type_traits>
+
+namespace facebook::fboss {
+
+namespace {
+template <typename Key, typename Map>
+void removeFrom(Map& map, const Key& key, const std::string& dependent) {
+  auto it = map.find(key);
+  if (it == map.end()) {
+    return;
+  }
+  it->second.erase(dependent);
+  if (it->second.empty()) {
+    map.erase(it);
+  }
+}
+
+template <typename Key, typename Map>
+void addFrom(
+    const Map& map,
+    const Key& key,
+    std::set<std::string>& affected) {
+  auto it = map.find(key);
+  if (it != map.end()) {
+    affected.insert(it->second.begin(), it->second.end());
+  }
+}
+} // namespace
+
+void ResolutionDependencyIndex::setDependencies(
+    const std::string& dependent,
+    Dependencies deps) {
+  removeDependent(dependent);
+  for (const auto& ip : deps.routeLookups) {
+    if (ip.isV4()) {
+      v4RouteLookups_[ip.asV4()].insert(dependent);
+    } else {
+      v6RouteLookups_[ip.asV6()].insert(dependent);
+    }
+  }
+  for (const auto& ip : deps.neighbors) {
+    neighbors_[ip].insert(dependent);
+  }
+  for (const auto& intf : deps.interfaces) {
+    interfaces_[intf].insert(dependent);
+  }
+  dependencies_.emplace(dependent, std::move(deps));
+}
+
+void ResolutionDependencyIndex::removeDependent(const std::string& dependent) {
+  auto it = dependencies_.find(dependent);
+  if (it == dependencies_.end()) {
+    return;
+  }
+  const auto& deps = it->second;
+  for (const auto& ip : deps.routeLookups) {
+    if (ip.isV4()) {
+      removeFrom(v4RouteLookups_, ip.asV4(), dependent);
+    } else {
+      removeFrom(v6RouteLookups_, ip.asV6(), dependent);
+    }
+  }
+  for (const auto& ip : deps.neighbors) {
+    removeFrom(neighbors_, ip, dependent);
+  }
+  for (const auto& intf : deps.interfaces) {
+    removeFrom(interfaces_, intf, dependent);
+  }
+  dependencies_.erase(it);
+}
+
+template <typename AddrT>
+void ResolutionDependencyIndex::addRouteDependents(
+    const std::map<AddrT, Dependents>& lookups,
+    const RoutePrefix<AddrT>& prefix,
+    std::set<std::string>& affected) const {
+  // Addresses are ordered, so those covered by prefix are contiguous
+  for (auto it = lookups.lower_bound(prefix.network());
+       it != lookups.end() &&
+       it->first.inSubnet(prefix.network(), prefix.mask());
+       ++it) {
+    affected.insert(it->second.begin(), it->second.end());
+  }
+}
+
+template <typename NeighborDeltaT>
+void ResolutionDependencyIndex::addNeighborDependents(
+    const NeighborDeltaT& neighborDelta,
+    std::set<std::string>& affected) const {
+  auto addEntry = [&](const auto& entry) {
+    addFrom(neighbors_, folly::IPAddress(entry->getIP()), affected);
+  };
+  DeltaFunctions::forEachChanged(
+      neighborDelta,
+      [&](const auto& /*oldEntry*/, const auto& newEntry) {
+        addEntry(newEntry);
+      },
+      addEntry,
+      addEntry);
+}
+
+std::set<std::string> ResolutionDependencyIndex::getAffected(
+    const StateDelta& delta) const {
+  std::set<std::string> affected;
+  if (dependencies_.empty()) {
+    return affected;
+  }
+
+  if (!v4RouteLookups_.empty() || !v6RouteLookups_.empty()) {
+    auto addRoute = [&](RouterID rid, const auto& route) {
+      if (rid != RouterID(0)) {
+        return;
+      }
+      auto prefix = route->prefix();
+      if constexpr (std::is_same_v<
+                        decltype(prefix),
+                        RoutePrefix<folly::IPAddressV4>>) {
+        addRouteDependents(v4RouteLookups_, prefix, affected);
+      } else {
+        addRouteDependents(v6RouteLookups_, prefix, affected);
+      }
+    };
+    forEachChangedRoute(
+        delta,
+        [&](RouterID rid, const auto& /*oldRoute*/, const auto& newRoute) {
+          addRoute(rid, newRoute);
+        },
+        addRoute,
+        addRoute);
+  }
+
+  if (!neighbors_.empty()) {
+    for (const auto& entry : delta.getVlansDelta()) {
+      addNeighborDependents(entry.getArpDelta(), affected);
+      addNeighborDependents(entry.getNdpDelta(), affected);
+    }
+    for (const auto& entry : delta.getIntfsDelta()) {
+      addNeighborDependents(entry.getArpDelta(), affected);
+      addNeighborDependents(entry.getNdpDelta(), affected);
+    }
+  }
+
+  if (!interfaces_.empty()) {
+    for (const auto& entry : delta.getIntfsDelta()) {
+      const auto& oldIntf = entry.getOld();
+      const auto& newIntf = entry.getNew();
+      // Neighbor table changes are handled above, only the interface's own
+      // addressing matters here
+      if (oldIntf && newIntf && oldIntf->getMac() == newIntf->getMac() &&
+          oldIntf->getAddressesCopy() == newIntf->getAddressesCopy()) {
+        continue;
+      }
+      auto intf = oldIntf ? oldIntf : newIntf;
+      addFrom(interfaces_, intf->getID(), affected);
+    }
+  }
+  return affected;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,71 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include "fboss/agent/state/RouteTypes.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Reverse index from the inputs of next hop resolution (routes, neighbors
+ * and interfaces) to the names of the objects (e.g. mirrors or redirect
+ * ACLs) whose resolution used them. Given a StateDelta this yields just the
+ * objects that need to be re-resolved, rather than all of them.
+ *
+ * Route dependencies are kept as the addresses that were looked up, since
+ * a route added or removed anywhere on the path to an address can change
+ * its longest match. Only routes in the default VRF are considered, as that
+ * is where resolution happens.
+ *
+ * Not thread safe, meant to be used from the state update thread.
+ */
+class ResolutionDependencyIndex {
+ public:
+  struct Dependencies {
+    std::vector<folly::IPAddress> routeLookups;
+    std::vector<folly::IPAddress> neighbors;
+    std::vector<InterfaceID> interfaces;
+  };
+
+  // Replaces any dependencies previously recorded for dependent
+  void setDependencies(const std::string& dependent, Dependencies deps);
+  void removeDependent(const std::string& dependent);
+
+  // Dependents whose resolution inputs changed in delta
+  std::set<std::string> getAffected(const StateDelta& delta) const;
+
+  size_t size() const {
+    return dependencies_.size();
+  }
+
+ private:
+  using Dependents = std::set<std::string>;
+
+  template <typename AddrT>
+  void addRouteDependents(
+      const std::map<AddrT, Dependents>& lookups,
+      const RoutePrefix<AddrT>& prefix,
+      std::set<std::string>& affected) const;
+  template <typename NeighborDeltaT>
+  void addNeighborDependents(
+      const NeighborDeltaT& neighborDelta,
+      std::set<std::string>& affected) const;
+
+  std::map<folly::IPAddressV4, Dependents> v4RouteLookups_;
+  std::map<folly::IPAddressV6, Dependents> v6RouteLookups_;
+  std::unordered_map<folly::IPAddress, Dependents> neighbors_;
+  std::unordered_map<InterfaceID, Dependents> interfaces_;
+  std::unordered_map<std::string, Dependencies> dependencies_;
+};
+
+} // namespace facebook::fboss
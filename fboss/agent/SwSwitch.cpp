@@ -51,6 +51,7 @@
 #include "fboss/agent/MultiSwitchFb303Stats.h"
 #include "fboss/agent/MultiSwitchPacketStreamMap.h"
 #include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/NexthopDependentsUpdater.h"
 #include "fboss/agent/PacketLogger.h"
 #include "fboss/agent/PacketObserver.h"
 #include "fboss/agent/PhySnapshotManager.h"
@@ -88,11 +89,13 @@
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/StateUpdateHelpers.h"
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/SwitchStateMemoryUsage.h"
 #include "fboss/lib/config/PlatformConfigUtils.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/lib/platforms/PlatformProductInfo.h"
 
 #include "fboss/lib/CommonFileUtils.h"
+#include "fboss/lib/StageTracer.h"
 
 #include <fb303/ServiceData.h>
 #include <folly/Demangle.h>
@@ -217,6 +220,11 @@ facebook::fboss::PortStatus fillInPortStatus(
 }
 
 auto constexpr kHwUpdateFailures = "hw_update_failures";
+auto constexpr kStateUpdateQueueWaitStage = "state_update.queue_wait";
+auto constexpr kStateUpdateCoalescedStage = "state_update.coalesced";
+auto constexpr kStateUpdateFnStage = "state_update.update_fns";
+auto constexpr kStateUpdateHwStage = "state_update.hw_apply";
+auto constexpr kStateUpdateObserverStage = "state_update.observers";
 
 std::string getDrainStateChangedStr(
     const std::shared_ptr<facebook::fboss::SwitchState>& oldState,
@@ -389,6 +397,10 @@ SwSwitch::SwSwitch(
       macTableManager_(new MacTableManager(this)),
       phySnapshotManager_(new PhySnapshotManager(kIphySnapshotIntervalSeconds)),
       aclNexthopHandler_(new AclNexthopHandler(this)),
+      nexthopDependentsUpdater_(new NexthopDependentsUpdater(
+          this,
+          mirrorManager_.get(),
+          aclNexthopHandler_.get())),
       teFlowNextHopHandler_(new TeFlowNexthopHandler(this)),
       dsfSubscriber_(new DsfSubscriber(this)),
       switchInfoTable_(getSwitchInfoFromConfig(config)),
@@ -820,6 +832,7 @@ void SwSwitch::updateStats() {
   updatePortInfo();
   updateLldpStats();
   updateTeFlowStats();
+  updateSwitchStateMemoryStats();
   updateMultiSwitchGlobalFb303Stats();
   stats()->maxNumOfPhysicalHostsPerQueue(
       getLookupClassUpdater()->getMaxNumHostsPerQueue());
@@ -890,6 +903,39 @@ void SwSwitch::updateTeFlowStats() {
       SwitchStats::kCounterPrefix + "teflows.inactive", inactiveFlows);
 }
 
+void SwSwitch::updateSwitchStateMemoryStats() {
+  if (FLAGS_switch_state_memory_stats_interval_s <= 0) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (switchStateMemoryStatsAt_ &&
+      std::chrono::duration_cast<std::chrono::seconds>(
+          now - *switchStateMemoryStatsAt_)
+              .count() < FLAGS_switch_state_memory_stats_interval_s) {
+    return;
+  }
+  auto state = getState();
+  if (!state) {
+    return;
+  }
+  switchStateMemoryStatsAt_ = now;
+
+  int64_t totalBytes = 0;
+  int64_t totalSharedBytes = 0;
+  for (const auto& [subtree, usage] : computeSwitchStateMemoryUsage(state)) {
+    auto prefix =
+        folly::to<std::string>(SwitchStats::kCounterPrefix, "state.", subtree);
+    fb303::fbData->setCounter(prefix + ".bytes", *usage.bytes());
+    fb303::fbData->setCounter(prefix + ".shared_bytes", *usage.sharedBytes());
+    totalBytes += *usage.bytes();
+    totalSharedBytes += *usage.sharedBytes();
+  }
+  fb303::fbData->setCounter(
+      SwitchStats::kCounterPrefix + "state.bytes", totalBytes);
+  fb303::fbData->setCounter(
+      SwitchStats::kCounterPrefix + "state.shared_bytes", totalSharedBytes);
+}
+
 void SwSwitch::updatePortInfo() {
   auto state = getState();
   if (!state) {
@@ -1429,6 +1475,7 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   }
   {
     std::unique_lock guard(pendingUpdatesLock_);
+    update->enqueueTime_ = std::chrono::steady_clock::now();
     pendingUpdates_.push_back(*update.release());
   }
 
@@ -1539,6 +1586,22 @@ void SwSwitch::handlePendingUpdates() {
   // a valid switch state
   DCHECK(getState());
 
+  auto tracer = StageTracer::getInstance();
+  if (tracer && !tracer->enabled()) {
+    tracer.reset();
+  }
+  auto dequeueTime = std::chrono::steady_clock::now();
+  if (tracer) {
+    tracer->recordValue(kStateUpdateCoalescedStage, updates.size());
+    for (const auto& update : updates) {
+      tracer->recordStage(
+          kStateUpdateQueueWaitStage,
+          update.enqueueTime_,
+          dequeueTime,
+          update.getName());
+    }
+  }
+
   // Call all of the update functions to prepare the new SwitchState
   auto oldAppliedState = getState();
   // We start with the old state, and apply state updates one at a time.
@@ -1571,6 +1634,10 @@ void SwSwitch::handlePendingUpdates() {
       newDesiredState = intermediateState;
     }
   }
+  if (tracer) {
+    tracer->recordStage(
+        kStateUpdateFnStage, dequeueTime, std::chrono::steady_clock::now());
+  }
   // Start newAppliedState as equal to newDesiredState unless
   // we learn otherwise
   auto newAppliedState = newDesiredState;
@@ -1695,6 +1762,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // undesirable.  So far I don't think this brief discrepancy should cause
   // major issues.
   try {
+    ScopedStageTimer hwTimer(kStateUpdateHwStage);
     newAppliedState = stateChanged(delta, isTransaction);
   } catch (const std::exception& ex) {
     // Notify the hw_ of the crash so it can execute any device specific
@@ -1716,7 +1784,10 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   setStateInternal(newAppliedState);
 
   // Notifies all observers of the current state update.
-  notifyStateObservers(StateDelta(oldState, newAppliedState));
+  {
+    ScopedStageTimer observerTimer(kStateUpdateObserverStage);
+    notifyStateObservers(StateDelta(oldState, newAppliedState));
+  }
 
   // Notifies resource accountant of new applied state.
   resourceAccountant_->stateChanged(StateDelta(newState, newAppliedState));
@@ -2756,6 +2827,8 @@ void SwSwitch::applyConfigImpl(
   // us.
   auto routeUpdater = getRouteUpdater();
   auto oldConfig = getConfig();
+  auto prevAppliedConfig = prevAppliedConfig_.copy();
+  std::shared_ptr<SwitchState> appliedSections;
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
@@ -2767,12 +2840,14 @@ void SwSwitch::applyConfigImpl(
             platformMapping_.get(),
             hwAsicTable_.get(),
             &routeUpdater,
-            aclNexthopHandler_.get());
+            aclNexthopHandler_.get(),
+            prevAppliedConfig.get());
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
         }
 
+        appliedSections = configDerivedSections(newState ? newState : state);
         if (!newState) {
           // if config is not updated, the new state will return null
           // in such a case return here, to prevent possible crash.
@@ -2781,6 +2856,12 @@ void SwSwitch::applyConfigImpl(
         }
         return newState;
       });
+  // If hardware programming altered any of these sections, the identity
+  // check on the next apply falls back to evaluating them in full.
+  *prevAppliedConfig_.wlock() =
+      std::make_shared<const PrevAppliedConfig>(PrevAppliedConfig{
+          configSectionFingerprints(newConfig),
+          std::move(appliedSections)});
   // Since we're using blocking state update, once we reach here, the new
   // config should be already applied and programmed into hardware.
   updateConfigAppliedInfo();
@@ -49,6 +49,7 @@
 namespace facebook::fboss {
 
 struct AgentConfig;
+struct PrevAppliedConfig;
 class ArpHandler;
 class InterfaceStats;
 class IPv4Handler;
@@ -74,6 +75,7 @@ class RouteUpdateLogger;
 class StateObserver;
 class TunManager;
 class MirrorManager;
+class NexthopDependentsUpdater;
 class PhySnapshotManager;
 class AclNexthopHandler;
 class LookupClassUpdater;
@@ -999,6 +1001,7 @@ class SwSwitch : public HwSwitchCallback {
   void updatePortInfo();
   void updateRouteStats();
   void updateTeFlowStats();
+  void updateSwitchStateMemoryStats();
   void updateFlowletStats();
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
@@ -1224,6 +1227,7 @@ class SwSwitch : public HwSwitchCallback {
 
   std::unique_ptr<PhySnapshotManager> phySnapshotManager_;
   std::unique_ptr<AclNexthopHandler> aclNexthopHandler_;
+  std::unique_ptr<NexthopDependentsUpdater> nexthopDependentsUpdater_;
   folly::Synchronized<std::unique_ptr<FsdbSyncer>> fsdbSyncer_;
   std::unique_ptr<TeFlowNexthopHandler> teFlowNextHopHandler_;
   std::unique_ptr<DsfSubscriber> dsfSubscriber_;
@@ -1235,8 +1239,13 @@ class SwSwitch : public HwSwitchCallback {
   std::unique_ptr<ResourceAccountant> resourceAccountant_;
 
   folly::Synchronized<ConfigAppliedInfo> configAppliedInfo_;
+  // Last applied config, used to skip re-evaluating unchanged sections
+  folly::Synchronized<std::shared_ptr<const PrevAppliedConfig>>
+      prevAppliedConfig_;
   std::optional<std::chrono::time_point<std::chrono::steady_clock>>
       publishedStatsToFsdbAt_;
+  std::optional<std::chrono::time_point<std::chrono::steady_clock>>
+      switchStateMemoryStatsAt_;
   std::unique_ptr<MultiSwitchPacketStreamMap> packetStreamMap_;
   std::unique_ptr<SwSwitchWarmBootHelper> swSwitchWarmbootHelper_;
   std::unique_ptr<HwSwitchThriftClientTable> hwSwitchThriftClientTable_;
@@ -28,9 +28,15 @@ std::shared_ptr<SwitchState> swSwitchFibUpdate(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const std::unordered_set<facebook::fboss::LabelID>* changedLabels,
     void* cookie) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
-      resolver, vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      resolver,
+      vrf,
+      v4NetworkToRoute,
+      v6NetworkToRoute,
+      labelToRoute,
+      changedLabels);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateWithHwFailureProtection("update fib", std::move(fibUpdater));
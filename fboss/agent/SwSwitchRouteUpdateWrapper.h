@@ -23,6 +23,7 @@ std::shared_ptr<SwitchState> swSwitchFibUpdate(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const std::unordered_set<facebook::fboss::LabelID>* changedLabels,
     void* cookie);
 
 class SwSwitchRouteUpdateWrapper : public RouteUpdateWrapper {
@@ -291,6 +291,18 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
           RATE),
       dsfGrExpired_(map, kCounterPrefix + "dsfsession_gr_expired", SUM, RATE),
       dsfUpdateFailed_(map, kCounterPrefix + "dsf_update_failed", SUM, RATE),
+      dsfUpdateBatchSize_(
+          map,
+          kCounterPrefix + "dsf_update_batch_size",
+          10,
+          0,
+          1000),
+      dsfUpdateBatchLatency_(
+          map,
+          kCounterPrefix + "dsf_update_batch_latency.ms",
+          100,
+          0,
+          20000),
       multiSwitchStatus_(map, kCounterPrefix + "multi_switch", SUM, RATE)
 
 {
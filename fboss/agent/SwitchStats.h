@@ -533,6 +533,10 @@ class SwitchStats : public boost::noncopyable {
   int64_t getDsfUpdateFailred() const {
     return getCumulativeValue(dsfUpdateFailed_);
   }
+  void dsfUpdateBatch(uint64_t numPeers, std::chrono::milliseconds latency) {
+    dsfUpdateBatchSize_.addValue(numPeers);
+    dsfUpdateBatchLatency_.addValue(latency.count());
+  }
 
   void getHwAgentStatus(
       std::map<int16_t, HwAgentEventSyncStatus>& statusMap) const;
@@ -939,6 +943,10 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries switchConfiguredMs_;
   TLTimeseries dsfGrExpired_;
   TLTimeseries dsfUpdateFailed_;
+  // Number of DSF peers whose updates were applied in one state update
+  TLHistogram dsfUpdateBatchSize_;
+  // Time from the first update of a batch being queued until it was applied
+  TLHistogram dsfUpdateBatchLatency_;
 
   // TODO: delete this once multi_switch becomes default
   TLTimeseries multiSwitchStatus_;
@@ -55,6 +55,7 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/SwitchStateMemoryUsage.h"
 #include "fboss/agent/state/Transceiver.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
@@ -1425,6 +1426,13 @@ void ThriftHandler::patchCurrentStateJSONForPaths(
       std::move(updateDsfStateFn));
 }
 
+void ThriftHandler::getSwitchStateMemoryUsage(
+    std::map<std::string, SwitchStateMemoryUsage>& subtreeToUsage) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  subtreeToUsage = computeSwitchStateMemoryUsage(sw_->getState());
+}
+
 void ThriftHandler::getPortStatusImpl(
     std::map<int32_t, PortStatus>& statusMap,
     const std::unique_ptr<std::vector<int32_t>>& ports) const {
@@ -2077,8 +2085,15 @@ void ThriftHandler::startPktCapture(unique_ptr<CaptureInfo> info) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
   auto* mgr = sw_->getCaptureMgr();
+  if (*info->maxPacketBytes() < 0) {
+    throw FbossError("maxPacketBytes must not be negative");
+  }
   auto capture = make_unique<PktCapture>(
-      *info->name(), *info->maxPackets(), *info->direction(), *info->filter());
+      *info->name(),
+      *info->maxPackets(),
+      *info->direction(),
+      *info->filter(),
+      *info->maxPacketBytes());
   mgr->startCapture(std::move(capture));
 }
 
@@ -381,6 +381,12 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::unique_ptr<std::map<std::string, std::string>> pathToJsonPatch)
       override;
 
+  /*
+   * Estimated memory used by each subtree of the live running switch state
+   */
+  void getSwitchStateMemoryUsage(
+      std::map<std::string, SwitchStateMemoryUsage>& subtreeToUsage) override;
+
   SwitchRunState getSwitchRunState() override;
 
   void setSSLPolicy(apache::thrift::SSLPolicy sslPolicy) {
@@ -10,15 +10,18 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 
+#include <algorithm>
 #include <iostream>
 
 #include "fboss/agent/benchmarks/AgentBenchmarksMain.h"
 
 #include "fboss/agent/benchmarks/AgentBenchmarks.h"
+#include "fboss/lib/FunctionCallTimeReporter.h"
 
 const int64_t kUsecPerSecond = 1000000;
 
 DECLARE_int64(bm_max_iters);
+DECLARE_bool(enable_call_timing);
 
 inline int64_t timevalToUsec(const timeval& tv) {
   return (int64_t(tv.tv_sec) * kUsecPerSecond) + tv.tv_usec;
@@ -62,6 +65,18 @@ int main(int argc, char* argv[]) {
   folly::dynamic rusageJson = folly::dynamic::object;
   rusageJson["cpu_time_usec"] = cpuTime;
   rusageJson["max_rss"] = endUsage.ru_maxrss;
+  if (FLAGS_enable_call_timing) {
+    // Split timed benchmark sections into time spent in the SDK and time
+    // spent in agent software (state updates, delta processing, SAI store
+    // bookkeeping), so software regressions are visible on their own, e.g.
+    // when running against fake SAI.
+    auto reporter = facebook::fboss::FunctionCallTimeReporter::getInstance();
+    int64_t totalUsecs = reporter->getTotalUsecs();
+    int64_t sdkUsecs = reporter->getTotalTimedCallUsecs();
+    rusageJson["timed_total_usec"] = totalUsecs;
+    rusageJson["timed_sdk_usec"] = sdkUsecs;
+    rusageJson["timed_sw_usec"] = std::max<int64_t>(totalUsecs - sdkUsecs, 0);
+  }
   std::cout << toPrettyJson(rusageJson) << std::endl;
 
   return 0;
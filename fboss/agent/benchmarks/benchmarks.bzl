@@ -86,6 +86,7 @@ def agent_benchmark_lib(mono):
         exported_deps = [
             "fbsource//third-party/googletest:gtest",
             ensemble_lib,
+            "//fboss/lib:function_call_time_reporter",
         ],
     )
 
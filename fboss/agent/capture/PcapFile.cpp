@@ -14,6 +14,7 @@
 #include <folly/Exception.h>
 #include <folly/FileUtil.h>
 
+#include <algorithm>
 #include <chrono>
 
 using folly::IOBuf;
@@ -33,7 +34,8 @@ PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
   timeSec = tsSec.count();
   timeUsec = (tsUsec - tsSec).count();
   includedLen = len;
-  origLen = len;
+  // Packets built without a length of their own were not truncated
+  origLen = std::max<uint32_t>(len, pkt.origLen());
 }
 
 PcapFile::PcapFile() {}
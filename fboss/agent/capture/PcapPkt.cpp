@@ -11,10 +11,22 @@
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
 
+#include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 
 namespace facebook::fboss {
 
+namespace {
+void cloneBuf(const folly::IOBuf* src, uint32_t snapLen, folly::IOBuf& dst) {
+  if (snapLen == 0) {
+    src->cloneInto(dst);
+    return;
+  }
+  folly::io::Cursor cursor(src);
+  cursor.cloneAtMost(dst, snapLen);
+}
+} // namespace
+
 PcapPkt::PcapPkt() {}
 
 PcapPkt::PcapPkt(const RxPacket* pkt)
@@ -27,10 +39,23 @@ PcapPkt::PcapPkt(const RxPacket* pkt, TimePoint timestamp)
       vlan_(pkt->getSrcVlanIf()),
       timestamp_(timestamp),
       buf_(),
+      origLen_(pkt->buf()->computeChainDataLength()),
       reasons_() {
   pkt->buf()->cloneInto(buf_);
 }
 
+PcapPkt::PcapPkt(const RxPacket* pkt, uint32_t snapLen)
+    : initialized_(true),
+      rx_(true),
+      port_(pkt->getSrcPort()),
+      vlan_(pkt->getSrcVlanIf()),
+      timestamp_(std::chrono::system_clock::now()),
+      buf_(),
+      origLen_(pkt->buf()->computeChainDataLength()),
+      reasons_() {
+  cloneBuf(pkt->buf(), snapLen, buf_);
+}
+
 PcapPkt::PcapPkt(const TxPacket* pkt)
     : PcapPkt(pkt, std::chrono::system_clock::now()) {}
 
@@ -41,10 +66,23 @@ PcapPkt::PcapPkt(const TxPacket* pkt, TimePoint timestamp)
       vlan_(0),
       timestamp_(timestamp),
       buf_(),
+      origLen_(pkt->buf()->computeChainDataLength()),
       reasons_() {
   pkt->buf()->cloneInto(buf_);
 }
 
+PcapPkt::PcapPkt(const TxPacket* pkt, uint32_t snapLen)
+    : initialized_(true),
+      rx_(false),
+      port_(0),
+      vlan_(0),
+      timestamp_(std::chrono::system_clock::now()),
+      buf_(),
+      origLen_(pkt->buf()->computeChainDataLength()),
+      reasons_() {
+  cloneBuf(pkt->buf(), snapLen, buf_);
+}
+
 PcapPkt::PcapPkt(const RxPacketData* pkt)
     : PcapPkt(pkt, std::chrono::system_clock::now()) {}
 
@@ -55,6 +93,7 @@ PcapPkt::PcapPkt(const RxPacketData* pkt, TimePoint timestamp)
       vlan_(pkt->srcVlan),
       timestamp_(timestamp),
       buf_(),
+      origLen_(pkt->packetData.size()),
       reasons_(std::move(pkt->reasons)) {
   buf_ = std::move(*folly::IOBuf::copyBuffer(
       pkt->packetData.data(), pkt->packetData.size()));
@@ -70,6 +109,7 @@ PcapPkt::PcapPkt(const TxPacketData* pkt, TimePoint timestamp)
       vlan_(0),
       timestamp_(timestamp),
       buf_(),
+      origLen_(pkt->packetData.size()),
       reasons_() {
   buf_ = std::move(*folly::IOBuf::copyBuffer(
       pkt->packetData.data(), pkt->packetData.size()));
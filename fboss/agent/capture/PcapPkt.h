@@ -73,6 +73,14 @@ class PcapPkt {
   explicit PcapPkt(const TxPacket* pkt);
   PcapPkt(const TxPacket* pkt, TimePoint timestamp);
 
+  /*
+   * Create a PcapPkt holding at most the first snapLen bytes of the packet.
+   * A snapLen of 0 keeps the whole packet. The packet data is shared with
+   * the original buffer rather than copied.
+   */
+  PcapPkt(const RxPacket* pkt, uint32_t snapLen);
+  PcapPkt(const TxPacket* pkt, uint32_t snapLen);
+
   /*
    * Create a PcapPkt from distribution service data
    */
@@ -106,6 +114,10 @@ class PcapPkt {
   const folly::IOBuf* buf() const {
     return &buf_;
   }
+  // Length of the packet on the wire, which buf() may be truncated from
+  uint32_t origLen() const {
+    return origLen_;
+  }
   std::vector<RxReason> getReasons() {
     return reasons_;
   }
@@ -123,6 +135,7 @@ class PcapPkt {
     vlan_ = other.vlan_;
     timestamp_ = other.timestamp_;
     buf_ = std::move(other.buf_);
+    origLen_ = other.origLen_;
     reasons_ = std::move(other.reasons_);
     return *this;
   }
@@ -147,6 +160,7 @@ class PcapPkt {
   TimePoint timestamp_;
   // The packet contents, starting from the ethernet header.
   folly::IOBuf buf_;
+  uint32_t origLen_{0};
   // Reasons for sending packet to CPU
   std::vector<RxReason> reasons_;
 };
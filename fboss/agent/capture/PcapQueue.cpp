@@ -13,6 +13,8 @@
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/capture/PcapPkt.h"
 
+#include <algorithm>
+
 DEFINE_int32(
     fboss_pcap_queue_depth,
     10240,
@@ -22,96 +24,96 @@ DEFINE_int32(
 
 namespace facebook::fboss {
 
-PcapQueue::PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity)
+PcapQueue::PcapQueue(
+    uint32_t pktCapacity,
+    uint64_t bytesCapacity,
+    uint32_t snapLen)
     : pktCapacity_(
           pktCapacity == 0 ? FLAGS_fboss_pcap_queue_depth : pktCapacity),
-      bytesCapacity_(bytesCapacity) {
-  queue_.reserve(pktCapacity_);
-}
+      bytesCapacity_(bytesCapacity),
+      snapLen_(snapLen),
+      queue_(pktCapacity_) {}
 
 PcapQueue::~PcapQueue() {}
 
 template <typename PktType>
 void PcapQueue::addPktInternal(const PktType* pkt) {
-  // Check to see if this would exceed the queue capacity.
-  if (queue_.size() >= pktCapacity_) {
-    pktsDropped_ += 1;
-    return;
+  uint64_t len = pkt->buf()->computeChainDataLength();
+  if (snapLen_ > 0) {
+    len = std::min<uint64_t>(len, snapLen_);
   }
-  auto newBytes = bytesInQueue_ + pkt->buf()->computeChainDataLength();
-  if (bytesCapacity_ > 0 && newBytes >= bytesCapacity_) {
+  // Reserve the bytes first so concurrent writers cannot overshoot the limit
+  if (bytesCapacity_ > 0 &&
+      bytesInQueue_.fetch_add(len) + len >= bytesCapacity_) {
+    bytesInQueue_ -= len;
     pktsDropped_ += 1;
     return;
   }
 
-  queue_.emplace_back(pkt);
-}
-
-void PcapQueue::addPkt(const RxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
+  // write() only constructs the PcapPkt if a slot is free
+  if (!queue_.write(pkt, snapLen_)) {
+    if (bytesCapacity_ > 0) {
+      bytesInQueue_ -= len;
+    }
+    pktsDropped_ += 1;
   }
-  cv_.notify_one();
 }
 
-void PcapQueue::addPktLocked(const RxPacket* pkt) {
+void PcapQueue::addPkt(const RxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::addPkt(const TxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
-}
-
-void PcapQueue::addPktLocked(const TxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::finish() {
-  std::lock_guard<std::mutex> guard(mutex_);
-  finished_ = true;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    finished_ = true;
+  }
   cv_.notify_all();
 }
 
 bool PcapQueue::isFinished() const {
-  std::lock_guard<std::mutex> guard(mutex_);
   return finished_;
 }
 
 uint64_t PcapQueue::numDropped() const {
-  std::lock_guard<std::mutex> guard(mutex_);
   return pktsDropped_;
 }
 
+void PcapQueue::drain(std::vector<PcapPkt>* swapQueue) {
+  PcapPkt pkt;
+  uint64_t bytes = 0;
+  while (swapQueue->size() < pktCapacity_ && queue_.read(pkt)) {
+    bytes += pkt.buf()->computeChainDataLength();
+    swapQueue->push_back(std::move(pkt));
+  }
+  if (bytesCapacity_ > 0) {
+    bytesInQueue_ -= bytes;
+  }
+}
+
 bool PcapQueue::wait(std::vector<PcapPkt>* swapQueue) {
   swapQueue->clear();
   swapQueue->reserve(pktCapacity_);
 
-  std::unique_lock<std::mutex> guard(mutex_);
-  cv_.wait(guard, [&]() { return !queue_.empty() || finished_; });
-  if (queue_.empty()) {
-    DCHECK(finished_);
-    queue_.shrink_to_fit();
-    return false;
+  while (true) {
+    drain(swapQueue);
+    if (!swapQueue->empty()) {
+      return true;
+    }
+
+    std::unique_lock<std::mutex> guard(mutex_);
+    if (finished_) {
+      guard.unlock();
+      // Pick up packets from writers that raced with finish()
+      drain(swapQueue);
+      return !swapQueue->empty();
+    }
+    cv_.wait_for(guard, kDrainInterval);
   }
-
-  swapQueue->swap(queue_);
-  bytesInQueue_ = 0;
-  return true;
 }
 
 } // namespace facebook::fboss
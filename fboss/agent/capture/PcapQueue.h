@@ -9,26 +9,41 @@
  */
 #pragma once
 
+#include <folly/MPMCQueue.h>
+
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
 
+#include "fboss/agent/capture/PcapPkt.h"
+
 namespace facebook::fboss {
 
 class RxPacket;
 class TxPacket;
-class PcapPkt;
 
 /*
  * PcapQueue stores a queue of PcapPkt objects, for transferring packets
  * from an asynchronous capture thread to a blocking thread that will process
  * the packets.  (For instance, writing them to disk using blocking I/O.)
  *
+ * Packets are written into a ring of slots allocated up front, so adding a
+ * packet never takes a lock or allocates, and never blocks the packet path:
+ * if the ring is full the packet is dropped and counted instead.
+ *
+ * If snapLen is non-zero only the first snapLen bytes of each packet are
+ * kept.  Packet data is shared with the original buffer, not copied.
+ *
  * There can only be a single reader.
  */
 class PcapQueue {
  public:
-  explicit PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity = 0);
+  explicit PcapQueue(
+      uint32_t pktCapacity,
+      uint64_t bytesCapacity = 0,
+      uint32_t snapLen = 0);
   virtual ~PcapQueue();
 
   uint32_t getPktCapacity() const {
@@ -36,21 +51,8 @@ class PcapQueue {
     return pktCapacity_;
   }
 
-  /*
-   * Get the mutex protecting this PcapQueue.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapQueue mutex.
-   */
-  std::mutex& mutex() const {
-    return mutex_;
-  }
-
   void addPkt(const RxPacket* pkt);
-  void addPktLocked(const RxPacket* pkt);
   void addPkt(const TxPacket* pkt);
-  void addPktLocked(const TxPacket* pkt);
 
   /*
    * finish() signals that no more packets will be added to the queue.
@@ -73,12 +75,17 @@ class PcapQueue {
   /*
    * Wait for new packets from the queue.
    *
+   * All packets available are returned at once.  The reader polls the ring
+   * every kDrainInterval while it is empty, since writers do not signal it.
+   *
    * Note: for best performance, the writer should re-use the same vector
    * for multiple wait() calls.  On subsequent calls the queue will already
    * have the desired capacity, and will not need to reallocate memory.
    */
   bool wait(std::vector<PcapPkt>* swapQueue);
 
+  static constexpr auto kDrainInterval = std::chrono::milliseconds(10);
+
  private:
   // Forbidden copy constructor and assignment operator
   PcapQueue(PcapQueue const&) = delete;
@@ -86,16 +93,19 @@ class PcapQueue {
 
   template <typename PktType>
   void addPktInternal(const PktType* pkt);
+  void drain(std::vector<PcapPkt>* swapQueue);
 
-  mutable std::mutex mutex_;
-  std::condition_variable cv_;
-
-  bool finished_{false};
   const uint32_t pktCapacity_{0};
-  uint64_t bytesCapacity_{0};
-  uint64_t bytesInQueue_{0};
-  uint64_t pktsDropped_{0};
-  std::vector<PcapPkt> queue_;
+  const uint64_t bytesCapacity_{0};
+  const uint32_t snapLen_{0};
+  folly::MPMCQueue<PcapPkt> queue_;
+  std::atomic<uint64_t> bytesInQueue_{0};
+  std::atomic<uint64_t> pktsDropped_{0};
+  std::atomic<bool> finished_{false};
+
+  // Only used to wake the reader early when finish() is called
+  std::mutex mutex_;
+  std::condition_variable cv_;
 };
 
 } // namespace facebook::fboss
@@ -18,14 +18,16 @@ using folly::StringPiece;
 
 namespace facebook::fboss {
 
-PcapWriter::PcapWriter(uint32_t maxBufferedPkts) : queue_(maxBufferedPkts) {}
+PcapWriter::PcapWriter(uint32_t maxBufferedPkts, uint32_t snapLen)
+    : queue_(maxBufferedPkts, 0, snapLen) {}
 
 PcapWriter::PcapWriter(
     StringPiece path,
     bool overwriteExisting,
-    uint32_t maxBufferedPkts)
+    uint32_t maxBufferedPkts,
+    uint32_t snapLen)
     : file_(path, overwriteExisting),
-      queue_(maxBufferedPkts),
+      queue_(maxBufferedPkts, 0, snapLen),
       thread_(&PcapWriter::threadMain, this) {}
 
 PcapWriter::~PcapWriter() {
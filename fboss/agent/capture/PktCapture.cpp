@@ -27,9 +27,12 @@ PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
     CaptureDirection direction,
-    const CaptureFilter& captureFilter)
+    const CaptureFilter& captureFilter,
+    uint32_t maxPacketBytes)
     : name_(name.str()),
+      writer_(0, maxPacketBytes),
       maxPackets_(maxPackets),
+      maxPacketBytes_(maxPacketBytes),
       direction_(direction),
       packetFilter_(captureFilter) {}
 
@@ -43,23 +46,35 @@ void PktCapture::stop() {
   XLOG(DBG2) << "Stopped packet capture " << toString(true);
 }
 
+bool PktCapture::reserve(bool* moreAllowed) {
+  auto slot = numReserved_.fetch_add(1, std::memory_order_relaxed);
+  *moreAllowed = slot + 1 < maxPackets_;
+  return slot < maxPackets_;
+}
+
 bool PktCapture::packetReceived(const RxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_TX &&
-      true == packetFilter_.passes(pkt)) {
+  if (direction_ == CaptureDirection::CAPTURE_ONLY_TX ||
+      !packetFilter_.passes(pkt)) {
+    return numReserved_.load(std::memory_order_relaxed) < maxPackets_;
+  }
+  bool moreAllowed;
+  if (reserve(&moreAllowed)) {
     ++numPacketsReceived_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return moreAllowed;
 }
 
 bool PktCapture::packetSent(const TxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX) {
+  if (direction_ == CaptureDirection::CAPTURE_ONLY_RX) {
+    return numReserved_.load(std::memory_order_relaxed) < maxPackets_;
+  }
+  bool moreAllowed;
+  if (reserve(&moreAllowed)) {
     ++numPacketsSent_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
-  return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
+  return moreAllowed;
 }
 
 std::string PktCapture::toString(bool withStats) const {
@@ -69,15 +84,18 @@ std::string PktCapture::toString(bool withStats) const {
              ? "Tx and Rx"
              : ((direction_ == CaptureDirection::CAPTURE_ONLY_RX) ? "RX only"
                                                                   : "TX only"));
+  if (maxPacketBytes_ > 0) {
+    ss << ", maxPacketBytes:" << maxPacketBytes_;
+  }
   if (withStats) {
     ss << ", Packet received:" << numPacketsReceived_
-       << ", Packet sent:" << numPacketsSent_;
+       << ", Packet sent:" << numPacketsSent_
+       << ", Packet dropped:" << writer_.numDropped();
   }
   return ss.str();
 }
 
 int PktCapture::getCaptureCount() {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
   return (numPacketsSent_ + numPacketsReceived_);
 }
 } // namespace facebook::fboss
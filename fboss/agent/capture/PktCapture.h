@@ -14,6 +14,7 @@
 
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
+#include <atomic>
 #include <string>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
@@ -42,7 +43,7 @@ class PacketFilter {
   explicit PacketFilter(const CaptureFilter& captureFilter)
       : rxPacketFilter_(captureFilter.get_rxCaptureFilter()) {}
 
-  bool passes(const RxPacket* pkt) {
+  bool passes(const RxPacket* pkt) const {
     return rxPacketFilter_.passes(pkt);
   }
 
@@ -52,6 +53,10 @@ class PacketFilter {
 
 /*
  * A packet capture job.
+ *
+ * packetReceived() and packetSent() may be called concurrently from any
+ * thread and never lock: packets are filtered first, then a slot is reserved
+ * against maxPackets, and only then is the packet handed to the writer.
  */
 class PktCapture {
  public:
@@ -63,7 +68,8 @@ class PktCapture {
       folly::StringPiece name,
       uint64_t maxPackets,
       CaptureDirection direction,
-      const CaptureFilter& captureFilter);
+      const CaptureFilter& captureFilter,
+      uint32_t maxPacketBytes = 0);
 
   const std::string& name() const {
     return name_;
@@ -85,13 +91,17 @@ class PktCapture {
 
   const std::string name_;
 
-  // Note: the rest of the state in this class is protcted by
-  // the PcapWriter's mutex.
+  // Reserve a slot for one more packet, false once maxPackets is reached
+  bool reserve(bool* moreAllowed);
+
   PcapWriter writer_;
-  uint64_t maxPackets_{0};
-  uint64_t numPacketsReceived_{0};
-  uint64_t numPacketsSent_{0};
-  CaptureDirection direction_{CaptureDirection::CAPTURE_TX_RX};
-  PacketFilter packetFilter_;
+  const uint64_t maxPackets_{0};
+  const uint32_t maxPacketBytes_{0};
+  // May run past maxPackets_ when concurrent callers race for the last slot
+  std::atomic<uint64_t> numReserved_{0};
+  std::atomic<uint64_t> numPacketsReceived_{0};
+  std::atomic<uint64_t> numPacketsSent_{0};
+  const CaptureDirection direction_{CaptureDirection::CAPTURE_TX_RX};
+  const PacketFilter packetFilter_;
 };
 } // namespace facebook::fboss
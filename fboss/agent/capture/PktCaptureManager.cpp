@@ -16,6 +16,8 @@
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
+#include <shared_mutex>
+
 using folly::StringPiece;
 using std::string;
 using std::unique_ptr;
@@ -56,7 +58,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
   auto path =
       folly::to<std::string>(captureDir_, "/", capture->name(), ".pcap");
 
-  std::lock_guard<std::mutex> g(mutex_);
+  std::unique_lock g(mutex_);
 
   const auto& name = capture->name();
   if (activeCaptures_.find(name) != activeCaptures_.end()) {
@@ -69,7 +71,7 @@ void PktCaptureManager::startCapture(unique_ptr<PktCapture> capture) {
 }
 
 void PktCaptureManager::stopCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::unique_lock g(mutex_);
 
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
@@ -83,7 +85,7 @@ void PktCaptureManager::stopCapture(StringPiece name) {
 }
 
 unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::unique_lock g(mutex_);
   auto nameStr = name.str();
   auto activeIt = activeCaptures_.find(nameStr);
   if (activeIt != activeCaptures_.end()) {
@@ -105,49 +107,60 @@ unique_ptr<PktCapture> PktCaptureManager::forgetCapture(StringPiece name) {
 }
 
 void PktCaptureManager::stopAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::unique_lock g(mutex_);
 
   // FIXME
 }
 
 void PktCaptureManager::forgetAllCaptures() {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::unique_lock g(mutex_);
 
   // FIXME
 }
 
 template <typename Fn>
 void PktCaptureManager::invokeCaptures(const Fn& fn) {
-  std::lock_guard<std::mutex> g(mutex_);
-
-  for (auto it = activeCaptures_.begin(); it != activeCaptures_.end();
-       /* increment in loop */) {
-    // Increment the iterator now, in case this capture deactivates itself and
-    // we need to remove it from the active captures.
-    auto thisIt = it;
-    ++it;
-    PktCapture* capture = thisIt->second.get();
-    bool stillActive = false;
-    try {
-      stillActive = fn(capture);
-    } catch (const std::exception& ex) {
-      XLOG(ERR) << "error when processing packet for capture "
-                << capture->name() << " : " << folly::exceptionStr(ex);
-      stillActive = false;
-    }
-
-    if (!stillActive) {
-      XLOG(DBG2) << "auto-stopping packet capture \"" << capture->name()
-                 << "\"";
+  // Only filled in the rare case a capture finishes
+  std::vector<std::pair<std::string, PktCapture*>> finished;
+  {
+    std::shared_lock g(mutex_);
+    for (const auto& [name, capture] : activeCaptures_) {
+      bool stillActive = false;
       try {
-        inactiveCaptures_[capture->name()] = std::move(thisIt->second);
-      } catch (const std::exception&) {
-        XLOG(ERR) << "error adding capture " << capture->name()
-                  << " to the inactive list";
-        // Can't do much else here.  Just continue and forget the capture.
+        stillActive = fn(capture.get());
+      } catch (const std::exception& ex) {
+        XLOG(ERR) << "error when processing packet for capture " << name
+                  << " : " << folly::exceptionStr(ex);
+        stillActive = false;
       }
-      activeCaptures_.erase(thisIt);
+      if (!stillActive) {
+        finished.emplace_back(name, capture.get());
+      }
+    }
+  }
+
+  if (!finished.empty()) {
+    retireCaptures(finished);
+  }
+}
+
+void PktCaptureManager::retireCaptures(
+    const std::vector<std::pair<std::string, PktCapture*>>& finished) {
+  std::unique_lock g(mutex_);
+  for (const auto& [name, capture] : finished) {
+    // Another thread may have already retired or replaced this capture
+    auto it = activeCaptures_.find(name);
+    if (it == activeCaptures_.end() || it->second.get() != capture) {
+      continue;
+    }
+    XLOG(DBG2) << "auto-stopping packet capture \"" << name << "\"";
+    try {
+      inactiveCaptures_[name] = std::move(it->second);
+    } catch (const std::exception&) {
+      XLOG(ERR) << "error adding capture " << name << " to the inactive list";
+      // Can't do much else here.  Just continue and forget the capture.
     }
+    activeCaptures_.erase(it);
   }
 
   bool running = !activeCaptures_.empty();
@@ -177,7 +190,7 @@ void PktCaptureManager::checkCaptureName(folly::StringPiece name) {
 // routine as used in tests to verify if the pkt capture buffer
 // limit has been reached
 int PktCaptureManager::getCaptureCount(StringPiece name) {
-  std::lock_guard<std::mutex> g(mutex_);
+  std::shared_lock g(mutex_);
   auto nameStr = name.str();
   auto it = activeCaptures_.find(nameStr);
   if (it == activeCaptures_.end()) {
@@ -10,12 +10,14 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <folly/SharedMutex.h>
 
 #include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 #include "fboss/agent/PacketObserver.h"
 
 namespace facebook::fboss {
@@ -77,10 +79,17 @@ class PktCaptureManager : public PacketObserverIf {
   void invokeCaptures(const Fn& fn);
   void packetReceivedImpl(const RxPacket* pkt);
   void packetSentImpl(const TxPacket* pkt);
+  void retireCaptures(
+      const std::vector<std::pair<std::string, PktCapture*>>& finished);
 
   std::atomic<bool> capturesRunning_{false};
 
-  std::mutex mutex_;
+  /*
+   * The packet path only takes this shared, so packets from different
+   * threads are handed to the captures in parallel.  Adding and removing
+   * captures takes it exclusively.
+   */
+  folly::SharedMutex mutex_;
   std::string captureDir_;
   std::map<std::string, std::unique_ptr<PktCapture>> activeCaptures_;
   std::map<std::string, std::unique_ptr<PktCapture>> inactiveCaptures_;
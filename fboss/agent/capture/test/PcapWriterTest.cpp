@@ -101,3 +101,28 @@ TEST(PcapWriterTest, Drop) {
     EXPECT_EQ(68, pktInfo.hdr.caplen);
   }
 }
+
+TEST(PcapWriterTest, Truncate) {
+  char tmpPath[] = "fbossPcapTest.XXXXXX";
+  int tmpFD = mkstemp(tmpPath);
+  folly::checkUnixError(tmpFD, "failed to create temporary file");
+  SCOPE_EXIT {
+    close(tmpFD);
+    unlink(tmpPath);
+  };
+
+  // Only keep the ethernet, VLAN and IPv4 headers of each packet
+  PcapWriter writer(tmpPath, true, 0, 38);
+  uint32_t numPkts = 10;
+  addPackets(&writer, numPkts);
+  writer.finish();
+  EXPECT_EQ(0, writer.numDropped());
+
+  auto pcapPkts = readPcapFile(tmpPath);
+  EXPECT_EQ(numPkts, pcapPkts.size());
+  for (const auto& pktInfo : pcapPkts) {
+    EXPECT_EQ(68, pktInfo.hdr.len);
+    EXPECT_EQ(38, pktInfo.hdr.caplen);
+    EXPECT_EQ(38, pktInfo.data.size());
+  }
+}
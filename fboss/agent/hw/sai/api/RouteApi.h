@@ -142,6 +142,40 @@ class RouteApi : public SaiApi<RouteApi> {
       const sai_attribute_t* attr) const {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
+  sai_status_t _bulkCreate(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      uint32_t objectCount,
+      const uint32_t* attrCount,
+      const sai_attribute_t** attrLists,
+      sai_bulk_op_error_mode_t mode,
+      sai_status_t* retStatus) const {
+    if (!api_->create_route_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      entries.push_back(*routeEntries[idx].entry());
+    }
+    return api_->create_route_entries(
+        objectCount, entries.data(), attrCount, attrLists, mode, retStatus);
+  }
+  sai_status_t _bulkRemove(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      uint32_t objectCount,
+      sai_bulk_op_error_mode_t mode,
+      sai_status_t* retStatus) const {
+    if (!api_->remove_route_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      entries.push_back(*routeEntries[idx].entry());
+    }
+    return api_->remove_route_entries(
+        objectCount, entries.data(), mode, retStatus);
+  }
 
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
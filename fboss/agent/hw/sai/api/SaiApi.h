@@ -85,7 +85,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are not expected",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -127,7 +127,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are not expected",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -159,7 +159,7 @@ class SaiApi {
           "Attempting to remove SAI obj {} while hw writes are not expected",
           key);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -172,6 +172,115 @@ class SaiApi {
     XLOGF(DBG5, "removed SAI object: {}", key);
   }
 
+  /*
+   * Bulk create/remove of entry struct objects (e.g. routes). Entries are
+   * processed independently (SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR), and the
+   * status of each entry is returned so that callers can undo the entries
+   * which did succeed. Throws if the bulk call as a whole is rejected, e.g.
+   * if the adapter does not implement it.
+   */
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+      std::vector<sai_status_t>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    std::vector<sai_status_t> retStatus(entries.size(), SAI_STATUS_SUCCESS);
+    if (UNLIKELY(skipHwWrites()) || entries.empty()) {
+      return retStatus;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk create of {} SAI objects, while hw writes are blocked",
+          entries.size());
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOGF(
+          WARNING,
+          "Attempting bulk create of {} SAI objects, while hw writes are not expected",
+          entries.size());
+    }
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    std::vector<uint32_t> attrCount;
+    std::vector<const sai_attribute_t*> attrLists;
+    saiAttributeTs.reserve(entries.size());
+    attrCount.reserve(entries.size());
+    attrLists.reserve(entries.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+      attrCount.push_back(saiAttributeTs.back().size());
+      attrLists.push_back(saiAttributeTs.back().data());
+    }
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          entries.data(),
+          entries.size(),
+          attrCount.data(),
+          attrLists.data(),
+          SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+          retStatus.data());
+    }
+    // SAI_STATUS_FAILURE means at least one entry failed, which callers
+    // handle using per entry status
+    if (status != SAI_STATUS_FAILURE) {
+      saiApiCheckError(
+          status,
+          apiType(),
+          fmt::format("Failed to bulk create {} sai entities", entries.size()));
+    }
+    XLOGF(DBG5, "bulk created {} SAI objects", entries.size());
+    return retStatus;
+  }
+
+  template <typename AdapterKeyT>
+  std::vector<sai_status_t> bulkRemove(
+      const std::vector<AdapterKeyT>& keys) const {
+    std::vector<sai_status_t> retStatus(keys.size(), SAI_STATUS_SUCCESS);
+    if (UNLIKELY(skipHwWrites()) || keys.empty()) {
+      return retStatus;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk remove of {} SAI objects while hw writes are blocked",
+          keys.size());
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOGF(
+          WARNING,
+          "Attempting bulk remove of {} SAI objects while hw writes are not expected",
+          keys.size());
+    }
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkRemove(
+          keys.data(),
+          keys.size(),
+          SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+          retStatus.data());
+    }
+    if (status != SAI_STATUS_FAILURE) {
+      saiApiCheckError(
+          status,
+          apiType(),
+          fmt::format("Failed to bulk remove {} sai objects", keys.size()));
+    }
+    XLOGF(DBG5, "bulk removed {} SAI objects", keys.size());
+    return retStatus;
+  }
+
   /*
    * We can do getAttribute on top of more complicated types than just
    * attributes. For example, if we overload on tuples and optionals, we
@@ -193,7 +302,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -331,7 +440,7 @@ class SaiApi {
     // to retrieve txReadyStatusChange. However, this can be enhanced in the
     // future.
 
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
 
     // We only support querying 1 attr per SAI Object today
     constexpr auto kMaxNumAttrsPerObject = 1;
@@ -430,7 +539,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) const {
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     setAttributeUnlocked(key, attr);
   }
 
@@ -493,7 +602,7 @@ class SaiApi {
   void bulkSetAttributes(
       std::vector<AdapterKeyT>& adapterKeys,
       std::vector<AttrT>& attributes) const {
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     return bulkSetAttributesUnlocked(adapterKeys, attributes);
   }
 
@@ -505,7 +614,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -516,7 +625,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -538,7 +647,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -546,7 +655,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -9,9 +9,15 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
 namespace facebook::fboss {
 
 class SaiApiLock {
@@ -35,12 +41,38 @@ class SaiApiLock {
   void setAdaptorIsThreadSafe(bool isThreadSafe) {
     adaptorIsThreadSafe_ = isThreadSafe;
   }
+  /*
+   * For adaptors which are thread safe across, but not within, SAI APIs.
+   * When enabled, calls into different APIs (e.g. route and port) no longer
+   * serialize on a single adaptor wide mutex.
+   *
+   * Must be set before any SAI API is called: a call holding the adaptor
+   * wide mutex is not excluded by one taking a per API mutex.
+   */
+  void setPerApiLocking(bool perApiLocking) {
+    perApiLocking_.store(perApiLocking, std::memory_order_relaxed);
+  }
+  bool perApiLocking() const {
+    return perApiLocking_.load(std::memory_order_relaxed);
+  }
   ScopedApiLock lock() const {
     return {mutex_, adaptorIsThreadSafe_};
   }
+  ScopedApiLock lock(sai_api_t api) const {
+    if (!perApiLocking()) {
+      return lock();
+    }
+    // Extension APIs may fall outside [0, SAI_API_MAX), map them onto the
+    // same set of mutexes. Sharing a mutex only costs concurrency.
+    return {
+        apiMutexes_[static_cast<size_t>(api) % apiMutexes_.size()],
+        adaptorIsThreadSafe_};
+  }
 
  private:
   bool adaptorIsThreadSafe_{false};
+  std::atomic<bool> perApiLocking_{false};
   mutable std::mutex mutex_;
+  mutable std::array<std::mutex, SAI_API_MAX> apiMutexes_;
 };
 } // namespace facebook::fboss
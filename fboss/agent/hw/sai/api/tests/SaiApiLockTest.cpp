@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kBlockedTimeout = std::chrono::milliseconds(100);
+
+// Take the lock of api on another thread while the caller holds a lock
+std::future<void> lockAsync(sai_api_t api) {
+  return std::async(std::launch::async, [api] {
+    auto g{SaiApiLock::getInstance()->lock(api)};
+  });
+}
+} // namespace
+
+class SaiApiLockTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    SaiApiLock::getInstance()->setPerApiLocking(false);
+  }
+};
+
+TEST_F(SaiApiLockTest, allApisSerializeByDefault) {
+  std::future<void> portLock;
+  {
+    auto g{SaiApiLock::getInstance()->lock(SAI_API_ROUTE)};
+    portLock = lockAsync(SAI_API_PORT);
+    EXPECT_EQ(portLock.wait_for(kBlockedTimeout), std::future_status::timeout);
+  }
+  portLock.get();
+}
+
+TEST_F(SaiApiLockTest, differentApisDoNotSerializePerApi) {
+  SaiApiLock::getInstance()->setPerApiLocking(true);
+  auto g{SaiApiLock::getInstance()->lock(SAI_API_ROUTE)};
+  // Would deadlock if port calls had to wait for the route lock
+  lockAsync(SAI_API_PORT).get();
+}
+
+TEST_F(SaiApiLockTest, sameApiSerializesPerApi) {
+  SaiApiLock::getInstance()->setPerApiLocking(true);
+  std::future<void> routeLock;
+  {
+    auto g{SaiApiLock::getInstance()->lock(SAI_API_ROUTE)};
+    routeLock = lockAsync(SAI_API_ROUTE);
+    EXPECT_EQ(
+        routeLock.wait_for(kBlockedTimeout), std::future_status::timeout);
+  }
+  routeLock.get();
+}
@@ -29,6 +29,15 @@ def _mono_sai_agent_benchmark_binary(name, srcs, sai_impl, **kwargs):
         **kwargs
     )
 
+def _fake_sai_agent_benchmark_binary(name, srcs, sai_impl, **kwargs):
+    deps = list(kwargs.get("deps", []))
+
+    # fake SAI does not provide the SDK symbols the agent expects from
+    # vendor SAI implementations
+    deps.append("//fboss/agent/platforms/sai:bcm-required-symbols")
+    kwargs["deps"] = deps
+    return _mono_sai_agent_benchmark_binary(name, srcs, sai_impl, **kwargs)
+
 def _multi_switch_agent_benchmark_binary(name, srcs, **kwargs):
     name = "multi_switch-{}".format(name)
     main_name = "multi_switch_sai_agent_benchmarks_main"
@@ -52,5 +61,16 @@ def sai_mono_agent_benchmark(name, srcs, **kwargs):
             continue
         _mono_sai_agent_benchmark_binary(name, srcs, sai_impl, **kwargs)
 
+def sai_fake_agent_benchmark(name, srcs, **kwargs):
+    """
+    Benchmarks built against fake SAI. These run without hardware and
+    measure the agent software stack (SwSwitch, SaiSwitch, SAI store), so
+    they can be used to catch software regressions in CI and on dev servers.
+    """
+    for sai_impl in get_all_npu_impls():
+        if sai_impl.name != "fake":
+            continue
+        _fake_sai_agent_benchmark_binary(name, srcs, sai_impl, **kwargs)
+
 def sai_multi_switch_agent_benchmark(name, srcs, **kwargs):
     _multi_switch_agent_benchmark_binary(name, srcs, **kwargs)
@@ -241,6 +241,20 @@ class SaiObject {
     live_ = true;
   }
 
+  // Adopt an object already created in the SAI adapter, e.g. by a bulk
+  // create
+  struct AlreadyCreated {};
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes,
+      AlreadyCreated)
+      : adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {
+    live_ = true;
+  }
+
   bool live() const {
     return live_;
   }
@@ -274,6 +274,161 @@ class SaiObjectStore {
     }
   }
 
+  /*
+   * Create entry struct objects with a single bulk SAI call. Keys already
+   * known to the store (live or warm boot handles) go through setObject.
+   * If any entry fails to be created, the entries created by this call are
+   * removed again and the first failure is thrown, leaving hardware as it
+   * was. Adapters without bulk support fall back to per object create.
+   */
+  std::vector<std::shared_ptr<ObjectType>> bulkCreateObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value &&
+            std::is_same_v<
+                typename SaiObjectTraits::AdapterHostKey,
+                typename SaiObjectTraits::AdapterKey>,
+        "bulk create available only for entry struct objects");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value &&
+            !SaiObjectHasStats<SaiObjectTraits>::value,
+        "bulk create not available for publisher or stats objects");
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    std::vector<size_t> newIndices;
+    std::vector<typename SaiObjectTraits::AdapterKey> newKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> newAttributes;
+    for (auto idx = 0; idx < adapterHostKeys.size(); ++idx) {
+      const auto& adapterHostKey = adapterHostKeys[idx];
+      if (objects_.ref(adapterHostKey) ||
+          warmBootHandles_.find(adapterHostKey) != warmBootHandles_.end()) {
+        objects[idx] = setObject(adapterHostKey, attributes[idx]);
+        continue;
+      }
+      newIndices.push_back(idx);
+      newKeys.push_back(adapterHostKey);
+      newAttributes.push_back(attributes[idx]);
+    }
+    if (newKeys.empty()) {
+      return objects;
+    }
+    XLOGF(
+        DBG5,
+        "SaiStore bulk creating {} {} objects",
+        newKeys.size(),
+        objectTypeName());
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    std::vector<sai_status_t> statuses;
+    try {
+      statuses =
+          api.template bulkCreate<SaiObjectTraits>(newKeys, newAttributes);
+    } catch (const SaiApiError& e) {
+      if (e.getSaiStatus() != SAI_STATUS_NOT_SUPPORTED &&
+          e.getSaiStatus() != SAI_STATUS_NOT_IMPLEMENTED) {
+        throw;
+      }
+      for (auto i = 0; i < newIndices.size(); ++i) {
+        objects[newIndices[i]] = setObject(newKeys[i], newAttributes[i]);
+      }
+      return objects;
+    }
+    std::vector<typename SaiObjectTraits::AdapterKey> created;
+    std::optional<sai_status_t> failure;
+    for (auto i = 0; i < statuses.size(); ++i) {
+      if (statuses[i] == SAI_STATUS_SUCCESS) {
+        created.push_back(newKeys[i]);
+      } else if (!failure) {
+        failure = statuses[i];
+      }
+    }
+    if (failure) {
+      api.bulkRemove(created);
+      throw SaiApiError(
+          failure.value(),
+          api.apiType(),
+          "Failed to bulk create ",
+          newKeys.size(),
+          " ",
+          objectTypeName(),
+          " objects");
+    }
+    for (auto i = 0; i < newIndices.size(); ++i) {
+      objects[newIndices[i]] =
+          objects_
+              .refOrInsert(
+                  newKeys[i],
+                  ObjectType(
+                      newKeys[i],
+                      newKeys[i],
+                      newAttributes[i],
+                      typename ObjectType::AlreadyCreated{}),
+                  true /*force*/)
+              .first;
+    }
+    return objects;
+  }
+
+  /*
+   * Release objects with a single bulk SAI call. Only objects not
+   * referenced elsewhere are removed from hardware; the rest are simply
+   * dereferenced, as if the handles had been reset.
+   */
+  void bulkRemoveObjects(std::vector<std::shared_ptr<ObjectType>> objects) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk remove available only for entry struct objects");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk remove not available for publisher objects");
+    std::vector<std::shared_ptr<ObjectType>> toRemove;
+    std::vector<typename SaiObjectTraits::AdapterKey> keys;
+    for (auto& object : objects) {
+      if (object && object.use_count() == 1 && object->live()) {
+        keys.push_back(object->adapterKey());
+        toRemove.push_back(std::move(object));
+      }
+    }
+    objects.clear();
+    if (keys.empty()) {
+      return;
+    }
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    std::vector<sai_status_t> statuses;
+    try {
+      statuses = api.bulkRemove(keys);
+    } catch (const SaiApiError& e) {
+      if (e.getSaiStatus() != SAI_STATUS_NOT_SUPPORTED &&
+          e.getSaiStatus() != SAI_STATUS_NOT_IMPLEMENTED) {
+        throw;
+      }
+      // objects are removed one at a time by their destructors
+      return;
+    }
+    std::optional<sai_status_t> failure;
+    for (auto i = 0; i < statuses.size(); ++i) {
+      if (statuses[i] == SAI_STATUS_SUCCESS) {
+        toRemove[i]->release();
+      } else if (!failure) {
+        failure = statuses[i];
+      }
+    }
+    if (failure) {
+      // objects which failed to be removed are retried, one at a time, by
+      // their destructors, which surface the error as usual
+      XLOGF(
+          WARNING,
+          "Bulk remove of {} {} objects failed: {}",
+          keys.size(),
+          objectTypeName(),
+          saiStatusToString(failure.value()));
+    }
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
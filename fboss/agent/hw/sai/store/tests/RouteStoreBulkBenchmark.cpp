@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kNumRoutes = 10000;
+// Same chunk size as SaiRouteManager uses for bulk route ops
+constexpr auto kBulkChunkSize = 1024;
+
+using SaiRoute = SaiObject<SaiRouteTraits>;
+
+std::vector<SaiRouteTraits::RouteEntry> routeEntries() {
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  for (uint32_t i = 0; i < kNumRoutes; ++i) {
+    auto ip = folly::IPAddressV4::fromLongHBO(0x0a000000 + (i << 8));
+    entries.emplace_back(0, 0, folly::CIDRNetwork(ip, 24));
+  }
+  return entries;
+}
+
+void createAndRemoveRoutes(bool bulk) {
+  folly::BenchmarkSuspender suspender;
+  auto fs = FakeSai::getInstance();
+  auto saiApiTable = SaiApiTable::getInstance();
+  saiApiTable->queryApis(nullptr, saiApiTable->getFullApiList());
+  SaiStore saiStore(0);
+  auto& store = saiStore.get<SaiRouteTraits>();
+  auto entries = routeEntries();
+  std::vector<SaiRouteTraits::CreateAttributes> attributes(
+      entries.size(),
+      SaiRouteTraits::CreateAttributes{
+          SAI_PACKET_ACTION_FORWARD,
+          5,
+          std::nullopt,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+          std::nullopt
+#endif
+      });
+  std::vector<std::shared_ptr<SaiRoute>> routes;
+  routes.reserve(entries.size());
+  suspender.dismiss();
+
+  if (!bulk) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+      routes.push_back(store.setObject(entries[i], attributes[i]));
+    }
+    routes.clear();
+    return;
+  }
+
+  for (size_t start = 0; start < entries.size(); start += kBulkChunkSize) {
+    auto end = std::min(start + kBulkChunkSize, entries.size());
+    std::vector<SaiRouteTraits::RouteEntry> chunkEntries(
+        entries.begin() + start, entries.begin() + end);
+    std::vector<SaiRouteTraits::CreateAttributes> chunkAttributes(
+        attributes.begin() + start, attributes.begin() + end);
+    auto chunk = store.bulkCreateObjects(chunkEntries, chunkAttributes);
+    std::move(chunk.begin(), chunk.end(), std::back_inserter(routes));
+  }
+  for (size_t start = 0; start < routes.size(); start += kBulkChunkSize) {
+    auto end = std::min(start + kBulkChunkSize, routes.size());
+    std::vector<std::shared_ptr<SaiRoute>> chunk(
+        std::make_move_iterator(routes.begin() + start),
+        std::make_move_iterator(routes.begin() + end));
+    store.bulkRemoveObjects(std::move(chunk));
+  }
+}
+} // namespace
+
+BENCHMARK(RouteStoreCreateRemove) {
+  createAndRemoveRoutes(false /* bulk */);
+}
+
+BENCHMARK_RELATIVE(RouteStoreBulkCreateRemove) {
+  createAndRemoveRoutes(true /* bulk */);
+}
+
+int main(int argc, char* argv[]) {
+  folly::Init init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -243,3 +243,112 @@ TEST_F(SaiStoreTest, toStrV6Route) {
 
   verifyToStr<SaiRouteTraits>();
 }
+
+namespace {
+SaiRouteTraits::RouteEntry bulkRouteEntry(const std::string& ip) {
+  return SaiRouteTraits::RouteEntry(
+      0, 0, folly::CIDRNetwork(folly::IPAddress(ip), 24));
+}
+
+SaiRouteTraits::CreateAttributes bulkRouteAttributes(
+    sai_object_id_t nextHopId) {
+  return SaiRouteTraits::CreateAttributes{
+      SAI_PACKET_ACTION_FORWARD,
+      nextHopId,
+      42,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+      std::nullopt
+#endif
+  };
+}
+} // namespace
+
+TEST_F(SaiStoreTest, bulkCreateRoutes) {
+  saiStore->setSwitchId(0);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto numRoutes = fs->routeManager.map().size();
+  std::vector<SaiRouteTraits::RouteEntry> entries{
+      bulkRouteEntry("20.0.10.0"),
+      bulkRouteEntry("20.0.11.0"),
+      bulkRouteEntry("20.0.12.0")};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes{
+      bulkRouteAttributes(5), bulkRouteAttributes(6), bulkRouteAttributes(7)};
+
+  auto routes = store.bulkCreateObjects(entries, attributes);
+  ASSERT_EQ(routes.size(), entries.size());
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EXPECT_EQ(routes[i]->adapterKey(), entries[i]);
+    EXPECT_EQ(store.get(entries[i]), routes[i]);
+    EXPECT_EQ(
+        GET_OPT_ATTR(Route, NextHopId, routes[i]->attributes()), 5 + i);
+    EXPECT_EQ(
+        saiApiTable->routeApi().getAttribute(
+            entries[i], SaiRouteTraits::Attributes::NextHopId{}),
+        5 + i);
+  }
+}
+
+TEST_F(SaiStoreTest, bulkCreateExistingRoute) {
+  saiStore->setSwitchId(0);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto numRoutes = fs->routeManager.map().size();
+  auto existingEntry = bulkRouteEntry("20.1.10.0");
+  auto existing = store.setObject(existingEntry, bulkRouteAttributes(5));
+
+  // Routes the store already knows about are updated in place
+  auto routes = store.bulkCreateObjects(
+      {existingEntry, bulkRouteEntry("20.1.11.0")},
+      {bulkRouteAttributes(6), bulkRouteAttributes(7)});
+  ASSERT_EQ(routes.size(), 2);
+  EXPECT_EQ(routes[0], existing);
+  EXPECT_EQ(GET_OPT_ATTR(Route, NextHopId, existing->attributes()), 6);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+}
+
+TEST_F(SaiStoreTest, bulkCreateRoutesFailure) {
+  saiStore->setSwitchId(0);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto numRoutes = fs->routeManager.map().size();
+  // Created behind the store's back, so that creating it again fails
+  auto conflicting = bulkRouteEntry("20.2.11.0");
+  saiApiTable->routeApi().create<SaiRouteTraits>(
+      conflicting, bulkRouteAttributes(5));
+
+  std::vector<SaiRouteTraits::RouteEntry> entries{
+      bulkRouteEntry("20.2.10.0"), conflicting, bulkRouteEntry("20.2.12.0")};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes(
+      entries.size(), bulkRouteAttributes(6));
+  EXPECT_THROW(store.bulkCreateObjects(entries, attributes), SaiApiError);
+
+  // Routes created by the failed call are removed again
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+  for (const auto& entry : entries) {
+    EXPECT_EQ(store.get(entry), nullptr);
+  }
+  saiApiTable->routeApi().remove(conflicting);
+}
+
+TEST_F(SaiStoreTest, bulkRemoveRoutes) {
+  saiStore->setSwitchId(0);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto numRoutes = fs->routeManager.map().size();
+  std::vector<SaiRouteTraits::RouteEntry> entries{
+      bulkRouteEntry("20.3.10.0"),
+      bulkRouteEntry("20.3.11.0"),
+      bulkRouteEntry("20.3.12.0")};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes(
+      entries.size(), bulkRouteAttributes(5));
+  auto routes = store.bulkCreateObjects(entries, attributes);
+  // Still referenced elsewhere, so only dereferenced by the bulk remove
+  auto stillUsed = routes[2];
+
+  store.bulkRemoveObjects(std::move(routes));
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+  EXPECT_EQ(store.get(entries[0]), nullptr);
+  EXPECT_EQ(store.get(entries[1]), nullptr);
+  EXPECT_EQ(store.get(entries[2]), stillUsed);
+
+  stillUsed.reset();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+}
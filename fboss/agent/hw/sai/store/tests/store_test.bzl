@@ -1,3 +1,4 @@
+load("@fbcode_macros//build_defs:cpp_benchmark.bzl", "cpp_benchmark")
 load("@fbcode_macros//build_defs:cpp_unittest.bzl", "cpp_unittest")
 load("//fboss/agent/hw/sai/impl:impl.bzl", "SAI_FAKE_IMPLS", "to_impl_lib_name", "to_impl_suffix")
 
@@ -17,3 +18,18 @@ def store_unittest(name, srcs, supports_static_listing = True, deps = []):
                 "//fboss/agent/hw/sai/impl:{}".format(to_impl_lib_name(sai_impl)),
             ] + deps,
         )
+
+def store_benchmark(name, srcs, deps = []):
+    for sai_impl in SAI_FAKE_IMPLS:
+        impl_suffix = to_impl_suffix(sai_impl)
+        cpp_benchmark(
+            name = "{}-{}".format(name, sai_impl.name),
+            srcs = srcs,
+            args = ["--json"],
+            deps = [
+                "//fboss/agent/hw/sai/store:sai_store{}".format(impl_suffix),
+                "//fboss/agent/hw/sai/impl:{}".format(to_impl_lib_name(sai_impl)),
+                "//folly:benchmark",
+                "//folly/init:init",
+            ] + deps,
+        )
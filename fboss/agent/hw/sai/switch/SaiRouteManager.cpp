@@ -22,6 +22,9 @@
 
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <folly/ScopeGuard.h>
+
+#include <algorithm>
 #include <optional>
 
 DEFINE_bool(
@@ -29,6 +32,17 @@ DEFINE_bool(
     false,
     "Disable valid route check when creating or changing routes in SAI switches");
 
+DEFINE_bool(
+    enable_sai_bulk_route_ops,
+    false,
+    "Program routes added or removed by a state delta using SAI bulk route "
+    "create/remove calls");
+
+namespace {
+// Maximum number of routes programmed by a single bulk SAI call
+constexpr size_t kBulkRouteChunkSize = 1024;
+} // namespace
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -151,11 +165,13 @@ bool SaiRouteManager::validRoute(const std::shared_ptr<Route<AddrT>>& swRoute) {
 }
 
 template <typename AddrT>
-void SaiRouteManager::addOrUpdateRoute(
+std::optional<SaiRouteTraits::CreateAttributes>
+SaiRouteManager::addOrUpdateRoute(
     SaiRouteHandle* routeHandle,
     RouterID routerId,
     const std::shared_ptr<Route<AddrT>>& oldRoute,
-    const std::shared_ptr<Route<AddrT>>& newRoute) {
+    const std::shared_ptr<Route<AddrT>>& newRoute,
+    bool deferCreate) {
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, newRoute);
   const auto& fwd = newRoute->getForwardInfo();
   sai_int32_t packetAction;
@@ -410,11 +426,17 @@ void SaiRouteManager::addOrUpdateRoute(
 
     XLOG(DBG3) << "Route action DROP: " << newRoute->str();
   }
+  if (deferCreate) {
+    routeHandle->nexthopHandle_ = nextHopHandle;
+    routeHandle->counterHandle_ = counterHandle;
+    return attributes;
+  }
   auto& store = saiStore_->get<SaiRouteTraits>();
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
   routeHandle->nexthopHandle_ = nextHopHandle;
   routeHandle->counterHandle_ = counterHandle;
+  return std::nullopt;
 }
 
 template <typename AddrT>
@@ -456,8 +478,17 @@ void SaiRouteManager::addRoute(
     return;
   }
   auto routeHandle = std::make_unique<SaiRouteHandle>();
-  addOrUpdateRoute(
-      routeHandle.get(), routerId, std::shared_ptr<Route<AddrT>>{}, swRoute);
+  auto attributes = addOrUpdateRoute(
+      routeHandle.get(),
+      routerId,
+      std::shared_ptr<Route<AddrT>>{},
+      swRoute,
+      FLAGS_enable_sai_bulk_route_ops);
+  if (attributes) {
+    pendingAdds_.push_back(
+        {entry, std::move(routeHandle), std::move(attributes.value())});
+    return;
+  }
   handles_.emplace(entry, std::move(routeHandle));
 }
 
@@ -471,11 +502,15 @@ void SaiRouteManager::removeRoute(
   }
   XLOG(DBG3) << "Remove route: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (FLAGS_enable_sai_bulk_route_ops) {
+    pendingRemovals_.push_back(std::move(itr->second));
+  }
+  handles_.erase(itr);
 }
 
 template <typename AddrT>
@@ -510,9 +545,72 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingAdds_.clear();
+  pendingRemovals_.clear();
   handles_.clear();
 }
 
+void SaiRouteManager::flushPendingRouteRemovals() {
+  auto pendingRemovals = std::move(pendingRemovals_);
+  pendingRemovals_.clear();
+  for (size_t start = 0; start < pendingRemovals.size();
+       start += kBulkRouteChunkSize) {
+    auto end = std::min(start + kBulkRouteChunkSize, pendingRemovals.size());
+    std::vector<std::shared_ptr<SaiRoute>> routes;
+    routes.reserve(end - start);
+    for (auto idx = start; idx < end; ++idx) {
+      routes.push_back(std::move(pendingRemovals[idx]->route));
+    }
+    // Routes go first, so that next hops and next hop groups they point to
+    // are released only once nothing refers to them anymore
+    saiStore_->get<SaiRouteTraits>().bulkRemoveObjects(std::move(routes));
+    for (auto idx = start; idx < end; ++idx) {
+      pendingRemovals[idx].reset();
+    }
+  }
+}
+
+void SaiRouteManager::flushPendingRouteAdds() {
+  // If creating a chunk fails, the routes queued after it are dropped along
+  // with their next hop references rather than created by a later flush.
+  SCOPE_EXIT {
+    pendingAdds_.clear();
+  };
+  auto& store = saiStore_->get<SaiRouteTraits>();
+  for (size_t start = 0; start < pendingAdds_.size();
+       start += kBulkRouteChunkSize) {
+    auto end = std::min(start + kBulkRouteChunkSize, pendingAdds_.size());
+    std::vector<SaiRouteTraits::RouteEntry> entries;
+    std::vector<SaiRouteTraits::CreateAttributes> attributes;
+    entries.reserve(end - start);
+    attributes.reserve(end - start);
+    for (auto idx = start; idx < end; ++idx) {
+      auto& pendingAdd = pendingAdds_[idx];
+      // A single next hop route points to the CPU until its next hop is
+      // resolved. Pick up the next hop as it is now, in case it got
+      // resolved or unresolved after the route was queued.
+      std::visit(
+          [&pendingAdd](const auto& nextHopHandle) {
+            using HandleT = std::decay_t<decltype(nextHopHandle)>;
+            if constexpr (!std::is_same_v<
+                              HandleT,
+                              std::shared_ptr<SaiNextHopGroupHandle>>) {
+              nextHopHandle->updateCreateAttributes(pendingAdd.attributes);
+            }
+          },
+          pendingAdd.handle->nexthopHandle_);
+      entries.push_back(pendingAdd.entry);
+      attributes.push_back(pendingAdd.attributes);
+    }
+    auto routes = store.bulkCreateObjects(entries, attributes);
+    for (auto idx = start; idx < end; ++idx) {
+      auto& pendingAdd = pendingAdds_[idx];
+      pendingAdd.handle->route = std::move(routes[idx - start]);
+      handles_.emplace(pendingAdd.entry, std::move(pendingAdd.handle));
+    }
+  }
+}
+
 std::shared_ptr<SaiObject<SaiRouteTraits>> SaiRouteManager::getRouteObject(
     SaiRouteTraits::AdapterHostKey routeKey) {
   return saiStore_->get<SaiRouteTraits>().get(routeKey);
@@ -646,6 +744,14 @@ void ManagedRouteNextHop<NextHopTraitsT>::beforeRemove() {
              << routeKey_.toString();
 
   auto route = routeManager_->getRouteObject(routeKey_);
+  if (!route) {
+    // Route creation is still queued, it picks the CPU port up from
+    // updateCreateAttributes once the next hop is gone
+    XLOG(DBG2) << "ManagedRouteNextHop beforeRemove, route not yet created: "
+               << routeKey_.toString();
+    this->setPublisherObject(nullptr);
+    return;
+  }
   auto& api = SaiApiTable::getInstance()->routeApi();
   SaiRouteTraits::Attributes::Metadata currentMetadata = routeMetadataSupported_
       ? api.getAttribute(
@@ -681,7 +787,10 @@ void ManagedRouteNextHop<NextHopTraitsT>::updateMetadata(
     return;
   }
   auto route = routeManager_->getRouteObject(routeKey_);
-  CHECK(route);
+  if (!route) {
+    // Queued for creation, its create attributes carry the metadata
+    return;
+  }
 
   auto expectedMetadata =
       std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(
@@ -727,6 +836,22 @@ void ManagedRouteNextHop<NextHopTraitsT>::setMetadata(
   metadata_ = metadata;
 }
 
+template <typename NextHopTraitsT>
+void ManagedRouteNextHop<NextHopTraitsT>::updateCreateAttributes(
+    SaiRouteTraits::CreateAttributes& attributes) const {
+  std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(attributes) =
+      adapterKey();
+  if (routeMetadataSupported_) {
+    // Same class id as afterCreate and beforeRemove would have set, had the
+    // route existed when the next hop changed
+    std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(attributes) =
+        this->isReady()
+        ? metadata_
+        : SaiRouteTraits::Attributes::Metadata{static_cast<uint32_t>(
+              cfg::AclLookupClass::DST_CLASS_L3_LOCAL_2)};
+  }
+}
+
 template class ManagedRouteNextHop<SaiIpNextHopTraits>;
 template class ManagedRouteNextHop<SaiMplsNextHopTraits>;
 
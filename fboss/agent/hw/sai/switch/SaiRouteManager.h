@@ -25,6 +25,7 @@
 
 DECLARE_bool(disable_valid_route_check);
 DECLARE_bool(classid_for_unresolved_routes);
+DECLARE_bool(enable_sai_bulk_route_ops);
 
 namespace facebook::fboss {
 
@@ -61,6 +62,10 @@ class ManagedRouteNextHop
   std::optional<SaiRouteTraits::Attributes::Metadata> getMetadata() const;
   void setMetadata(
       std::optional<SaiRouteTraits::Attributes::Metadata> metadata);
+  // Point attributes of a route that is yet to be created at the next hop as
+  // it is now, along with the matching class id
+  void updateCreateAttributes(
+      SaiRouteTraits::CreateAttributes& attributes) const;
 
  private:
   void updateMetadata(
@@ -132,18 +137,36 @@ class SaiRouteManager {
 
   void clear();
 
+  /*
+   * With FLAGS_enable_sai_bulk_route_ops, routes added and removed while
+   * processing a delta are queued and programmed with SAI bulk route calls
+   * when flushed. Queued routes are not visible through getRouteHandle
+   * until their addition is flushed.
+   */
+  void flushPendingRouteRemovals();
+  void flushPendingRouteAdds();
+
   std::shared_ptr<SaiObject<SaiRouteTraits>> getRouteObject(
       SaiRouteTraits::AdapterHostKey routeKey);
 
  private:
+  struct PendingRouteAdd {
+    SaiRouteTraits::RouteEntry entry;
+    std::unique_ptr<SaiRouteHandle> handle;
+    SaiRouteTraits::CreateAttributes attributes;
+  };
+
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
+  // Returns the create attributes of the route, instead of creating it, if
+  // deferCreate is set
   template <typename AddrT>
-  void addOrUpdateRoute(
+  std::optional<SaiRouteTraits::CreateAttributes> addOrUpdateRoute(
       SaiRouteHandle* routeHandle,
       RouterID routerId,
       const std::shared_ptr<Route<AddrT>>& oldRoute,
-      const std::shared_ptr<Route<AddrT>>& newRoute);
+      const std::shared_ptr<Route<AddrT>>& newRoute,
+      bool deferCreate = false);
 
   template <typename AddrT>
   bool validRoute(const std::shared_ptr<Route<AddrT>>& swRoute);
@@ -169,6 +192,8 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  std::vector<PendingRouteAdd> pendingAdds_;
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRemovals_;
 };
 
 } // namespace facebook::fboss
@@ -58,6 +58,7 @@
 #include "fboss/agent/packet/PktUtil.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "fboss/lib/HwWriteBehavior.h"
+#include "fboss/lib/StageTracer.h"
 
 #include "fboss/agent/AsicUtils.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
@@ -77,6 +78,7 @@
 #include "fboss/lib/phy/PhyUtils.h"
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 
+#include <folly/Demangle.h>
 #include <folly/logging/xlog.h>
 
 #include <boost/range/combine.hpp>
@@ -117,6 +119,12 @@ DEFINE_bool(
     false,
     "force recreate acl tables during warmboot.");
 
+DEFINE_bool(
+    sai_per_api_lock,
+    false,
+    "Serialize SAI calls per SAI API instead of across all APIs. Only for "
+    "adaptors which are thread safe across APIs.");
+
 namespace {
 /*
  * For the devices/SDK we use, the only events we should get (and process)
@@ -631,6 +639,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
         &SaiRouteManager::removeRoute<folly::IPAddressV6>,
         routerID);
   }
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushPendingRouteRemovals();
+  }
 
   for (const auto& vlanDelta : delta.getVlansDelta()) {
     processRemovedDelta(
@@ -948,6 +960,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
     managerTable_->hostifManager().processHostifDelta(
         multiSwitchControlPlaneDelta);
   }
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushPendingRouteAdds();
+  }
 
   if (platform_->getAsic()->isSupported(HwAsic::Feature::SAI_MPLS_INSEGMENT)) {
     processDelta(
@@ -3484,6 +3500,23 @@ std::optional<L2Entry> SaiSwitch::getL2Entry(
       classID};
 }
 
+namespace {
+// Stage name used to trace time spent by a manager processing a delta,
+// e.g. "sai.delta.SaiRouteManagerImpl<folly::IPAddressV6>"
+template <typename Manager>
+folly::StringPiece managerDeltaStage() {
+  static const std::string stage = [] {
+    auto name = folly::demangle(typeid(Manager)).toStdString();
+    auto pos = name.rfind("fboss::", name.find('<'));
+    if (pos != std::string::npos) {
+      name = name.substr(pos + std::string("fboss::").size());
+    }
+    return "sai.delta." + name;
+  }();
+  return stage;
+}
+} // namespace
+
 template <
     typename Delta,
     typename Manager,
@@ -3500,6 +3533,7 @@ void SaiSwitch::processDelta(
     AddedFunc addedFunc,
     RemovedFunc removedFunc,
     Args... args) {
+  ScopedStageTimer timer(managerDeltaStage<Manager>());
   DeltaFunctions::forEachChanged(
       delta,
       [&](auto removed, auto added) {
@@ -3528,6 +3562,7 @@ void SaiSwitch::processChangedDelta(
     const LockPolicyT& lockPolicy,
     ChangeFunc changedFunc,
     Args... args) {
+  ScopedStageTimer timer(managerDeltaStage<Manager>());
   DeltaFunctions::forEachChanged(delta, [&](auto added, auto removed) {
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
     (manager.*changedFunc)(added, removed, args...);
@@ -3546,6 +3581,7 @@ void SaiSwitch::processAddedDelta(
     const LockPolicyT& lockPolicy,
     AddedFunc addedFunc,
     Args... args) {
+  ScopedStageTimer timer(managerDeltaStage<Manager>());
   DeltaFunctions::forEachAdded(delta, [&](auto added) {
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
     (manager.*addedFunc)(added, args...);
@@ -3564,6 +3600,7 @@ void SaiSwitch::processRemovedDelta(
     const LockPolicyT& lockPolicy,
     RemovedFunc removedFunc,
     Args... args) {
+  ScopedStageTimer timer(managerDeltaStage<Manager>());
   DeltaFunctions::forEachRemoved(delta, [&](auto removed) {
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
     (manager.*removedFunc)(removed, args...);
@@ -155,8 +155,10 @@ def _sai_switch_lib(sai_impl, is_npu):
             "//fboss/agent/hw/sai/store:sai_store{}".format(impl_suffix),
             "//fboss/agent/platforms/sai:sai_platform_h",
             "//fboss/lib:ref_map",
+            "//fboss/lib:stage_tracer",
             "//folly/concurrency:concurrent_hash_map",
             "//folly/container:f14_hash",
+            "//folly:scope_guard",
             "//thrift/lib/cpp/util:enum_utils",
             "//fboss/lib/phy:phy_utils",
             "//fboss/mka_service/if:mka_structs-cpp2-types",
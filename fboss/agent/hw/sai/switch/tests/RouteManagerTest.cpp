@@ -8,6 +8,7 @@
  *
  */
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
+#include "fboss/agent/hw/sai/switch/SaiNeighborManager.h"
 #include "fboss/agent/hw/sai/switch/SaiNextHopGroupManager.h"
 #include "fboss/agent/hw/sai/switch/SaiRouteManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitchManager.h"
@@ -16,6 +17,8 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
 
+#include <gflags/gflags.h>
+
 #include <optional>
 
 using namespace facebook::fboss;
@@ -357,6 +360,29 @@ TEST_F(RouteManagerTest, updateCpuRoutetoNextHopRoute) {
   EXPECT_FALSE(saiRouteHandle->nextHopGroupHandle());
 }
 
+TEST_F(RouteManagerTest, unresolveNextHopOfQueuedRoute) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_sai_bulk_route_ops = true;
+  auto intf = testInterfaces.at(1);
+  tr1.nextHopInterfaces = {intf};
+  auto r = makeRoute(tr1);
+  saiManagerTable->routeManager().addRoute<folly::IPAddressV4>(r, RouterID(0));
+  auto entry =
+      saiManagerTable->routeManager().routeEntryFromSwRoute(RouterID(0), r);
+  // Route creation is queued until the flush
+  EXPECT_FALSE(saiManagerTable->routeManager().getRouteHandle(entry));
+
+  saiManagerTable->neighborManager().removeNeighbor(
+      makeArpEntry(intf.id, intf.remoteHosts.at(0)));
+  saiManagerTable->routeManager().flushPendingRouteAdds();
+
+  auto saiRouteHandle = saiManagerTable->routeManager().getRouteHandle(entry);
+  ASSERT_TRUE(saiRouteHandle);
+  // sai_object_id_t of cpu port is 0 in FakeSai
+  EXPECT_EQ(
+      GET_OPT_ATTR(Route, NextHopId, saiRouteHandle->route->attributes()), 0);
+}
+
 /*
  * Test for ToMe routes doesn't want to do all the setup, because
  * setting up the router interfaces will result in creating ToMeRoutes
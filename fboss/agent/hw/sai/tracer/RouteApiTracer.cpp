@@ -78,6 +78,75 @@ sai_status_t wrap_get_route_entry_attribute(
       route_entry, attr_count, attr_list);
 }
 
+namespace {
+// Whether a bulk call reported on each of its entries, as opposed to
+// rejecting the call as a whole
+bool bulkStatusesSet(sai_status_t rv) {
+  return rv == SAI_STATUS_SUCCESS || rv == SAI_STATUS_FAILURE;
+}
+} // namespace
+
+/*
+ * Bulk route calls are logged as one create or remove per route, after the
+ * call returns with the status of each route. Routes which were not
+ * attempted are left out, so the trace replays the same routes with
+ * per-route calls.
+ */
+sai_status_t wrap_create_route_entries(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  if (!SaiTracer::getInstance()->routeApi_->create_route_entries) {
+    return SAI_STATUS_NOT_IMPLEMENTED;
+  }
+  auto begin = FLAGS_enable_elapsed_time_log
+      ? std::chrono::system_clock::now()
+      : std::chrono::system_clock::time_point::min();
+  auto rv = SaiTracer::getInstance()->routeApi_->create_route_entries(
+      object_count, route_entry, attr_count, attr_list, mode, object_statuses);
+  if (bulkStatusesSet(rv)) {
+    for (uint32_t idx = 0; idx < object_count; ++idx) {
+      if (object_statuses[idx] == SAI_STATUS_NOT_EXECUTED) {
+        continue;
+      }
+      SaiTracer::getInstance()->logRouteEntryCreateFn(
+          &route_entry[idx], attr_count[idx], attr_list[idx]);
+      SaiTracer::getInstance()->logPostInvocation(
+          object_statuses[idx], SAI_NULL_OBJECT_ID, begin);
+    }
+  }
+  return rv;
+}
+
+sai_status_t wrap_remove_route_entries(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  if (!SaiTracer::getInstance()->routeApi_->remove_route_entries) {
+    return SAI_STATUS_NOT_IMPLEMENTED;
+  }
+  auto begin = FLAGS_enable_elapsed_time_log
+      ? std::chrono::system_clock::now()
+      : std::chrono::system_clock::time_point::min();
+  auto rv = SaiTracer::getInstance()->routeApi_->remove_route_entries(
+      object_count, route_entry, mode, object_statuses);
+  if (bulkStatusesSet(rv)) {
+    for (uint32_t idx = 0; idx < object_count; ++idx) {
+      if (object_statuses[idx] == SAI_STATUS_NOT_EXECUTED) {
+        continue;
+      }
+      SaiTracer::getInstance()->logRouteEntryRemoveFn(&route_entry[idx]);
+      SaiTracer::getInstance()->logPostInvocation(
+          object_statuses[idx], SAI_NULL_OBJECT_ID, begin);
+    }
+  }
+  return rv;
+}
+
 sai_route_api_t* wrappedRouteApi() {
   static sai_route_api_t routeWrappers;
 
@@ -85,6 +154,8 @@ sai_route_api_t* wrappedRouteApi() {
   routeWrappers.remove_route_entry = &wrap_remove_route_entry;
   routeWrappers.set_route_entry_attribute = &wrap_set_route_entry_attribute;
   routeWrappers.get_route_entry_attribute = &wrap_get_route_entry_attribute;
+  routeWrappers.create_route_entries = &wrap_create_route_entries;
+  routeWrappers.remove_route_entries = &wrap_remove_route_entries;
 
   return &routeWrappers;
 }
@@ -0,0 +1,29 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+/*
+ * Turns a binary trace recorded with --enable_sai_binary_log back into the
+ * replay log, e.g.
+ *   sai_trace_decoder --sai_binary_log=sai_replayer.bin \
+ *       --sai_log=sai_replayer.log
+ */
+DECLARE_string(sai_binary_log);
+
+int main(int argc, char* argv[]) {
+  // Destroying Init tears down the tracer, which writes the replay footer
+  folly::Init init(&argc, &argv);
+  facebook::fboss::SaiTracer::decodeBinaryTrace(FLAGS_sai_binary_log);
+  return 0;
+}
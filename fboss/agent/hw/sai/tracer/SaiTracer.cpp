@@ -8,11 +8,14 @@
  *
  */
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include <ostream>
 #include <tuple>
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
 #include "fboss/agent/hw/sai/tracer/AclApiTracer.h"
@@ -54,6 +57,7 @@
 #include <folly/MapUtil.h>
 #include <folly/Singleton.h>
 #include <folly/String.h>
+#include <folly/logging/xlog.h>
 
 extern "C" {
 #include <sai.h>
@@ -113,6 +117,24 @@ DEFINE_bool(
     false,
     "Flag to indicate whether to log variable names or simply object ID");
 
+DEFINE_bool(
+    enable_sai_binary_log,
+    false,
+    "Record SAI calls as a compact binary trace in per-thread buffers instead "
+    "of formatting the replay log inline. Use sai_trace_decoder to turn the "
+    "trace into the replay log.");
+
+DEFINE_string(
+    sai_binary_log,
+    "/var/facebook/logs/fboss/sdk/sai_replayer.bin",
+    "File path to the SAI binary trace. It is rewritten on every start.");
+
+DEFINE_int32(
+    sai_binary_log_ring_size,
+    4 * 1024 * 1024,
+    "Per-thread buffer size in bytes for the SAI binary trace. Calls that do "
+    "not fit before the next flush are dropped rather than blocking.");
+
 using facebook::fboss::SaiTracer;
 using folly::to;
 using std::string;
@@ -470,21 +492,308 @@ folly::Singleton<facebook::fboss::SaiTracer> _saiTracer;
 
 namespace facebook::fboss {
 
+namespace {
+
+// Flags the binary trace has to be decoded with, stored in the trace header
+struct SaiBinaryTraceContext {
+  int32_t defaultListSize;
+  int32_t defaultListCount;
+  bool enableGetAttrLog;
+  bool logVariableName;
+};
+
+template <typename T>
+void appendValue(std::string& record, const T& value) {
+  record.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString(std::string& record, const std::string& str) {
+  appendValue<uint16_t>(record, str.size());
+  record.append(str);
+}
+
+class RecordCursor {
+ public:
+  explicit RecordCursor(const std::string& record) : record_(record) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    std::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* readBytes(size_t size) {
+    if (record_.size() - offset_ < size) {
+      throw FbossError("Truncated record in SAI binary trace");
+    }
+    auto data = record_.data() + offset_;
+    offset_ += size;
+    return data;
+  }
+
+  std::string readString() {
+    auto size = read<uint16_t>();
+    return std::string(readBytes(size), size);
+  }
+
+ private:
+  const std::string& record_;
+  size_t offset_{0};
+};
+
+std::string& recordBuffer() {
+  // Reused across calls so encoding a record does not allocate
+  thread_local std::string record;
+  record.clear();
+  return record;
+}
+
+std::size_t getAttributeTypeIndex(
+    sai_object_type_t object_type,
+    sai_attr_id_t attr_id) {
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_ACL_COUNTER:
+      return getAclCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_ENTRY:
+      return getAclEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE:
+      return getAclTableAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP:
+      return getAclTableGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER:
+      return getAclTableGroupMemberAttributeType(attr_id);
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    case SAI_OBJECT_TYPE_ARS:
+      return getArsAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ARS_PROFILE:
+      return getArsProfileAttributeType(attr_id);
+#endif
+    case SAI_OBJECT_TYPE_BRIDGE:
+      return getBridgeAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BRIDGE_PORT:
+      return getBridgePortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BUFFER_POOL:
+      return getBufferPoolAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BUFFER_PROFILE:
+      return getBufferProfileAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_COUNTER:
+      return getCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_DEBUG_COUNTER:
+      return getDebugCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return getFdbEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HASH:
+      return getHashAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_PACKET:
+      return getHostifPacketAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP:
+      return getHostifTrapAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_USER_DEFINED_TRAP:
+      return getHostifUserDefinedTrapAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP:
+      return getHostifTrapGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return getInsegEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+      return getIngressPriorityGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_LAG:
+      return getLagAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_LAG_MEMBER:
+      return getLagMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC:
+      return getMacsecAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_PORT:
+      return getMacsecPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_FLOW:
+      return getMacsecFlowAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_SA:
+      return getMacsecSAAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_SC:
+      return getMacsecSCAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MIRROR_SESSION:
+      return getMirrorSessionAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return getNeighborEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP:
+      return getNextHopAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+      return getNextHopGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+      return getNextHopGroupMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT:
+      return getPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT_SERDES:
+      return getPortSerdesAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT_CONNECTOR:
+      return getPortConnectorAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_QOS_MAP:
+      return getQosMapAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_QUEUE:
+      return getQueueAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return getRouteEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
+      return getRouterInterfaceAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SAMPLEPACKET:
+      return getSamplePacketAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SCHEDULER:
+      return getSchedulerAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SWITCH:
+      return getSwitchAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SYSTEM_PORT:
+      return getSystemPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM:
+      return getTamAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_EVENT:
+      return getTamEventAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_EVENT_ACTION:
+      return getTamEventActionAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_REPORT:
+      return getTamReportAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TUNNEL:
+      return getTunnelAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY:
+      return getTunnelTermAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_UDF:
+      return getUdfAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_UDF_MATCH:
+      return getUdfMatchAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_UDF_GROUP:
+      return getUdfGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VIRTUAL_ROUTER:
+      return getVirtualRouterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VLAN:
+      return getVlanAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VLAN_MEMBER:
+      return getVlanMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_WRED:
+      return getWredAttributeType(attr_id);
+    default:
+      return 0;
+  }
+}
+
+/*
+ * Invoke fn with the sai_*_list_t of a pointer carrying attribute. Mirrors the
+ * list handling in SET_SAI_ATTRIBUTES, which is what decides whether the
+ * replay log dereferences the list. Returns false for attributes whose value
+ * is fully contained in sai_attribute_value_t.
+ */
+template <typename Fn>
+bool visitListAttr(
+    sai_attribute_t& attr,
+    sai_object_type_t object_type,
+    Fn&& fn) {
+  auto typeIndex = getAttributeTypeIndex(object_type, attr.id);
+  if (typeIndex == TYPE_INDEX(std::vector<sai_object_id_t>)) {
+    fn(attr.value.objlist);
+  } else if (typeIndex == TYPE_INDEX(std::vector<sai_uint32_t>)) {
+    fn(attr.value.u32list);
+  } else if (typeIndex == TYPE_INDEX(std::vector<sai_int32_t>)) {
+    fn(attr.value.s32list);
+  } else if (typeIndex == TYPE_INDEX(std::vector<sai_qos_map_t>)) {
+    fn(attr.value.qosmap);
+  } else if (typeIndex == TYPE_INDEX(std::vector<sai_map_t>)) {
+    fn(attr.value.maplist);
+  } else if (typeIndex == TYPE_INDEX(AclEntryActionSaiObjectIdList)) {
+    fn(attr.value.aclaction.parameter.objlist);
+  } else if (
+      typeIndex == TYPE_INDEX(std::vector<sai_system_port_config_t>)) {
+    fn(attr.value.sysportconfiglist);
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 3) || defined(TAJO_SDK_VERSION_1_42_8)
+  } else if (
+      typeIndex == TYPE_INDEX(std::vector<sai_port_lane_latch_status_t>)) {
+    fn(attr.value.portlanelatchstatuslist);
+#endif
+#if SAI_API_VERSION >= SAI_VERSION(1, 13, 0)
+  } else if (
+      typeIndex ==
+      TYPE_INDEX(std::vector<sai_port_frequency_offset_ppm_values_t>)) {
+    fn(attr.value.portfrequencyoffsetppmlist);
+  } else if (typeIndex == TYPE_INDEX(std::vector<sai_port_snr_values_t>)) {
+    fn(attr.value.portsnrlist);
+#endif
+  } else if (
+      typeIndex == 0 &&
+      (attr.id == SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO ||
+       attr.id == SAI_SWITCH_ATTR_FIRMWARE_PATH_NAME)) {
+    fn(attr.value.s8list);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Storage for any of the entries of the entry based APIs
+union SaiEntry {
+  sai_route_entry_t route;
+  sai_neighbor_entry_t neighbor;
+  sai_fdb_entry_t fdb;
+  sai_inseg_entry_t inseg;
+};
+
+size_t entrySize(sai_object_type_t object_type) {
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return sizeof(sai_route_entry_t);
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return sizeof(sai_neighbor_entry_t);
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return sizeof(sai_fdb_entry_t);
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return sizeof(sai_inseg_entry_t);
+    default:
+      throw FbossError(
+          "Unsupported entry type ", object_type, " in SAI binary trace");
+  }
+}
+
+} // namespace
+
 SaiTracer::SaiTracer() {
   if (FLAGS_enable_replayer) {
-    asyncLogger_ = std::make_unique<AsyncLogger>(
-        FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
+    if (FLAGS_enable_sai_binary_log) {
+      SaiBinaryTraceContext context{
+          FLAGS_default_list_size,
+          FLAGS_default_list_count,
+          FLAGS_enable_get_attr_log,
+          FLAGS_log_variable_name};
+      binaryLogger_ = std::make_unique<BinaryTraceLogger>(
+          FLAGS_sai_binary_log,
+          FLAGS_log_timeout,
+          FLAGS_sai_binary_log_ring_size,
+          std::string(
+              reinterpret_cast<const char*>(&context), sizeof(context)));
+      binaryLogger_->startFlushThread();
+
+      // Header, globals and footer are generated by the decoder
+      maxAttrCount_ = FLAGS_default_list_size;
+      maxListCount_ = FLAGS_default_list_count;
+      numCalls_ = 0;
+    } else {
+      asyncLogger_ = std::make_unique<AsyncLogger>(
+          FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
 
-    asyncLogger_->startFlushThread();
-    asyncLogger_->appendLog(cpp_header_, strlen(cpp_header_));
+      asyncLogger_->startFlushThread();
+      asyncLogger_->appendLog(cpp_header_, strlen(cpp_header_));
 
-    setupGlobals();
+      setupGlobals();
+    }
     initVarCounts();
   }
 }
 
 SaiTracer::~SaiTracer() {
   if (FLAGS_enable_replayer) {
+    if (binaryLogger_) {
+      binaryLogger_->stopFlushThread();
+      if (binaryLogger_->getDroppedCount()) {
+        XLOG(WARN) << "SAI binary trace dropped "
+                   << binaryLogger_->getDroppedCount() << " records";
+      }
+      return;
+    }
     writeFooter();
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
@@ -508,6 +817,10 @@ void SaiTracer::writeToFile(const vector<string>& strVec, bool linefeed) {
   auto constexpr lineEnd = ";\n";
   auto lines = folly::join(lineEnd, strVec) + lineEnd + (linefeed ? "\n" : "");
 
+  if (binaryLogger_) {
+    appendBinaryRecord(BinaryRecordType::TEXT, lines);
+    return;
+  }
   asyncLogger_->appendLog(lines.c_str(), lines.size());
 }
 
@@ -613,26 +926,14 @@ void SaiTracer::logRouteEntryCreateFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // First fill in attribute list
-  vector<string> lines =
-      setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
-
-  // Then setup route entry (switch, virtual router and destination)
-  setRouteEntry(route_entry, lines);
-
-  // Make the function call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_ROUTE_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "create_route_entry(&r_e,",
+  logEntryFn(
+      EntryFn::CREATE,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      route_entry,
+      sizeof(*route_entry),
       attr_count,
-      ",s_a)"));
-
-  writeToFile(lines, /*linefeed*/ false);
+      attr_list,
+      SAI_STATUS_SUCCESS);
 }
 
 void SaiTracer::logNeighborEntryCreateFn(
@@ -643,32 +944,14 @@ void SaiTracer::logNeighborEntryCreateFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // First fill in attribute list
-  vector<string> lines =
-      setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
-
-  // Then setup neighbor entry (switch, router interface and ip address)
-  setNeighborEntry(neighbor_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make the function call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "create_neighbor_entry(&n_e,",
+  logEntryFn(
+      EntryFn::CREATE,
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      neighbor_entry,
+      sizeof(*neighbor_entry),
       attr_count,
-      ",s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+      attr_list,
+      rv);
 }
 
 void SaiTracer::logFdbEntryCreateFn(
@@ -679,32 +962,14 @@ void SaiTracer::logFdbEntryCreateFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // First fill in attribute list
-  vector<string> lines =
-      setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
-
-  // Then setup fdb entry (switch, router interface and ip address)
-  setFdbEntry(fdb_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make the function call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_FDB_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "create_fdb_entry(&f_e,",
+  logEntryFn(
+      EntryFn::CREATE,
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      fdb_entry,
+      sizeof(*fdb_entry),
       attr_count,
-      ",s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+      attr_list,
+      rv);
 }
 
 void SaiTracer::logInsegEntryCreateFn(
@@ -715,32 +980,14 @@ void SaiTracer::logInsegEntryCreateFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // First fill in attribute list
-  vector<string> lines =
-      setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
-
-  // Then setup inseg entry (switch and label)
-  setInsegEntry(inseg_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make the function call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_INSEG_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "create_inseg_entry(&i_e,",
+  logEntryFn(
+      EntryFn::CREATE,
+      SAI_OBJECT_TYPE_INSEG_ENTRY,
+      inseg_entry,
+      sizeof(*inseg_entry),
       attr_count,
-      ",s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+      attr_list,
+      rv);
 }
 
 std::string SaiTracer::logCreateFn(
@@ -754,20 +1001,23 @@ std::string SaiTracer::logCreateFn(
     return "";
   }
 
-  // First fill in attribute list
-  vector<string> lines = setAttrList(attr_list, attr_count, object_type);
-
-  // Then create new variable - declareVariable returns
-  // 1. Declaration of the new variable
-  // 2. name of the new variable
-  auto [declaration, varName] = declareVariable(create_object_id, object_type);
-  lines.push_back(declaration);
-
-  // Make the function call & write to file
-  lines.push_back(createFnCall(
-      fn_name, varName, getVariable(switch_id), attr_count, object_type));
+  auto varName = std::get<1>(declareVariable(create_object_id, object_type));
+
+  if (binaryLogger_) {
+    auto& record = recordBuffer();
+    appendValue<uint32_t>(record, object_type);
+    appendValue(record, switch_id);
+    appendString(record, fn_name);
+    appendString(record, varName);
+    encodeAttrList(record, attr_list, attr_count, object_type);
+    appendBinaryRecord(BinaryRecordType::CREATE, record);
+    return varName;
+  }
 
-  writeToFile(lines, /*linefeed*/ false);
+  writeToFile(
+      createFnLines(
+          fn_name, varName, switch_id, attr_count, attr_list, object_type),
+      /*linefeed*/ false);
   return varName;
 }
 
@@ -775,19 +1025,14 @@ void SaiTracer::logRouteEntryRemoveFn(const sai_route_entry_t* route_entry) {
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  vector<string> lines{};
-  setRouteEntry(route_entry, lines);
-
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_ROUTE_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "remove_route_entry(&r_e)"));
-
-  writeToFile(lines, /*linefeed*/ false);
+  logEntryFn(
+      EntryFn::REMOVE,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      route_entry,
+      sizeof(*route_entry),
+      0,
+      nullptr,
+      SAI_STATUS_SUCCESS);
 }
 
 void SaiTracer::logNeighborEntryRemoveFn(
@@ -796,25 +1041,14 @@ void SaiTracer::logNeighborEntryRemoveFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  vector<string> lines{};
-  setNeighborEntry(neighbor_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "remove_neighbor_entry(&n_e)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::REMOVE,
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      neighbor_entry,
+      sizeof(*neighbor_entry),
+      0,
+      nullptr,
+      rv);
 }
 
 void SaiTracer::logFdbEntryRemoveFn(
@@ -823,25 +1057,14 @@ void SaiTracer::logFdbEntryRemoveFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  vector<string> lines{};
-  setFdbEntry(fdb_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_FDB_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "remove_fdb_entry(&f_e)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::REMOVE,
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      fdb_entry,
+      sizeof(*fdb_entry),
+      0,
+      nullptr,
+      rv);
 }
 
 void SaiTracer::logInsegEntryRemoveFn(
@@ -850,25 +1073,14 @@ void SaiTracer::logInsegEntryRemoveFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  vector<string> lines{};
-  setInsegEntry(inseg_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_INSEG_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "remove_inseg_entry(&i_e)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::REMOVE,
+      SAI_OBJECT_TYPE_INSEG_ENTRY,
+      inseg_entry,
+      sizeof(*inseg_entry),
+      0,
+      nullptr,
+      rv);
 }
 
 void SaiTracer::logRemoveFn(
@@ -879,19 +1091,17 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
-  vector<string> lines{};
-
-  // Make the remove call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_, object_type, "Unsupported Sai Object type in Sai Tracer"),
-      fn_name,
-      "(",
-      getVariable(remove_object_id),
-      ")"));
-
-  writeToFile(lines, /*linefeed*/ false);
+  if (binaryLogger_) {
+    auto& record = recordBuffer();
+    appendValue<uint32_t>(record, object_type);
+    appendValue(record, remove_object_id);
+    appendString(record, fn_name);
+    appendBinaryRecord(BinaryRecordType::REMOVE, record);
+  } else {
+    writeToFile(
+        {removeFnCall(fn_name, remove_object_id, object_type)},
+        /*linefeed*/ false);
+  }
 
   // Remove object from variables_
   if (FLAGS_log_variable_name) {
@@ -905,22 +1115,14 @@ void SaiTracer::logRouteEntrySetAttrFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // Setup one attribute
-  vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
-
-  setRouteEntry(route_entry, lines);
-
-  // Make setAttribute call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_ROUTE_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "set_route_entry_attribute(&r_e, s_a)"));
-
-  writeToFile(lines, /*linefeed*/ false);
+  logEntryFn(
+      EntryFn::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_ROUTE_ENTRY,
+      route_entry,
+      sizeof(*route_entry),
+      1,
+      attr,
+      SAI_STATUS_SUCCESS);
 }
 
 void SaiTracer::logNeighborEntrySetAttrFn(
@@ -930,28 +1132,14 @@ void SaiTracer::logNeighborEntrySetAttrFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // Setup one attribute
-  vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
-
-  setNeighborEntry(neighbor_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make setAttribute call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "set_neighbor_entry_attribute(&n_e,s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+      neighbor_entry,
+      sizeof(*neighbor_entry),
+      1,
+      attr,
+      rv);
 }
 
 void SaiTracer::logFdbEntrySetAttrFn(
@@ -961,28 +1149,14 @@ void SaiTracer::logFdbEntrySetAttrFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // Setup one attribute
-  vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
-
-  setFdbEntry(fdb_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make setAttribute call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_FDB_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "set_fdb_entry_attribute(&f_e,s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_FDB_ENTRY,
+      fdb_entry,
+      sizeof(*fdb_entry),
+      1,
+      attr,
+      rv);
 }
 
 void SaiTracer::logInsegEntrySetAttrFn(
@@ -992,28 +1166,14 @@ void SaiTracer::logInsegEntrySetAttrFn(
   if (!FLAGS_enable_replayer) {
     return;
   }
-
-  // Setup one attribute
-  vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
-
-  setInsegEntry(inseg_entry, lines);
-
-  // Log timestamp and return value
-  lines.push_back(logTimeAndRv(rv));
-
-  // Make setAttribute call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_,
-          SAI_OBJECT_TYPE_INSEG_ENTRY,
-          "Unsupported Sai Object type in Sai Tracer"),
-      "set_inseg_entry_attribute(&i_e,s_a)"));
-
-  // Check return value to be the same as the original run
-  lines.push_back(rvCheck(rv));
-
-  writeToFile(lines);
+  logEntryFn(
+      EntryFn::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_INSEG_ENTRY,
+      inseg_entry,
+      sizeof(*inseg_entry),
+      1,
+      attr,
+      rv);
 }
 
 // Prior to GET calls, log the attributes used for GET.
@@ -1073,20 +1233,19 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
-  // Setup one attribute
-  vector<string> lines = setAttrList(attr, 1, object_type);
-
-  // Make setAttribute call
-  lines.push_back(to<string>(
-      "rv=",
-      folly::get_or_throw(
-          fnPrefix_, object_type, "Unsupported Sai Object type in Sai Tracer"),
-      fn_name,
-      "(",
-      getVariable(set_object_id),
-      ",s_a)"));
+  if (binaryLogger_) {
+    auto& record = recordBuffer();
+    appendValue<uint32_t>(record, object_type);
+    appendValue(record, set_object_id);
+    appendString(record, fn_name);
+    encodeAttrList(record, attr, 1, object_type);
+    appendBinaryRecord(BinaryRecordType::SET_ATTRIBUTE, record);
+    return;
+  }
 
-  writeToFile(lines, /*linefeed*/ false);
+  writeToFile(
+      setAttrFnLines(fn_name, set_object_id, attr, object_type),
+      /*linefeed*/ false);
 }
 
 void SaiTracer::logBulkSetAttrFn(
@@ -1533,6 +1692,382 @@ string SaiTracer::createFnCall(
       ",s_a)");
 }
 
+vector<string> SaiTracer::createFnLines(
+    const string& fn_name,
+    const string& varName,
+    sai_object_id_t switch_id,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list,
+    sai_object_type_t object_type) {
+  // First fill in attribute list
+  vector<string> lines = setAttrList(attr_list, attr_count, object_type);
+
+  // Then declare the new variable
+  lines.push_back(to<string>("sai_object_id_t ", varName));
+
+  // Make the function call
+  lines.push_back(createFnCall(
+      fn_name, varName, getVariable(switch_id), attr_count, object_type));
+  return lines;
+}
+
+string SaiTracer::removeFnCall(
+    const string& fn_name,
+    sai_object_id_t remove_object_id,
+    sai_object_type_t object_type) {
+  return to<string>(
+      "rv=",
+      folly::get_or_throw(
+          fnPrefix_, object_type, "Unsupported Sai Object type in Sai Tracer"),
+      fn_name,
+      "(",
+      getVariable(remove_object_id),
+      ")");
+}
+
+vector<string> SaiTracer::setAttrFnLines(
+    const string& fn_name,
+    sai_object_id_t set_object_id,
+    const sai_attribute_t* attr,
+    sai_object_type_t object_type) {
+  // Setup one attribute
+  vector<string> lines = setAttrList(attr, 1, object_type);
+
+  // Make setAttribute call
+  lines.push_back(to<string>(
+      "rv=",
+      folly::get_or_throw(
+          fnPrefix_, object_type, "Unsupported Sai Object type in Sai Tracer"),
+      fn_name,
+      "(",
+      getVariable(set_object_id),
+      ",s_a)"));
+  return lines;
+}
+
+void SaiTracer::logEntryFn(
+    EntryFn fn,
+    sai_object_type_t object_type,
+    const void* entry,
+    size_t entrySize,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list,
+    sai_status_t rv) {
+  // Route entry calls log their return value in logPostInvocation
+  bool logRv = object_type != SAI_OBJECT_TYPE_ROUTE_ENTRY;
+  uint32_t callNumber = logRv ? numCalls_++ : 0;
+
+  if (binaryLogger_) {
+    auto& record = recordBuffer();
+    appendValue(record, fn);
+    appendValue<uint32_t>(record, object_type);
+    record.append(static_cast<const char*>(entry), entrySize);
+    appendValue(record, rv);
+    appendValue(record, callNumber);
+    encodeAttrList(record, attr_list, attr_count, object_type);
+    appendBinaryRecord(BinaryRecordType::ENTRY, record);
+    return;
+  }
+
+  writeToFile(
+      entryFnLines(
+          fn,
+          object_type,
+          entry,
+          attr_count,
+          attr_list,
+          rv,
+          callNumber,
+          std::chrono::system_clock::now()),
+      /*linefeed*/ logRv);
+}
+
+vector<string> SaiTracer::entryFnLines(
+    EntryFn fn,
+    sai_object_type_t object_type,
+    const void* entry,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list,
+    sai_status_t rv,
+    uint32_t callNumber,
+    std::chrono::system_clock::time_point now) {
+  // First fill in attribute list
+  vector<string> lines;
+  if (fn != EntryFn::REMOVE) {
+    lines = setAttrList(attr_list, attr_count, object_type);
+  }
+
+  // Then setup the entry
+  string entryName, entryVar;
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      setRouteEntry(static_cast<const sai_route_entry_t*>(entry), lines);
+      entryName = "route_entry";
+      entryVar = "r_e";
+      break;
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      setNeighborEntry(static_cast<const sai_neighbor_entry_t*>(entry), lines);
+      entryName = "neighbor_entry";
+      entryVar = "n_e";
+      break;
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      setFdbEntry(static_cast<const sai_fdb_entry_t*>(entry), lines);
+      entryName = "fdb_entry";
+      entryVar = "f_e";
+      break;
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      setInsegEntry(static_cast<const sai_inseg_entry_t*>(entry), lines);
+      entryName = "inseg_entry";
+      entryVar = "i_e";
+      break;
+    default:
+      throw FbossError(
+          "Unsupported entry type ", object_type, " in Sai Tracer");
+  }
+
+  // Log timestamp and return value
+  bool logRv = object_type != SAI_OBJECT_TYPE_ROUTE_ENTRY;
+  if (logRv) {
+    lines.push_back(logTimeAndRv(
+        rv,
+        SAI_NULL_OBJECT_ID,
+        std::chrono::system_clock::time_point::min(),
+        now));
+  }
+
+  // Make the function call
+  string call;
+  switch (fn) {
+    case EntryFn::CREATE:
+      call = to<string>(
+          "create_", entryName, "(&", entryVar, ",", attr_count, ",s_a)");
+      break;
+    case EntryFn::REMOVE:
+      call = to<string>("remove_", entryName, "(&", entryVar, ")");
+      break;
+    case EntryFn::SET_ATTRIBUTE:
+      call = to<string>("set_", entryName, "_attribute(&", entryVar, ",s_a)");
+      break;
+  }
+  lines.push_back(to<string>(
+      "rv=",
+      folly::get_or_throw(
+          fnPrefix_, object_type, "Unsupported Sai Object type in Sai Tracer"),
+      call));
+
+  // Check return value to be the same as the original run
+  if (logRv) {
+    lines.push_back(rvCheck(rv, callNumber));
+  }
+  return lines;
+}
+
+void SaiTracer::appendBinaryRecord(
+    BinaryRecordType type,
+    const string& record) {
+  binaryLogger_->appendRecord(
+      static_cast<uint8_t>(type), record.data(), record.size());
+}
+
+void SaiTracer::encodeAttrList(
+    string& record,
+    const sai_attribute_t* attr_list,
+    uint32_t attr_count,
+    sai_object_type_t object_type) {
+  // Keep s_a and list_* reallocations in the trace so that the decoder does
+  // not have to replay text records it cannot interpret.
+  checkAttrCount(attr_count);
+
+  appendValue(record, attr_count);
+  uint32_t listCount = 0;
+  for (int i = 0; i < attr_count; ++i) {
+    auto attr = attr_list[i];
+    appendValue(record, attr);
+
+    // List attributes only hold a pointer, so copy out as many elements as
+    // the replay log would print.
+    auto listSizeOffset = record.size();
+    appendValue<uint32_t>(record, 0);
+    visitListAttr(attr, object_type, [&](const auto& list) {
+      using ElemType = std::remove_pointer_t<decltype(list.list)>;
+      auto listLimit =
+          checkListCount(++listCount, sizeof(ElemType), list.count);
+      if (list.list) {
+        uint32_t listSize = std::min(list.count, listLimit) * sizeof(ElemType);
+        record.append(reinterpret_cast<const char*>(list.list), listSize);
+        std::memcpy(&record[listSizeOffset], &listSize, sizeof(listSize));
+      }
+    });
+  }
+}
+
+void SaiTracer::decodeRecords(
+    const vector<BinaryTraceLogger::Record>& records) {
+  decoding_ = true;
+  uint64_t nextSequence = 0;
+  for (const auto& record : records) {
+    if (record.header.sequence != nextSequence) {
+      writeToFile({to<string>(
+          "// ",
+          record.header.sequence - nextSequence,
+          " records were dropped from the binary trace here")});
+    }
+    nextSequence = record.header.sequence + 1;
+
+    RecordCursor cursor(record.payload);
+    auto decodeAttrList = [&cursor](
+                              sai_object_type_t object_type,
+                              vector<std::unique_ptr<uint64_t[]>>& lists) {
+      vector<sai_attribute_t> attrs(cursor.read<uint32_t>());
+      for (auto& attr : attrs) {
+        attr = cursor.read<sai_attribute_t>();
+        auto listSize = cursor.read<uint32_t>();
+        auto listData = cursor.readBytes(listSize);
+        // Point list attributes at the copied elements (or nullptr when
+        // nothing was captured), never at the tracing process' memory.
+        visitListAttr(attr, object_type, [&](auto& list) {
+          using ElemType = std::remove_pointer_t<decltype(list.list)>;
+          list.list = nullptr;
+          if (listSize) {
+            lists.push_back(std::make_unique<uint64_t[]>(
+                (listSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+            std::memcpy(lists.back().get(), listData, listSize);
+            list.list = reinterpret_cast<ElemType*>(lists.back().get());
+          }
+        });
+      }
+      return attrs;
+    };
+
+    vector<std::unique_ptr<uint64_t[]>> lists;
+    switch (static_cast<BinaryRecordType>(record.header.type)) {
+      case BinaryRecordType::TEXT:
+        asyncLogger_->appendLog(record.payload.data(), record.payload.size());
+        break;
+      case BinaryRecordType::CREATE: {
+        auto objectType =
+            static_cast<sai_object_type_t>(cursor.read<uint32_t>());
+        auto switchId = cursor.read<sai_object_id_t>();
+        auto fnName = cursor.readString();
+        auto varName = cursor.readString();
+        auto attrs = decodeAttrList(objectType, lists);
+        writeToFile(
+            createFnLines(
+                fnName,
+                varName,
+                switchId,
+                attrs.size(),
+                attrs.data(),
+                objectType),
+            /*linefeed*/ false);
+        break;
+      }
+      case BinaryRecordType::REMOVE: {
+        auto objectType =
+            static_cast<sai_object_type_t>(cursor.read<uint32_t>());
+        auto objectId = cursor.read<sai_object_id_t>();
+        auto fnName = cursor.readString();
+        writeToFile(
+            {removeFnCall(fnName, objectId, objectType)}, /*linefeed*/ false);
+        if (FLAGS_log_variable_name) {
+          variables_.erase(objectId);
+        }
+        break;
+      }
+      case BinaryRecordType::SET_ATTRIBUTE: {
+        auto objectType =
+            static_cast<sai_object_type_t>(cursor.read<uint32_t>());
+        auto objectId = cursor.read<sai_object_id_t>();
+        auto fnName = cursor.readString();
+        auto attrs = decodeAttrList(objectType, lists);
+        writeToFile(
+            setAttrFnLines(fnName, objectId, attrs.data(), objectType),
+            /*linefeed*/ false);
+        break;
+      }
+      case BinaryRecordType::POST_INVOCATION: {
+        auto rv = cursor.read<sai_status_t>();
+        auto objectId = cursor.read<sai_object_id_t>();
+        auto callNumber = cursor.read<uint32_t>();
+        auto beginNs = cursor.read<int64_t>();
+        auto varName = cursor.readString();
+        if (!varName.empty() && FLAGS_log_variable_name) {
+          variables_.emplace(objectId, varName);
+        }
+        auto begin = beginNs == std::numeric_limits<int64_t>::min()
+            ? std::chrono::system_clock::time_point::min()
+            : std::chrono::system_clock::time_point(
+                  std::chrono::duration_cast<
+                      std::chrono::system_clock::duration>(
+                      std::chrono::nanoseconds(beginNs)));
+        auto now = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(record.header.timestampNs)));
+        writeToFile(
+            {logTimeAndRv(rv, objectId, begin, now),
+             rvCheck(rv, callNumber)});
+        break;
+      }
+      case BinaryRecordType::ENTRY: {
+        auto fn = cursor.read<EntryFn>();
+        auto objectType =
+            static_cast<sai_object_type_t>(cursor.read<uint32_t>());
+        SaiEntry entry;
+        std::memcpy(
+            &entry,
+            cursor.readBytes(entrySize(objectType)),
+            entrySize(objectType));
+        auto rv = cursor.read<sai_status_t>();
+        auto callNumber = cursor.read<uint32_t>();
+        auto attrs = decodeAttrList(objectType, lists);
+        auto now = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(record.header.timestampNs)));
+        writeToFile(
+            entryFnLines(
+                fn,
+                objectType,
+                &entry,
+                attrs.size(),
+                attrs.data(),
+                rv,
+                callNumber,
+                now),
+            /*linefeed*/ objectType != SAI_OBJECT_TYPE_ROUTE_ENTRY);
+        break;
+      }
+      default:
+        throw FbossError(
+            "Unknown record type ",
+            static_cast<int>(record.header.type),
+            " in SAI binary trace");
+    }
+  }
+  decoding_ = false;
+}
+
+void SaiTracer::decodeBinaryTrace(const string& binaryLog) {
+  string contextStr;
+  auto records = BinaryTraceLogger::readTrace(binaryLog, contextStr);
+  SaiBinaryTraceContext context;
+  if (contextStr.size() != sizeof(context)) {
+    throw FbossError(binaryLog, " is not a SAI binary trace");
+  }
+  std::memcpy(&context, contextStr.data(), sizeof(context));
+
+  // Generate the replay log exactly as the traced process would have
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_sai_binary_log = false;
+  FLAGS_default_list_size = context.defaultListSize;
+  FLAGS_default_list_count = context.defaultListCount;
+  FLAGS_enable_get_attr_log = context.enableGetAttrLog;
+  FLAGS_log_variable_name = context.logVariableName;
+
+  auto tracer = getInstance();
+  tracer->decodeRecords(records);
+  tracer->asyncLogger_->forceFlush();
+}
+
 void SaiTracer::setFdbEntry(
     const sai_fdb_entry_t* fdb_entry,
     std::vector<std::string>& lines) {
@@ -1639,14 +2174,18 @@ void SaiTracer::setRouteEntry(
 }
 
 string SaiTracer::rvCheck(sai_status_t rv) {
-  return to<string>("rvCheck(rv,", rv, ",", numCalls_++, ")");
+  return rvCheck(rv, numCalls_++);
+}
+
+string SaiTracer::rvCheck(sai_status_t rv, uint32_t callNumber) {
+  return to<string>("rvCheck(rv,", rv, ",", callNumber, ")");
 }
 
 string SaiTracer::logTimeAndRv(
     sai_status_t rv,
     sai_object_id_t object_id,
-    std::chrono::system_clock::time_point begin) {
-  auto now = std::chrono::system_clock::now();
+    std::chrono::system_clock::time_point begin,
+    std::chrono::system_clock::time_point now) {
   auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now.time_since_epoch()) %
       1000;
@@ -1682,7 +2221,7 @@ void SaiTracer::checkAttrCount(uint32_t attr_count) {
   // If any object has more than the current sai_attribute list has
   // (FLAGS_default_list_size by default), s_a will be reallocated to have
   // enough space for all attributes
-  if (attr_count > maxAttrCount_) {
+  if (attr_count > maxAttrCount_ && !decoding_) {
     maxAttrCount_ = attr_count;
     writeToFile({to<string>(
         "s_a = (sai_attribute_t*)realloc(s_a, ATTR_SIZE * ",
@@ -1697,7 +2236,7 @@ uint32_t SaiTracer::checkListCount(
     uint32_t elem_count) {
   // If any object uses more than the current number of lists (6 by default),
   // sai replayer will initialize more lists on stack
-  if (list_count > maxListCount_) {
+  if (list_count > maxListCount_ && !decoding_) {
     writeToFile({to<string>(
         "int list_", maxListCount_, "[", FLAGS_default_list_size, "]")});
     maxListCount_ = list_count;
@@ -1705,7 +2244,8 @@ uint32_t SaiTracer::checkListCount(
 
   // TODO(zecheng): Handle list size that's larger than
   // FLAGS_default_list_size * 4 bytes.
-  if (elem_size * elem_count > FLAGS_default_list_size * sizeof(int)) {
+  if (elem_size * elem_count > FLAGS_default_list_size * sizeof(int) &&
+      !decoding_) {
     writeToFile({to<string>(
         "printf(\"[ERROR] The replayed program is using",
         elem_size * elem_count,
@@ -1729,6 +2269,23 @@ void SaiTracer::logPostInvocation(
     variables_.emplace(object_id, *varName);
   }
 
+  if (binaryLogger_) {
+    auto& record = recordBuffer();
+    appendValue(record, rv);
+    appendValue(record, object_id);
+    appendValue<uint32_t>(record, numCalls_++);
+    appendValue<int64_t>(
+        record,
+        begin == std::chrono::system_clock::time_point::min()
+            ? std::numeric_limits<int64_t>::min()
+            : std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  begin.time_since_epoch())
+                  .count());
+    appendString(record, varName.value_or(""));
+    appendBinaryRecord(BinaryRecordType::POST_INVOCATION, record);
+    return;
+  }
+
   vector<string> lines;
   // Log current timestamp, object id and return value
   lines.push_back(logTimeAndRv(rv, object_id, begin));
@@ -15,6 +15,7 @@
 #include <typeindex>
 
 #include "fboss/agent/AsyncLogger.h"
+#include "fboss/agent/BinaryTraceLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 #include "fboss/agent/hw/sai/tracer/Utils.h"
@@ -59,6 +60,14 @@ class SaiTracer {
 
   static std::shared_ptr<SaiTracer> getInstance();
 
+  /*
+   * Regenerate the C replay log (written to --sai_log) from a binary trace
+   * recorded with --enable_sai_binary_log. Must be called before anything
+   * else instantiates the tracer, since the trace carries the flags the
+   * replay log has to be generated with.
+   */
+  static void decodeBinaryTrace(const std::string& binaryLog);
+
   void printHex(std::ostringstream& outStringStream, uint8_t u8);
 
   void logApiInitialize(const char** variables, const char** values, int size);
@@ -336,12 +345,81 @@ class SaiTracer {
       std::vector<std::string>& lines);
 
   std::string rvCheck(sai_status_t rv);
+  std::string rvCheck(sai_status_t rv, uint32_t callNumber);
 
   std::string logTimeAndRv(
       sai_status_t rv,
       sai_object_id_t object_id = SAI_NULL_OBJECT_ID,
       std::chrono::system_clock::time_point begin =
-          std::chrono::system_clock::time_point::min());
+          std::chrono::system_clock::time_point::min(),
+      std::chrono::system_clock::time_point now =
+          std::chrono::system_clock::now());
+
+  // Helpers shared by the text log and the binary trace decoder
+  std::vector<std::string> createFnLines(
+      const std::string& fn_name,
+      const std::string& varName,
+      sai_object_id_t switch_id,
+      uint32_t attr_count,
+      const sai_attribute_t* attr_list,
+      sai_object_type_t object_type);
+
+  std::string removeFnCall(
+      const std::string& fn_name,
+      sai_object_id_t remove_object_id,
+      sai_object_type_t object_type);
+
+  std::vector<std::string> setAttrFnLines(
+      const std::string& fn_name,
+      sai_object_id_t set_object_id,
+      const sai_attribute_t* attr,
+      sai_object_type_t object_type);
+
+  // Calls of the entry based (route, neighbor, fdb and inseg) APIs
+  enum class EntryFn : uint8_t {
+    CREATE,
+    REMOVE,
+    SET_ATTRIBUTE,
+  };
+
+  void logEntryFn(
+      EntryFn fn,
+      sai_object_type_t object_type,
+      const void* entry,
+      size_t entrySize,
+      uint32_t attr_count,
+      const sai_attribute_t* attr_list,
+      sai_status_t rv);
+
+  std::vector<std::string> entryFnLines(
+      EntryFn fn,
+      sai_object_type_t object_type,
+      const void* entry,
+      uint32_t attr_count,
+      const sai_attribute_t* attr_list,
+      sai_status_t rv,
+      uint32_t callNumber,
+      std::chrono::system_clock::time_point now);
+
+  // Binary trace encoding and decoding
+  enum class BinaryRecordType : uint8_t {
+    TEXT,
+    CREATE,
+    REMOVE,
+    SET_ATTRIBUTE,
+    POST_INVOCATION,
+    ENTRY,
+  };
+
+  void appendBinaryRecord(BinaryRecordType type, const std::string& record);
+
+  void encodeAttrList(
+      std::string& record,
+      const sai_attribute_t* attr_list,
+      uint32_t attr_count,
+      sai_object_type_t object_type);
+
+  void decodeRecords(const std::vector<BinaryTraceLogger::Record>& records);
 
   void checkAttrCount(uint32_t attr_count);
 
@@ -355,6 +433,11 @@ class SaiTracer {
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  // Set instead of asyncLogger_ with --enable_sai_binary_log
+  std::unique_ptr<BinaryTraceLogger> binaryLogger_;
+  // While decoding a binary trace, list and attribute reallocations are
+  // already part of the trace and must not be emitted again
+  bool decoding_{false};
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
@@ -564,12 +647,14 @@ class SaiTracer {
       "void run_trace() {\n";
 };
 
-#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type) \
-  void set##obj_type##Attributes(                \
-      const sai_attribute_t* attr_list,          \
-      uint32_t attr_count,                       \
-      std::vector<std::string>& attrLines,       \
-      sai_status_t rv);
+#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type)                      \
+  void set##obj_type##Attributes(                                     \
+      const sai_attribute_t* attr_list,                               \
+      uint32_t attr_count,                                            \
+      std::vector<std::string>& attrLines,                            \
+      sai_status_t rv);                                               \
+  /* Type index of the attribute, or 0 if the attribute is unknown */ \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t attr_id);
 
 #define WRAP_CREATE_FUNC(obj_type, sai_obj_type, api_type)                 \
   sai_status_t wrap_create_##obj_type(                                     \
@@ -803,6 +888,11 @@ class SaiTracer {
   }
 
 #define SET_SAI_REGULAR_ATTRIBUTES(obj_type)                                 \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t attr_id) {          \
+    auto iter = _##obj_type##Map.find(attr_id);                              \
+    return iter == _##obj_type##Map.end() ? 0 : iter->second.second;         \
+  }                                                                          \
+                                                                             \
   void set##obj_type##Attributes(                                            \
       const sai_attribute_t* attr_list,                                      \
       uint32_t attr_count,                                                   \
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <algorithm>
+#include <cstring>
+
+DECLARE_bool(enable_sai_binary_log);
+DECLARE_string(sai_binary_log);
+DECLARE_string(sai_log);
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kTextLog = "/tmp/sai_trace_decoder_test.log";
+constexpr auto kBinaryLog = "/tmp/sai_trace_decoder_test.bin";
+constexpr auto kDecodedLog = "/tmp/sai_trace_decoder_test_decoded.log";
+
+// Writes the footer of the replay log and lets the next getInstance()
+// create a tracer for the current flags
+void resetTracer() {
+  folly::SingletonVault::singleton()->destroyInstances();
+  folly::SingletonVault::singleton()->reenableInstances();
+}
+
+void traceCalls() {
+  auto tracer = SaiTracer::getInstance();
+  auto begin = std::chrono::system_clock::time_point::min();
+
+  sai_object_id_t switchId = 1;
+  sai_attribute_t switchAttr;
+  switchAttr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+  switchAttr.value.booldata = true;
+  auto varName = tracer->logCreateFn(
+      "create_switch",
+      &switchId,
+      SAI_NULL_OBJECT_ID,
+      1,
+      &switchAttr,
+      SAI_OBJECT_TYPE_SWITCH);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, switchId, begin, varName);
+
+  // Port with a list attribute
+  sai_object_id_t portId = 2;
+  uint32_t lanes[] = {1, 2, 3, 4};
+  sai_attribute_t portAttr;
+  portAttr.id = SAI_PORT_ATTR_HW_LANE_LIST;
+  portAttr.value.u32list.count = 4;
+  portAttr.value.u32list.list = lanes;
+  varName = tracer->logCreateFn(
+      "create_port", &portId, switchId, 1, &portAttr, SAI_OBJECT_TYPE_PORT);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, portId, begin, varName);
+
+  sai_attribute_t adminState;
+  adminState.id = SAI_PORT_ATTR_ADMIN_STATE;
+  adminState.value.booldata = true;
+  tracer->logSetAttrFn(
+      "set_port_attribute", portId, &adminState, SAI_OBJECT_TYPE_PORT);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, portId, begin);
+
+  // Route entry
+  sai_route_entry_t routeEntry{};
+  routeEntry.switch_id = switchId;
+  routeEntry.vr_id = 3;
+  routeEntry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  routeEntry.destination.addr.ip4 = 0x0a000000;
+  routeEntry.destination.mask.ip4 = 0xffffff00;
+  sai_attribute_t routeAttr;
+  routeAttr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+  routeAttr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+  tracer->logRouteEntryCreateFn(&routeEntry, 1, &routeAttr);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, SAI_NULL_OBJECT_ID, begin);
+  routeAttr.value.s32 = SAI_PACKET_ACTION_DROP;
+  tracer->logRouteEntrySetAttrFn(&routeEntry, &routeAttr);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, SAI_NULL_OBJECT_ID, begin);
+  tracer->logRouteEntryRemoveFn(&routeEntry);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, SAI_NULL_OBJECT_ID, begin);
+
+  // Neighbor entry
+  sai_neighbor_entry_t neighborEntry{};
+  neighborEntry.switch_id = switchId;
+  neighborEntry.rif_id = 4;
+  neighborEntry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  neighborEntry.ip_address.addr.ip4 = 0x0a000001;
+  sai_attribute_t neighborAttr;
+  neighborAttr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+  sai_mac_t mac = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+  std::memcpy(neighborAttr.value.mac, mac, sizeof(mac));
+  tracer->logNeighborEntryCreateFn(
+      &neighborEntry, 1, &neighborAttr, SAI_STATUS_SUCCESS);
+  tracer->logNeighborEntrySetAttrFn(
+      &neighborEntry, &neighborAttr, SAI_STATUS_FAILURE);
+  tracer->logNeighborEntryRemoveFn(&neighborEntry, SAI_STATUS_SUCCESS);
+
+  // Fdb entry
+  sai_fdb_entry_t fdbEntry{};
+  fdbEntry.switch_id = switchId;
+  fdbEntry.bv_id = 5;
+  std::memcpy(fdbEntry.mac_address, mac, sizeof(mac));
+  sai_attribute_t fdbAttr;
+  fdbAttr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+  fdbAttr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+  tracer->logFdbEntryCreateFn(&fdbEntry, 1, &fdbAttr, SAI_STATUS_SUCCESS);
+  tracer->logFdbEntrySetAttrFn(&fdbEntry, &fdbAttr, SAI_STATUS_SUCCESS);
+  tracer->logFdbEntryRemoveFn(&fdbEntry, SAI_STATUS_SUCCESS);
+
+  tracer->logRemoveFn("remove_port", portId, SAI_OBJECT_TYPE_PORT);
+  tracer->logPostInvocation(SAI_STATUS_SUCCESS, portId, begin);
+}
+
+// Timestamps differ between runs, so compare everything else
+std::vector<std::string> replayLines(const std::string& path) {
+  std::string content;
+  EXPECT_TRUE(folly::readFile(path.c_str(), content));
+  std::vector<std::string> lines;
+  folly::split('\n', content, lines);
+  lines.erase(
+      std::remove_if(
+          lines.begin(),
+          lines.end(),
+          [](const auto& line) { return line.rfind("// ", 0) == 0; }),
+      lines.end());
+  return lines;
+}
+} // namespace
+
+class SaiTraceDecoderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_replayer = true;
+    FLAGS_sai_log = kTextLog;
+    FLAGS_sai_binary_log = kBinaryLog;
+  }
+
+  void TearDown() override {
+    FLAGS_enable_sai_binary_log = false;
+    resetTracer();
+    FLAGS_enable_replayer = false;
+    std::remove(kTextLog);
+    std::remove(kBinaryLog);
+    std::remove(kDecodedLog);
+  }
+};
+
+TEST_F(SaiTraceDecoderTest, decodedMatchesTextLog) {
+  // Trace the calls as text
+  FLAGS_enable_sai_binary_log = false;
+  resetTracer();
+  traceCalls();
+  resetTracer();
+
+  // Trace the same calls as binary records
+  FLAGS_enable_sai_binary_log = true;
+  traceCalls();
+  resetTracer();
+
+  // Decode into a separate replay log
+  FLAGS_sai_log = kDecodedLog;
+  SaiTracer::decodeBinaryTrace(kBinaryLog);
+  resetTracer();
+
+  auto textLines = replayLines(kTextLog);
+  EXPECT_FALSE(textLines.empty());
+  EXPECT_EQ(replayLines(kDecodedLog), textLines);
+}
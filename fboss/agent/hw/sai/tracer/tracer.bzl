@@ -1,6 +1,8 @@
+load("@fbcode_macros//build_defs:cpp_binary.bzl", "cpp_binary")
 load("@fbcode_macros//build_defs:cpp_library.bzl", "cpp_library")
+load("@fbcode_macros//build_defs:cpp_unittest.bzl", "cpp_unittest")
 load("//fboss/agent/hw/bcm:wrapped_symbols.bzl", "wrapped_sai_symbols")
-load("//fboss/agent/hw/sai/impl:impl.bzl", "SAI_IMPLS", "to_impl_external_deps", "to_impl_suffix", "to_versions")
+load("//fboss/agent/hw/sai/impl:impl.bzl", "SAI_FAKE_IMPLS", "SAI_IMPLS", "to_impl_external_deps", "to_impl_lib_name", "to_impl_suffix", "to_versions")
 
 def _sai_api_tracer_impl(sai_impl):
     sai_external_deps = to_impl_external_deps(sai_impl)
@@ -54,6 +56,7 @@ def _sai_api_tracer_impl(sai_impl):
         undefined_symbols = True,
         exported_deps = [
             "//fboss/agent:async_logger",
+            "//fboss/agent:binary_trace_logger",
             "//fboss/agent:fboss-error",
             "//fboss/agent:fboss-types",
             "//fboss/agent/hw/sai/api:sai_version",
@@ -72,6 +75,45 @@ def _sai_api_tracer_impl(sai_impl):
         versions = to_versions(sai_impl),
     )
 
+def _sai_trace_decoder(sai_impl):
+    # Decoding only formats the replay log, so linking against the fake SAI
+    # is enough to resolve the wrapped symbols.
+    cpp_binary(
+        name = "sai_trace_decoder{}".format(to_impl_suffix(sai_impl)),
+        srcs = [
+            "SaiTraceDecoder.cpp",
+        ],
+        deps = [
+            ":sai_tracer{}".format(to_impl_suffix(sai_impl)),
+            "//fboss/agent/hw/sai/impl:{}".format(to_impl_lib_name(sai_impl)),
+            "//folly/init:init",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+        versions = to_versions(sai_impl),
+    )
+
+    cpp_unittest(
+        name = "sai_trace_decoder_test{}".format(to_impl_suffix(sai_impl)),
+        srcs = [
+            "tests/SaiTraceDecoderTest.cpp",
+        ],
+        deps = [
+            ":sai_tracer{}".format(to_impl_suffix(sai_impl)),
+            "//fboss/agent/hw/sai/impl:{}".format(to_impl_lib_name(sai_impl)),
+            "//folly:file_util",
+            "//folly:singleton",
+            "//folly:string",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+        versions = to_versions(sai_impl),
+    )
+
 def sai_tracer_apis():
     for sai_impls in SAI_IMPLS:
         _sai_api_tracer_impl(sai_impls)
+    for sai_impl in SAI_FAKE_IMPLS:
+        _sai_trace_decoder(sai_impl)
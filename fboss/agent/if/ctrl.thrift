@@ -509,6 +509,11 @@ struct CaptureInfo {
    * set of criteria that packet must meet to be captured
    */
   4: CaptureFilter filter;
+  /*
+   * Only keep the first maxPacketBytes bytes of each captured packet.
+   * 0 captures whole packets.
+   */
+  5: i32 maxPacketBytes = 0;
 }
 
 struct RouteUpdateLoggingInfo {
@@ -760,6 +765,18 @@ struct EcmpDetails {
   4: i32 flowletTableSize;
 }
 
+/*
+ * Estimated memory held by a switch state subtree. Shared nodes are also
+ * referenced by another state still being held (e.g. by state observers, FSDB
+ * or the rollback path) and are not freed along with this state.
+ */
+struct SwitchStateMemoryUsage {
+  1: i64 numNodes;
+  2: i64 bytes;
+  3: i64 numSharedNodes;
+  4: i64 sharedBytes;
+}
+
 service FbossCtrl extends phy.FbossCommonPhyCtrl {
   /*
    * Retrieve up-to-date counters from the hardware, and publish all
@@ -1224,6 +1241,14 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
    */
   void patchCurrentStateJSONForPaths(1: map<string, string> pathToJsonPatch);
 
+  /*
+   * Estimated memory used by each top level subtree of the current switch
+   * state, and how much of it is shared with other states
+   */
+  map<string, SwitchStateMemoryUsage> getSwitchStateMemoryUsage() throws (
+    1: fboss.FbossBaseError error,
+  );
+
   /*
   * Switch run state
   */
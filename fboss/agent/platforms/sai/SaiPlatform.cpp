@@ -11,6 +11,7 @@
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 #include "fboss/agent/hw/switch_asics/EbroAsic.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
@@ -294,6 +295,8 @@ void SaiPlatform::initSaiProfileValues() {
 
 void SaiPlatform::initImpl(uint32_t hwFeaturesDesired) {
   initSaiProfileValues();
+  // Locking mode is fixed before the first SAI API call
+  SaiApiLock::getInstance()->setPerApiLocking(FLAGS_sai_per_api_lock);
   SaiApiTable::getInstance()->queryApis(
       getServiceMethodTable(), getSupportedApiList());
   saiSwitch_ = std::make_unique<SaiSwitch>(this, hwFeaturesDesired);
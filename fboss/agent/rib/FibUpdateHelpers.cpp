@@ -22,9 +22,15 @@ std::shared_ptr<facebook::fboss::SwitchState> ribToSwitchStateUpdate(
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const std::unordered_set<LabelID>* changedLabels,
     void* cookie) {
   ForwardingInformationBaseUpdater fibUpdater(
-      resolver, vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      resolver,
+      vrf,
+      v4NetworkToRoute,
+      v6NetworkToRoute,
+      labelToRoute,
+      changedLabels);
 
   auto switchState =
       static_cast<std::shared_ptr<facebook::fboss::SwitchState>*>(cookie);
@@ -39,6 +45,7 @@ std::shared_ptr<facebook::fboss::SwitchState> noopFibUpdate(
     const IPv4NetworkToRouteMap& /*v4NetworkToRoute*/,
     const IPv6NetworkToRouteMap& /*v6NetworkToRoute*/,
     const LabelToRouteMap& /*labelToRoute*/,
+    const std::unordered_set<LabelID>* /*changedLabels*/,
     void* /*cookie*/) {
   return nullptr;
 }
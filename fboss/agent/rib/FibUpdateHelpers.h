@@ -13,6 +13,7 @@
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 
 #include <memory>
+#include <unordered_set>
 
 namespace facebook::fboss {
 
@@ -25,6 +26,7 @@ std::shared_ptr<SwitchState> ribToSwitchStateUpdate(
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const std::unordered_set<LabelID>* changedLabels,
     void* cookie);
 
 std::shared_ptr<SwitchState> noopFibUpdate(
@@ -33,5 +35,6 @@ std::shared_ptr<SwitchState> noopFibUpdate(
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const std::unordered_set<LabelID>* changedLabels,
     void* cookie);
 } // namespace facebook::fboss
@@ -30,12 +30,14 @@ ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
-    const LabelToRouteMap& labelToRoute)
+    const LabelToRouteMap& labelToRoute,
+    const std::unordered_set<LabelID>* changedLabels)
     : resolver_(resolver),
       vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
       v6NetworkToRoute_(v6NetworkToRoute),
-      labelToRoute_(labelToRoute) {}
+      labelToRoute_(labelToRoute),
+      changedLabels_(changedLabels) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -158,6 +160,9 @@ ForwardingInformationBaseUpdater::createUpdatedLabelFib(
   if (!FLAGS_mpls_rib) {
     return nullptr;
   }
+  if (changedLabels_) {
+    return updateChangedLabels(rib, fib);
+  }
 
   bool updated = false;
   auto newFib = std::make_shared<MultiLabelForwardingInformationBase>();
@@ -203,4 +208,46 @@ ForwardingInformationBaseUpdater::createUpdatedLabelFib(
   return updated ? newFib : nullptr;
 }
 
+std::shared_ptr<facebook::fboss::MultiLabelForwardingInformationBase>
+ForwardingInformationBaseUpdater::updateChangedLabels(
+    const facebook::fboss::NetworkToRouteMap<LabelID>& rib,
+    const std::shared_ptr<facebook::fboss::MultiLabelForwardingInformationBase>&
+        fib) {
+  // Cloned on first change, untouched entries stay shared with fib
+  std::shared_ptr<MultiLabelForwardingInformationBase> newFib;
+  auto writableFib = [&]() {
+    if (!newFib) {
+      newFib = fib->clone();
+    }
+    return newFib.get();
+  };
+  for (const auto& label : *changedLabels_) {
+    auto fibRoute = fib->getNodeIf(label);
+    auto ribItr = rib.find(label);
+    if (ribItr == rib.end() || !ribItr->second->isResolved()) {
+      // Deleted or no longer resolved
+      if (fibRoute) {
+        writableFib()->removeNode(label);
+      }
+      continue;
+    }
+    const auto& ribRoute = ribItr->second;
+    if (!facebook::fboss::MultiLabelForwardingInformationBase::
+            isValidNextHopSet(ribRoute->getForwardInfo().getNextHopSet())) {
+      throw FbossError("invalid label next hop");
+    }
+    if (fibRoute &&
+        (fibRoute == ribRoute || fibRoute->isSame(ribRoute.get()))) {
+      // Pointer or contents are same, reuse existing route
+      continue;
+    }
+    CHECK(ribRoute->isPublished());
+    if (fibRoute) {
+      writableFib()->removeNode(label);
+    }
+    writableFib()->addNode(ribRoute, resolver_->scope(ribRoute));
+  }
+  return newFib;
+}
+
 } // namespace facebook::fboss
@@ -17,6 +17,7 @@
 #include "fboss/agent/types.h"
 
 #include <memory>
+#include <unordered_set>
 
 namespace facebook::fboss {
 
@@ -30,7 +31,8 @@ class ForwardingInformationBaseUpdater {
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
-      const LabelToRouteMap& labelToRoute);
+      const LabelToRouteMap& labelToRoute,
+      const std::unordered_set<LabelID>* changedLabels = nullptr);
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -50,12 +52,24 @@ class ForwardingInformationBaseUpdater {
       const facebook::fboss::NetworkToRouteMap<LabelID>& rib,
       std::shared_ptr<facebook::fboss::MultiLabelForwardingInformationBase>
           fib);
+  /*
+   * Copy-on-write update of just the changed labels in the label FIB.
+   * Return updated FIB on change, null otherwise
+   */
+  std::shared_ptr<facebook::fboss::MultiLabelForwardingInformationBase>
+  updateChangedLabels(
+      const facebook::fboss::NetworkToRouteMap<LabelID>& rib,
+      const std::shared_ptr<
+          facebook::fboss::MultiLabelForwardingInformationBase>& fib);
 
   const SwitchIdScopeResolver* resolver_;
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
   const LabelToRouteMap& labelToRoute_;
+  // Labels changed in the RIB since the label FIB was last synced, null if
+  // the whole label FIB needs to be synced
+  const std::unordered_set<LabelID>* changedLabels_;
 };
 
 } // namespace facebook::fboss
@@ -52,8 +52,12 @@ RibRouteUpdater::RibRouteUpdater(
 RibRouteUpdater::RibRouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
     IPv6NetworkToRouteMap* v6Routes,
-    LabelToRouteMap* mplsRoutes)
-    : v4Routes_(v4Routes), v6Routes_(v6Routes), mplsRoutes_(mplsRoutes) {}
+    LabelToRouteMap* mplsRoutes,
+    std::unordered_set<LabelID>* changedLabels)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      mplsRoutes_(mplsRoutes),
+      changedLabels_(changedLabels) {}
 
 void RibRouteUpdater::update(
     const std::map<ClientID, std::vector<RouteEntry>>& toAdd,
@@ -165,12 +169,14 @@ void RibRouteUpdater::addOrReplaceRoute(
         label,
         std::make_shared<Route<LabelID>>(
             Route<LabelID>::makeThrift(label, clientID, entry))));
+    labelChanged(label);
   } else {
     auto& route = iter->second;
     auto existingRouteForClient = route->getEntryForClient(clientID);
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<LabelID>(route);
       route->update(clientID, entry);
+      labelChanged(label);
     }
   }
 }
@@ -233,6 +239,7 @@ void RibRouteUpdater::delRoute(const LabelID& label, const ClientID clientID) {
   if (!clientNhopEntry) {
     return;
   }
+  labelChanged(label);
   if (route->numClientEntries() == 1) {
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
@@ -274,6 +281,9 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
 
   // Now, delete whatever routes went from 1 nexthoplist to 0.
   for (auto it : toDelete) {
+    if constexpr (std::is_same_v<AddressT, LabelID>) {
+      labelChanged(it->first);
+    }
     routes->erase(it);
   }
 }
@@ -719,6 +729,10 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>> RibRouteUpdater::writableRoute(
     typename NetworkToRouteMap<AddressT>::Iterator ritr) {
+  if constexpr (std::is_same_v<AddressT, LabelID>) {
+    // Callers modify the route they get back
+    labelChanged(ritr->first);
+  }
   if (value<AddressT>(ritr)->isPublished()) {
     value<AddressT>(ritr) = value<AddressT>(ritr)->clone();
   }
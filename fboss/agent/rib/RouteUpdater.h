@@ -16,6 +16,8 @@
 
 #include <folly/IPAddress.h>
 
+#include <unordered_set>
+
 namespace facebook::fboss {
 
 /**
@@ -48,10 +50,16 @@ class RibRouteUpdater {
       IPv4NetworkToRouteMap* v4Routes,
       IPv6NetworkToRouteMap* v6Routes);
 
+  /*
+   * If changedLabels is set, every label whose route is added, removed or
+   * modified (including by re-resolution) is recorded into it. This lets
+   * the label FIB be updated for just those labels.
+   */
   RibRouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
       IPv6NetworkToRouteMap* v6Routes,
-      LabelToRouteMap* mplsRoutes);
+      LabelToRouteMap* mplsRoutes,
+      std::unordered_set<LabelID>* changedLabels = nullptr);
 
   struct RouteEntry {
     folly::CIDRNetwork prefix;
@@ -170,12 +178,19 @@ class RibRouteUpdater {
   template <typename AddressT>
   bool needResolve(const std::shared_ptr<Route<AddressT>>& route) const;
 
+  void labelChanged(LabelID label) {
+    if (changedLabels_) {
+      changedLabels_->insert(label);
+    }
+  }
+
   using NextHopIpToForwardInfo =
       std::unordered_map<folly::IPAddress, RouteNextHopSet>;
 
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
   LabelToRouteMap* mplsRoutes_{nullptr};
+  std::unordered_set<LabelID>* changedLabels_{nullptr};
   std::unordered_set<void*> needsResolution_;
   /*
    * Cache for next hop to FWD informatio. For our use case
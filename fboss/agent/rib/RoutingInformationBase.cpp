@@ -235,6 +235,8 @@ void RibRouteTables::reconfigure(
               staticMplsRoutesToNull.cbegin(), staticMplsRoutesToNull.cend()),
           folly::range(
               staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()));
+      // Label changes made by config are not tracked, resync the label FIB
+      routeTable.changedLabels.reset();
       // Apply config
       configApplier.apply();
     });
@@ -305,7 +307,8 @@ void RibRouteTables::updateRemoteInterfaceRoutes(
         RibRouteUpdater updater(
             &(routeTable.v4NetworkToRoute),
             &(routeTable.v6NetworkToRoute),
-            &(routeTable.labelToRoute));
+            &(routeTable.labelToRoute),
+            routeTable.changedLabelsIf());
         updater.update(
             {{ClientID::REMOTE_INTERFACE_ROUTE, toAddRoutes}},
             {{ClientID::REMOTE_INTERFACE_ROUTE, toDelRoutes}},
@@ -332,7 +335,8 @@ void RibRouteTables::update(
     RibRouteUpdater updater(
         &(routeTable.v4NetworkToRoute),
         &(routeTable.v6NetworkToRoute),
-        &(routeTable.labelToRoute));
+        &(routeTable.labelToRoute),
+        routeTable.changedLabelsIf());
     updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
   });
   updateFib(resolver, routerID, fibUpdateCallback, cookie);
@@ -344,15 +348,24 @@ void RibRouteTables::updateFib(
     const FibUpdateFunction& fibUpdateCallback,
     void* cookie) {
   try {
-    auto lockedRouteTables = synchronizedRouteTables_.rlock();
-    auto& routeTable = lockedRouteTables->find(vrf)->second;
-    fibUpdateCallback(
-        resolver,
-        vrf,
-        routeTable.v4NetworkToRoute,
-        routeTable.v6NetworkToRoute,
-        routeTable.labelToRoute,
-        cookie);
+    SCOPE_FAIL {
+      // The label FIB may now be out of sync with the RIB
+      synchronizedRouteTables_.wlock()->find(vrf)->second.changedLabels.reset();
+    };
+    {
+      auto lockedRouteTables = synchronizedRouteTables_.rlock();
+      auto& routeTable = lockedRouteTables->find(vrf)->second;
+      fibUpdateCallback(
+          resolver,
+          vrf,
+          routeTable.v4NetworkToRoute,
+          routeTable.v6NetworkToRoute,
+          routeTable.labelToRoute,
+          routeTable.changedLabels ? &(*routeTable.changedLabels) : nullptr,
+          cookie);
+    }
+    // Label FIB is in sync now, track changes from here on
+    synchronizedRouteTables_.wlock()->find(vrf)->second.changedLabels.emplace();
   } catch (const FbossHwUpdateError& hwUpdateError) {
     {
       SCOPE_FAIL {
@@ -850,6 +863,7 @@ void RibRouteTables::importFibs(
       importRoutes(fib->getFibV6(), &routeTables.v6NetworkToRoute);
       importRoutes(fib->getFibV4(), &routeTables.v4NetworkToRoute);
       auto mplsTable = &routeTables.labelToRoute;
+      routeTables.changedLabels.reset();
       if (FLAGS_mpls_rib && labelFibs) {
         for (const auto& [_, labelFib] : std::as_const(*labelFibs)) {
           for (const auto& entry : std::as_const(*labelFib)) {
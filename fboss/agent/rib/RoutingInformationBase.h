@@ -21,7 +21,9 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 DECLARE_bool(mpls_rib);
@@ -31,12 +33,18 @@ class SwitchState;
 class MultiSwitchForwardingInformationBaseMap;
 class SwitchIdScopeResolver;
 
+/*
+ * changedLabels holds the labels whose RIB entries changed since the label
+ * FIB was last synced from this RIB, so only those need to be reprogrammed.
+ * A null changedLabels means the whole label FIB must be synced.
+ */
 using FibUpdateFunction = std::function<std::shared_ptr<SwitchState>(
     const SwitchIdScopeResolver* resolver,
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const std::unordered_set<LabelID>* changedLabels,
     void* cookie)>;
 
 /*
@@ -136,6 +144,13 @@ class RibRouteTables {
     IPv4NetworkToRouteMap v4NetworkToRoute;
     IPv6NetworkToRouteMap v6NetworkToRoute;
     LabelToRouteMap labelToRoute;
+    // Labels changed since the label FIB was last synced. std::nullopt
+    // until the first sync and after a failed one, which forces a full sync.
+    std::optional<std::unordered_set<LabelID>> changedLabels;
+
+    std::unordered_set<LabelID>* changedLabelsIf() {
+      return changedLabels ? &(*changedLabels) : nullptr;
+    }
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -66,6 +66,7 @@ class FailSomeUpdates {
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
       const LabelToRouteMap& labelToRoute,
+      const std::unordered_set<LabelID>* changedLabels,
       void* cookie) {
     if (toFail_.find(++cnt_) != toFail_.end()) {
       auto curSwitchStatePtr =
@@ -78,6 +79,7 @@ class FailSomeUpdates {
           v4NetworkToRoute,
           v6NetworkToRoute,
           labelToRoute,
+          changedLabels,
           static_cast<void*>(&desiredState));
       throw FbossHwUpdateError(desiredState, *curSwitchStatePtr);
     }
@@ -87,6 +89,7 @@ class FailSomeUpdates {
         v4NetworkToRoute,
         v6NetworkToRoute,
         labelToRoute,
+        changedLabels,
         cookie);
   }
 
@@ -426,3 +429,44 @@ TEST_F(RibRollbackTest, rollbackMpls) {
   assertRouteCount(0, 1, 1);
   EXPECT_EQ(routeTableBeforeFailedUpdate, rib_.getRouteTableDetails(kRid));
 }
+
+TEST_F(RibRollbackTest, mplsIncrementalUpdate) {
+  auto labelFib = switchState_->getLabelForwardingInformationBase();
+  auto label501 = labelFib->getNode(501);
+  rib_.update(
+      scopeResolver(),
+      kRid,
+      kBgpClient,
+      kBgpDistance,
+      util::getTestRoutes(1, 1),
+      {},
+      false,
+      "add mpls",
+      ribToSwitchStateUpdate,
+      &switchState_);
+  assertRouteCount(0, 1, 2);
+  // Untouched labels are carried over as is
+  EXPECT_NE(labelFib, switchState_->getLabelForwardingInformationBase());
+  EXPECT_EQ(
+      label501,
+      switchState_->getLabelForwardingInformationBase()->getNode(501));
+
+  rib_.update(
+      scopeResolver(),
+      kRid,
+      kBgpClient,
+      kBgpDistance,
+      std::vector<MplsRoute>{},
+      {501},
+      false,
+      "del mpls",
+      ribToSwitchStateUpdate,
+      &switchState_);
+  assertRouteCount(0, 1, 1);
+  EXPECT_EQ(
+      nullptr,
+      switchState_->getLabelForwardingInformationBase()->getNodeIf(501));
+  EXPECT_NE(
+      nullptr,
+      switchState_->getLabelForwardingInformationBase()->getNodeIf(502));
+}
@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 #include <folly/functional/ApplyTuple.h>
 #include <glog/logging.h>
@@ -48,6 +49,46 @@ class MapUniquePointerTraits {
   }
 };
 
+/*
+ * Maps may journal the keys they changed since being cloned from a published
+ * map (see thrift_cow::ThriftMapNode::changedKeysSince). A delta between such
+ * a pair of maps only needs to visit the journaled keys.
+ */
+struct NoChangedKeys {
+  using const_iterator = const void*;
+};
+
+template <typename MAP, typename = void>
+struct ChangeJournalTraits {
+  static constexpr bool kHasJournal = false;
+  using ChangedKeys = NoChangedKeys;
+};
+
+template <typename MAP>
+struct ChangeJournalTraits<
+    MAP,
+    std::void_t<decltype(std::declval<const MAP&>().changedKeysSince(
+        std::declval<const MAP&>()))>> {
+  static constexpr bool kHasJournal = true;
+  using ChangedKeys = std::remove_const_t<
+      std::remove_pointer_t<decltype(std::declval<const MAP&>()
+                                         .changedKeysSince(
+                                             std::declval<const MAP&>()))>>;
+
+  static const ChangedKeys* getChangedKeys(
+      const MAP* oldMap,
+      const MAP* newMap) {
+    if (!oldMap || !newMap) {
+      return nullptr;
+    }
+    if (auto changedKeys = newMap->changedKeysSince(*oldMap)) {
+      return changedKeys;
+    }
+    // The delta may also go back from a map to the one it was cloned from
+    return oldMap->changedKeysSince(*newMap);
+  }
+};
+
 template <typename NODE, typename NODE_WRAPPER = std::shared_ptr<NODE>>
 class DeltaValue {
  public:
@@ -94,6 +135,7 @@ class DeltaValueIteratorT {
  public:
   using MapType = MAP;
   using Node = typename MAP::mapped_type;
+  using ChangedKeys = typename ChangeJournalTraits<MAP>::ChangedKeys;
 
   // Iterator properties
   using iterator_category = std::forward_iterator_tag;
@@ -129,6 +171,25 @@ class DeltaValueIteratorT {
     updateValue();
   }
 
+  /*
+   * Iterate over the changedKeys only, which must include every key whose
+   * node differs between the two maps.
+   */
+  DeltaValueIteratorT(
+      const MapType* oldMap,
+      const MapType* newMap,
+      const ChangedKeys* changedKeys)
+      : oldIt_(oldMap->end()),
+        newIt_(newMap->end()),
+        oldMap_(oldMap),
+        newMap_(newMap),
+        value_(nullNode_, nullNode_),
+        changedKeys_(changedKeys),
+        changedKeyIt_(changedKeys->begin()) {
+    seekChangedKey();
+    updateValue();
+  }
+
   const value_type& operator*() const {
     return value_;
   }
@@ -155,6 +216,16 @@ class DeltaValueIteratorT {
 
  private:
   void advance() {
+    if constexpr (ChangeJournalTraits<MAP>::kHasJournal) {
+      if (changedKeys_) {
+        // advance() shouldn't be called if we are already at the end
+        CHECK(changedKeyIt_ != changedKeys_->end());
+        ++changedKeyIt_;
+        seekChangedKey();
+        updateValue();
+        return;
+      }
+    }
     // If we have already hit the end of one side, advance the other.
     // We are immediately done after this.
     if (oldIt_ == oldMap_->end()) {
@@ -190,6 +261,25 @@ class DeltaValueIteratorT {
     }
     updateValue();
   }
+  // Advance to the first changed key whose node differs between the maps.
+  // Positions are still tracked by oldIt_ and newIt_, which are both at the
+  // end once the changed keys are exhausted, so comparisons with end() hold.
+  void seekChangedKey() {
+    if constexpr (ChangeJournalTraits<MAP>::kHasJournal) {
+      for (; changedKeyIt_ != changedKeys_->end(); ++changedKeyIt_) {
+        oldIt_ = oldMap_->find(*changedKeyIt_);
+        newIt_ = newMap_->find(*changedKeyIt_);
+        bool inOld = oldIt_ != oldMap_->end();
+        bool inNew = newIt_ != newMap_->end();
+        if (inOld != inNew || (inOld && !(*oldIt_ == *newIt_))) {
+          return;
+        }
+      }
+      oldIt_ = oldMap_->end();
+      newIt_ = newMap_->end();
+    }
+  }
+
   void updateValue() {
     if (oldIt_ == oldMap_->end()) {
       if (newIt_ == newMap_->end()) {
@@ -221,6 +311,10 @@ class DeltaValueIteratorT {
   const MapType* newMap_;
   VALUE value_;
   static const typename VALUE::NodeWrapper nullNode_;
+
+ private:
+  const ChangedKeys* changedKeys_{nullptr};
+  typename ChangedKeys::const_iterator changedKeyIt_{};
 };
 
 template <typename MAP, typename VALUE, typename MAP_EXTRACTOR>
@@ -257,6 +351,12 @@ class MapDeltaImpl {
     if (old_ == new_) {
       return end();
     }
+    if constexpr (ChangeJournalTraits<MAP>::kHasJournal) {
+      if (auto changedKeys = ChangeJournalTraits<MAP>::getChangedKeys(
+              getOld(), getNew())) {
+        return Iterator(getOld(), getNew(), changedKeys);
+      }
+    }
     // To support deltas where the old node is null (to represent newly created
     // nodes), point the old side of the iterator at the new node, but start it
     // at the end of the map.
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -101,8 +102,10 @@ class StateUpdate {
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
-  // The SwSwitch code needs access to our listHook_ member so it can maintain
-  // the update list.
+  // Time at which the update was queued, used to trace queue wait time.
+  std::chrono::steady_clock::time_point enqueueTime_;
+  // The SwSwitch code needs access to our listHook_ and enqueueTime_
+  // members so it can maintain the update list.
   friend class SwSwitch;
 };
 
@@ -0,0 +1,91 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/state/SwitchStateMemoryUsage.h"
+
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/thrift_cow/visitors/RecurseVisitor.h"
+
+#include <folly/Traits.h>
+
+#include <type_traits>
+#include <vector>
+
+namespace facebook::fboss {
+
+namespace {
+
+// Whether T is a pointer to a thrift_cow node, as opposed to a primitive
+template <typename T, typename = void>
+struct IsCowNodePtr : std::false_type {};
+
+template <typename T>
+struct IsCowNodePtr<
+    T,
+    std::enable_if_t<std::is_same_v<
+        typename T::element_type::CowType,
+        thrift_cow::NodeType>>> : std::true_type {};
+
+// Map, list and set fields keep their entries in a StorageType container
+template <typename Fields, typename = void>
+struct HasStorage : std::false_type {};
+
+template <typename Fields>
+struct HasStorage<Fields, std::void_t<typename Fields::StorageType>>
+    : std::true_type {};
+
+template <typename Node>
+int64_t nodeBytes(const Node& node) {
+  using Fields = folly::remove_cvref_t<decltype(*node.getFields())>;
+  int64_t bytes = sizeof(Node);
+  if constexpr (HasStorage<Fields>::value) {
+    bytes += node.getFields()->size() *
+        sizeof(typename Fields::StorageType::value_type);
+  }
+  return bytes;
+}
+
+} // namespace
+
+std::map<std::string, SwitchStateMemoryUsage> computeSwitchStateMemoryUsage(
+    const std::shared_ptr<SwitchState>& state) {
+  std::map<std::string, SwitchStateMemoryUsage> usage;
+  // Visit a const pointer, so that the visitor does not ask for writable
+  // fields of the published state
+  const std::shared_ptr<SwitchState> root = state;
+  // Nodes are visited parents first, so these are the ancestors of the node
+  // being visited
+  std::vector<bool> sharedAtDepth;
+  thrift_cow::RootRecurseVisitor::visit(
+      root,
+      thrift_cow::RecurseVisitOptions(
+          thrift_cow::RecurseVisitMode::FULL,
+          thrift_cow::RecurseVisitOrder::PARENTS_FIRST),
+      [&](const std::vector<std::string>& path, auto&& node) {
+        if constexpr (IsCowNodePtr<
+                          folly::remove_cvref_t<decltype(node)>>::value) {
+          if (path.empty()) {
+            // Root is always referenced by the caller as well
+            return;
+          }
+          auto depth = path.size();
+          sharedAtDepth.resize(depth);
+          // A node referenced from a single parent is still shared if the
+          // parent is
+          bool shared = node.use_count() > 1 ||
+              (depth > 1 && sharedAtDepth[depth - 2]);
+          sharedAtDepth[depth - 1] = shared;
+
+          auto bytes = nodeBytes(*node);
+          auto& subtreeUsage = usage[path.front()];
+          *subtreeUsage.numNodes() += 1;
+          *subtreeUsage.bytes() += bytes;
+          if (shared) {
+            *subtreeUsage.numSharedNodes() += 1;
+            *subtreeUsage.sharedBytes() += bytes;
+          }
+        }
+      });
+  return usage;
+}
+
+} // namespace facebook::fboss
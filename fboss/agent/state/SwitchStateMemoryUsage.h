@@ -0,0 +1,31 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace facebook::fboss {
+class SwitchState;
+
+/*
+ * Estimate the memory held by each top level subtree of a switch state
+ * (fibsMap, portMaps, aclMaps...), keyed by the subtree's member name.
+ *
+ * Only thrift_cow nodes are allocated on their own, so a subtree is charged
+ * with the size of its nodes plus the entries stored in its maps, lists and
+ * sets. Heap data of primitive fields (e.g. long strings) is not counted.
+ *
+ * Consecutive states share every node that was not modified in between. A
+ * node is reported as shared if it is also referenced from outside of this
+ * state, e.g. by a previous state still held by a state observer, FSDB or the
+ * rollback path, or if one of its ancestors is. Shared memory is not freed
+ * when this state goes away.
+ */
+std::map<std::string, SwitchStateMemoryUsage> computeSwitchStateMemoryUsage(
+    const std::shared_ptr<SwitchState>& state);
+
+} // namespace facebook::fboss
@@ -517,4 +517,38 @@ TYPED_TEST(AclNexthopHandlerTest, ResolvedAclNextHopMultiNexthopWithInterface) {
 
   this->verifyResolvedNexthopsInAclAction(kAclName, expectedNexthops);
 }
+
+TYPED_TEST(AclNexthopHandlerTest, MoreSpecificRouteReResolves) {
+  this->updateState(
+      "MoreSpecificRouteReResolves",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        return this->addAcl(state, kAclName, this->getAclNexthopIps(1));
+      });
+
+  auto nexthopIps = this->getResolvedNexthops(2);
+  RouteNextHopSet nexthops1 =
+      makeResolvedNextHops({nexthopIps[0]}, UCMP_DEFAULT_WEIGHT);
+  RouteNextHopSet nexthops2 =
+      makeResolvedNextHops({nexthopIps[1]}, UCMP_DEFAULT_WEIGHT);
+  auto coveringPrefix = this->makePrefix(this->getMatchingPrefixes(1)[0]);
+  this->addRoute(coveringPrefix, nexthops1);
+  this->verifyResolvedNexthopsInAclAction(kAclName, nexthops1);
+
+  // A route for some other destination leaves the ACL alone
+  auto otherPrefix = std::is_same_v<TypeParam, folly::IPAddressV4>
+      ? this->makePrefix("200.0.0.0/24")
+      : this->makePrefix("2000::0/64");
+  this->addRoute(otherPrefix, nexthops2);
+  this->verifyResolvedNexthopsInAclAction(kAclName, nexthops1);
+
+  // A host route for the next hop is a longer match and takes over
+  auto hostPrefix = std::is_same_v<TypeParam, folly::IPAddressV4>
+      ? this->makePrefix(this->getAclNexthopIps(1)[0] + "/32")
+      : this->makePrefix(this->getAclNexthopIps(1)[0] + "/128");
+  this->addRoute(hostPrefix, nexthops2);
+  this->verifyResolvedNexthopsInAclAction(kAclName, nexthops2);
+
+  this->delRoute(hostPrefix);
+  this->verifyResolvedNexthopsInAclAction(kAclName, nexthops1);
+}
 } // namespace facebook::fboss
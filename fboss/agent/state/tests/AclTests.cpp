@@ -8,6 +8,7 @@
  *
  */
 
+#include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -19,7 +20,9 @@
 #include "folly/IPAddress.h"
 
 #include <folly/MacAddress.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <limits>
 
 using namespace facebook::fboss;
 using facebook::fboss::InterfaceID;
@@ -1302,3 +1305,206 @@ TEST(Acl, GetRequiredAclTableQualifiers) {
   EXPECT_EQ(q0, qualifiers0);
   EXPECT_EQ(q1, qualifiers1);
 }
+
+TEST(Acl, GappedPriorityInsertTouchesFewAcls) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_acl_table_group = false;
+  FLAGS_acl_priority_gap = 100;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  auto makeAcl = [](const std::string& name) {
+    cfg::AclEntry acl;
+    *acl.name() = name;
+    *acl.actionType() = cfg::AclActionType::DENY;
+    return acl;
+  };
+  cfg::SwitchConfig config;
+  for (int i = 0; i < 2000; ++i) {
+    config.acls()->push_back(makeAcl(folly::to<std::string>("acl", i)));
+  }
+  auto state = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, state);
+
+  auto numAclsTouched = [](const auto& oldState, const auto& newState) {
+    StateDelta delta(oldState, newState);
+    int touched = 0;
+    for (const auto& aclDelta : delta.getAclsDelta()) {
+      std::ignore = aclDelta;
+      ++touched;
+    }
+    return touched;
+  };
+  auto checkPrioritiesInConfigOrder = [&config](const auto& state) {
+    std::optional<int> prevPriority;
+    for (const auto& acl : *config.acls()) {
+      auto priority = state->getAcl(*acl.name())->getPriority();
+      if (prevPriority) {
+        EXPECT_LT(*prevPriority, priority);
+      }
+      // 2000 ACLs spaced by 100 do not fit the dataplane window, so they
+      // are spread with a smaller gap
+      EXPECT_LT(priority, 2 * AclTable::kDataplaneAclMaxPriority);
+      prevPriority = priority;
+    }
+  };
+  checkPrioritiesInConfigOrder(state);
+
+  // Inserting an ACL into a gap only touches that ACL
+  for (int i = 0; i < 20; ++i) {
+    auto pos = config.acls()->begin() + 50 * i + 7;
+    config.acls()->insert(pos, makeAcl(folly::to<std::string>("spread", i)));
+    auto newState = publishAndApplyConfig(state, &config, platform.get());
+    ASSERT_NE(nullptr, newState);
+    EXPECT_EQ(numAclsTouched(state, newState), 1);
+    checkPrioritiesInConfigOrder(newState);
+    state = newState;
+  }
+
+  // Inserting at the same position exhausts the gap there, after which
+  // only ACLs close by are renumbered
+  int totalTouched = 0;
+  for (int i = 0; i < 20; ++i) {
+    auto pos = config.acls()->begin() + 1000;
+    config.acls()->insert(pos, makeAcl(folly::to<std::string>("new", i)));
+    auto newState = publishAndApplyConfig(state, &config, platform.get());
+    ASSERT_NE(nullptr, newState);
+    auto touched = numAclsTouched(state, newState);
+    EXPECT_LE(touched, 32);
+    totalTouched += touched;
+    checkPrioritiesInConfigOrder(newState);
+    state = newState;
+  }
+  EXPECT_LE(totalTouched, 100);
+
+  // Moving an ACL only touches that ACL
+  auto moved = config.acls()[10];
+  config.acls()->erase(config.acls()->begin() + 10);
+  config.acls()->insert(config.acls()->begin() + 500, moved);
+  auto newState = publishAndApplyConfig(state, &config, platform.get());
+  ASSERT_NE(nullptr, newState);
+  EXPECT_EQ(numAclsTouched(state, newState), 1);
+  checkPrioritiesInConfigOrder(newState);
+}
+
+TEST(Acl, GappedPrioritiesStayInHwRange) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_acl_table_group = false;
+  FLAGS_acl_priority_gap = std::numeric_limits<int>::max();
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  cfg::SwitchConfig config;
+  for (int i = 0; i < 10; ++i) {
+    cfg::AclEntry acl;
+    *acl.name() = folly::to<std::string>("acl", i);
+    *acl.actionType() = cfg::AclActionType::DENY;
+    config.acls()->push_back(acl);
+  }
+  auto state = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, state);
+
+  // Priorities beyond the dataplane window would not map to a hardware
+  // priority, however large the configured gap
+  std::optional<int> prevPriority;
+  for (const auto& acl : *config.acls()) {
+    auto priority = state->getAcl(*acl.name())->getPriority();
+    EXPECT_GE(priority, AclTable::kDataplaneAclMaxPriority);
+    EXPECT_LT(priority, 2 * AclTable::kDataplaneAclMaxPriority);
+    if (prevPriority) {
+      EXPECT_LT(*prevPriority, priority);
+    }
+    prevPriority = priority;
+  }
+}
+
+TEST(Acl, ApplyWithPrevAppliedConfig) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  cfg::SwitchConfig config;
+  for (int i = 0; i < 10; ++i) {
+    cfg::AclEntry acl;
+    *acl.name() = folly::to<std::string>("acl", i);
+    *acl.actionType() = cfg::AclActionType::DENY;
+    acl.l4SrcPort() = 1000 + i;
+    config.acls()->push_back(acl);
+  }
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  auto prevApplied = PrevAppliedConfig{
+      configSectionFingerprints(config), configDerivedSections(stateV1)};
+
+  // Re-applying the same config is a no-op
+  EXPECT_EQ(
+      nullptr,
+      publishAndApplyConfig(
+          stateV1, &config, platform.get(), nullptr, &prevApplied));
+
+  // A one line ACL change yields the same state as a full evaluation
+  config.acls()->at(5).l4SrcPort() = 2000;
+  EXPECT_NE(configSectionFingerprints(config), prevApplied.fingerprints);
+  auto stateV2 = publishAndApplyConfig(
+      stateV1, &config, platform.get(), nullptr, &prevApplied);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(stateV2->getAcl("acl5")->getL4SrcPort().value(), 2000);
+  auto stateV2Full = publishAndApplyConfig(stateV1, &config, platform.get());
+  ASSERT_NE(nullptr, stateV2Full);
+  for (const auto& acl : *config.acls()) {
+    EXPECT_EQ(
+        *stateV2->getAcl(*acl.name()), *stateV2Full->getAcl(*acl.name()));
+  }
+
+  // ACLs modified since the previous config was applied are re-evaluated
+  // even though their config is unchanged
+  prevApplied = PrevAppliedConfig{
+      configSectionFingerprints(config), configDerivedSections(stateV2)};
+  auto stateV3 = stateV2->clone();
+  stateV3->resetAcls(make_shared<MultiSwitchAclMap>());
+  auto stateV4 = publishAndApplyConfig(
+      stateV3, &config, platform.get(), nullptr, &prevApplied);
+  ASSERT_NE(nullptr, stateV4);
+  EXPECT_EQ(stateV4->getAcls()->numNodes(), config.acls()->size());
+}
+
+TEST(Acl, ParallelConfigApplyMatchesSerial) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  cfg::SwitchConfig config;
+  cfg::TrafficPolicyConfig dataPlaneTrafficPolicy;
+  for (int i = 0; i < 100; ++i) {
+    auto name = folly::to<std::string>("acl", i);
+    cfg::AclEntry acl;
+    *acl.name() = name;
+    *acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.l4SrcPort() = 1000 + i;
+    config.acls()->push_back(acl);
+
+    cfg::TrafficCounter counter;
+    *counter.name() = name;
+    config.trafficCounters()->push_back(counter);
+
+    cfg::MatchToAction matchToAction;
+    *matchToAction.matcher() = name;
+    matchToAction.action()->counter() = name;
+    dataPlaneTrafficPolicy.matchToAction()->push_back(matchToAction);
+  }
+  config.dataPlaneTrafficPolicy() = dataPlaneTrafficPolicy;
+
+  auto serialState = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, serialState);
+  FLAGS_config_apply_threads = 4;
+  auto parallelState = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, parallelState);
+  EXPECT_EQ(serialState->toThrift(), parallelState->toThrift());
+
+  // Errors raised by concurrently evaluated sections are still surfaced
+  config.dataPlaneTrafficPolicy()->matchToAction()->at(0).action()->counter() =
+      "missing";
+  EXPECT_THROW(
+      publishAndApplyConfig(stateV0, &config, platform.get()), FbossError);
+}
@@ -0,0 +1,63 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/state/SwitchStateMemoryUsage.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kPortMaps = "portMaps";
+
+HwSwitchMatcher scope() {
+  return HwSwitchMatcher{std::unordered_set<SwitchID>{SwitchID(0)}};
+}
+
+std::shared_ptr<SwitchState> makeState() {
+  auto state = std::make_shared<SwitchState>();
+  registerPort(state, PortID(1), "port1", scope());
+  registerPort(state, PortID(2), "port2", scope());
+  state->publish();
+  return state;
+}
+} // namespace
+
+TEST(SwitchStateMemoryUsage, NothingSharedWithoutOtherStates) {
+  auto usage = computeSwitchStateMemoryUsage(makeState());
+
+  ASSERT_EQ(usage.count(kPortMaps), 1);
+  const auto& portsUsage = usage.at(kPortMaps);
+  // Multi switch map, port map and both ports
+  EXPECT_GE(*portsUsage.numNodes(), 4);
+  EXPECT_GT(*portsUsage.bytes(), 0);
+  for (const auto& [subtree, subtreeUsage] : usage) {
+    EXPECT_EQ(*subtreeUsage.numSharedNodes(), 0) << subtree;
+    EXPECT_EQ(*subtreeUsage.sharedBytes(), 0) << subtree;
+  }
+}
+
+TEST(SwitchStateMemoryUsage, UnmodifiedNodesSharedWithPreviousState) {
+  auto stateV0 = makeState();
+  auto stateV1 = stateV0->clone();
+  auto port = stateV1->getPorts()->getNodeIf(PortID(1))->modify(&stateV1);
+  port->setDescription("modified");
+  stateV1->publish();
+
+  auto usage = computeSwitchStateMemoryUsage(stateV1);
+  // port2 and its subtree are still referenced by stateV0
+  const auto& portsUsage = usage.at(kPortMaps);
+  EXPECT_GT(*portsUsage.sharedBytes(), 0);
+  EXPECT_LT(*portsUsage.sharedBytes(), *portsUsage.bytes());
+  EXPECT_GT(*portsUsage.numSharedNodes(), 0);
+  EXPECT_LT(*portsUsage.numSharedNodes(), *portsUsage.numNodes());
+
+  // Once the previous state is gone, stateV1 owns everything
+  stateV0.reset();
+  for (const auto& [subtree, subtreeUsage] :
+       computeSwitchStateMemoryUsage(stateV1)) {
+    EXPECT_EQ(*subtreeUsage.sharedBytes(), 0) << subtree;
+  }
+}
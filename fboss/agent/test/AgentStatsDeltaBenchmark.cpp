@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/AgentStatsFsdbSyncManager.h"
+#include "fboss/fsdb/common/Utils.h"
+
+using namespace facebook::fboss;
+
+namespace {
+static constexpr int kNumQueues = 8;
+static constexpr int kNumCycles = 10;
+const std::vector<std::string> kStatsPath{"agent"};
+
+AgentStats makeStats(int numPorts) {
+  AgentStats stats;
+  std::map<std::string, HwSysPortStats> sysPortStats;
+  for (auto i = 0; i < numPorts; ++i) {
+    auto portName = folly::to<std::string>("eth1/", i / 4 + 1, "/", i % 4 + 1);
+    HwPortStats portStats;
+    portStats.portName_() = portName;
+    portStats.inBytes_() = 0;
+    portStats.outBytes_() = 0;
+    HwSysPortStats sysPortStat;
+    sysPortStat.portName_() = portName;
+    for (int16_t queue = 0; queue < kNumQueues; ++queue) {
+      portStats.queueOutBytes_()->emplace(queue, 0);
+      sysPortStat.queueOutBytes_()->emplace(queue, 0);
+      sysPortStat.queueWatermarkBytes_()->emplace(queue, 0);
+    }
+    stats.hwPortStats()->emplace(portName, std::move(portStats));
+    sysPortStats.emplace(
+        folly::to<std::string>("rdsw001:", portName), std::move(sysPortStat));
+  }
+  stats.sysPortStatsMap()->emplace(0, std::move(sysPortStats));
+  return stats;
+}
+
+/*
+ * Advance stats as a stats interval would: every port and system port gets
+ * a new timestamp and carries traffic on one of its queues, while the
+ * remaining counters (errors, discards, other queues) stay put.
+ */
+void advanceStats(AgentStats& stats, int cycle) {
+  for (auto& [_, portStats] : *stats.hwPortStats()) {
+    portStats.timestamp_() = cycle;
+    *portStats.inBytes_() += 1000;
+    *portStats.outBytes_() += 1000;
+    (*portStats.queueOutBytes_())[0] += 1000;
+  }
+  for (auto& switchSysPortStats : *stats.sysPortStatsMap()) {
+    for (auto& [_, sysPortStat] : switchSysPortStats.second) {
+      sysPortStat.timestamp_() = cycle;
+      (*sysPortStat.queueOutBytes_())[0] += 1000;
+      (*sysPortStat.queueWatermarkBytes_())[0] = 100 * (cycle % 4);
+    }
+  }
+  *stats.linkFlaps() += 1;
+}
+
+void publishFullStats(folly::UserCounters& counters, int numPorts) {
+  AgentStats stats;
+  BENCHMARK_SUSPEND {
+    stats = makeStats(numPorts);
+  }
+  size_t bytes{0};
+  for (auto cycle = 1; cycle <= kNumCycles; ++cycle) {
+    BENCHMARK_SUSPEND {
+      advanceStats(stats, cycle);
+    }
+    // Mirrors FsdbSyncer::statsUpdated in path publish mode
+    bytes += apache::thrift::BinarySerializer::serialize<std::string>(stats)
+                 .size();
+  }
+  counters["bytes_per_cycle"] = bytes / kNumCycles;
+}
+
+void publishDeltaStats(folly::UserCounters& counters, int numPorts) {
+  using CowAgentStats = AgentStatsFsdbSyncManager::CowAgentStats;
+  AgentStats stats;
+  std::shared_ptr<CowAgentStats> published;
+  BENCHMARK_SUSPEND {
+    stats = makeStats(numPorts);
+    published = std::make_shared<CowAgentStats>(stats);
+    published->publish();
+  }
+  size_t bytes{0};
+  for (auto cycle = 1; cycle <= kNumCycles; ++cycle) {
+    BENCHMARK_SUSPEND {
+      advanceStats(stats, cycle);
+    }
+    // Mirrors AgentStatsFsdbSyncManager::statsUpdated and the delta
+    // FsdbSyncManager computes and publishes for it
+    auto next = AgentStatsFsdbSyncManager::applyStatsDelta(published, stats);
+    next->publish();
+    auto delta = fsdb::computeOperDelta(published, next, kStatsPath);
+    bytes += apache::thrift::BinarySerializer::serialize<std::string>(delta)
+                 .size();
+    published = std::move(next);
+  }
+  counters["bytes_per_cycle"] = bytes / kNumCycles;
+}
+} // namespace
+
+BENCHMARK_COUNTERS(AgentStatsFullPublish128Ports, counters) {
+  publishFullStats(counters, 128);
+}
+
+BENCHMARK_COUNTERS(AgentStatsDeltaPublish128Ports, counters) {
+  publishDeltaStats(counters, 128);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_COUNTERS(AgentStatsFullPublish256Ports, counters) {
+  publishFullStats(counters, 256);
+}
+
+BENCHMARK_COUNTERS(AgentStatsDeltaPublish256Ports, counters) {
+  publishDeltaStats(counters, 256);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_COUNTERS(AgentStatsFullPublish512Ports, counters) {
+  publishFullStats(counters, 512);
+}
+
+BENCHMARK_COUNTERS(AgentStatsDeltaPublish512Ports, counters) {
+  publishDeltaStats(counters, 512);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AgentStatsFsdbSyncManager.h"
+#include "fboss/agent/hw/gen-cpp2/hardware_stats_fatal_types.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+using CowAgentStats = AgentStatsFsdbSyncManager::CowAgentStats;
+using k = agent_stats_tags::strings;
+using hw_k = hardware_stats_tags::strings;
+
+const std::string kPort1 = "eth1/1/1";
+const std::string kPort2 = "eth1/2/1";
+const std::string kSysPort1 = "rdsw001:eth1/1/1";
+const std::string kSysPort2 = "rdsw001:eth1/2/1";
+
+AgentStats makeStats() {
+  AgentStats stats;
+  for (const auto& portName : {kPort1, kPort2}) {
+    HwPortStats portStats;
+    portStats.portName_() = portName;
+    portStats.inBytes_() = 0;
+    portStats.timestamp_() = 0;
+    portStats.queueOutBytes_() = {{0, 0}, {1, 0}};
+    stats.hwPortStats()->emplace(portName, std::move(portStats));
+  }
+  std::map<std::string, HwSysPortStats> sysPortStats;
+  for (const auto& sysPortName : {kSysPort1, kSysPort2}) {
+    HwSysPortStats sysPortStat;
+    sysPortStat.timestamp_() = 0;
+    sysPortStat.queueOutBytes_() = {{0, 0}, {1, 0}};
+    sysPortStats.emplace(sysPortName, std::move(sysPortStat));
+  }
+  stats.sysPortStatsMap()->emplace(0, std::move(sysPortStats));
+  return stats;
+}
+
+std::shared_ptr<CowAgentStats> publish(const AgentStats& stats) {
+  auto node = std::make_shared<CowAgentStats>(stats);
+  node->publish();
+  return node;
+}
+} // namespace
+
+TEST(AgentStatsFsdbSyncManagerTest, unchangedStatsShareAllChildren) {
+  auto stats = makeStats();
+  auto published = publish(stats);
+
+  auto next = AgentStatsFsdbSyncManager::applyStatsDelta(published, stats);
+
+  EXPECT_EQ(next->toThrift(), stats);
+  EXPECT_EQ(next->get<k::hwPortStats>(), published->get<k::hwPortStats>());
+  EXPECT_EQ(
+      next->get<k::sysPortStatsMap>(), published->get<k::sysPortStatsMap>());
+}
+
+TEST(AgentStatsFsdbSyncManagerTest, onlyChangedFieldsReplaced) {
+  auto stats = makeStats();
+  auto published = publish(stats);
+
+  auto& port1 = stats.hwPortStats()->at(kPort1);
+  port1.timestamp_() = 1;
+  port1.inBytes_() = 1000;
+  auto& sysPort1 = stats.sysPortStatsMap()->at(0).at(kSysPort1);
+  sysPort1.timestamp_() = 1;
+  sysPort1.queueOutBytes_()->at(0) = 1000;
+
+  auto next = AgentStatsFsdbSyncManager::applyStatsDelta(published, stats);
+  EXPECT_EQ(next->toThrift(), stats);
+
+  // Changed port is updated in place, its unchanged members stay shared
+  const auto& oldPorts = published->cref<k::hwPortStats>();
+  const auto& newPorts = next->cref<k::hwPortStats>();
+  EXPECT_NE(newPorts->cref(kPort1), oldPorts->cref(kPort1));
+  EXPECT_EQ(
+      newPorts->cref(kPort1)->get<hw_k::queueOutBytes_>(),
+      oldPorts->cref(kPort1)->get<hw_k::queueOutBytes_>());
+  EXPECT_EQ(newPorts->cref(kPort2), oldPorts->cref(kPort2));
+
+  // Same for system ports nested in the per switch map
+  const auto& oldSysPorts = published->cref<k::sysPortStatsMap>()->cref(0);
+  const auto& newSysPorts = next->cref<k::sysPortStatsMap>()->cref(0);
+  EXPECT_NE(newSysPorts->cref(kSysPort1), oldSysPorts->cref(kSysPort1));
+  EXPECT_EQ(newSysPorts->cref(kSysPort2), oldSysPorts->cref(kSysPort2));
+}
+
+TEST(AgentStatsFsdbSyncManagerTest, addedAndRemovedEntries) {
+  auto stats = makeStats();
+  auto published = publish(stats);
+
+  stats.hwPortStats()->erase(kPort2);
+  HwPortStats port3;
+  port3.portName_() = "eth1/3/1";
+  stats.hwPortStats()->emplace("eth1/3/1", std::move(port3));
+  stats.sysPortStatsMap()->at(0).at(kSysPort1).queueOutBytes_()->erase(1);
+
+  auto next = AgentStatsFsdbSyncManager::applyStatsDelta(published, stats);
+  EXPECT_EQ(next->toThrift(), stats);
+}
@@ -11,6 +11,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Memory.h>
+#include <folly/String.h>
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/TunManager.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
@@ -33,8 +34,13 @@ using std::make_unique;
 using std::shared_ptr;
 using std::unique_ptr;
 
+DECLARE_bool(coalesce_neighbor_updates);
+
 namespace {
 
+// neighbors resolving at once, as after a ToR reboot
+static constexpr int kNumNeighbors = 4096;
+
 // Global state used by the benchmarks
 unique_ptr<SwSwitch> sw;
 unique_ptr<MockRxPacket> arpRequest_10_0_0_1;
@@ -77,6 +83,7 @@ unique_ptr<SwSwitch> setupSwitch() {
     Interface::Addresses addrs1;
     addrs1.emplace(IPAddress("10.0.0.1"), 24);
     addrs1.emplace(IPAddress("192.168.0.1"), 24);
+    addrs1.emplace(IPAddress("10.1.0.1"), 16);
     intf1->setAddresses(addrs1);
     auto allIntfs = state->getInterfaces()->modify(&state);
     allIntfs->addNode(intf1, matcher);
@@ -149,6 +156,65 @@ void init() {
   arpRequest_10_0_0_5->setSrcVlan(VlanID(1));
 }
 
+std::string toHex(const uint8_t* bytes, size_t length) {
+  return folly::hexlify(folly::ByteRange(bytes, length));
+}
+
+// ARP request for 10.0.0.1 from the given neighbor
+unique_ptr<MockRxPacket> makeArpRequest(
+    IPAddressV4 senderIP,
+    MacAddress senderMac) {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff" + toHex(senderMac.bytes(), 6) +
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+      "08 06  00 01  08 00  06  04"
+      // ARP Request
+      "00 01" +
+      // Sender MAC, sender IP
+      toHex(senderMac.bytes(), 6) + toHex(senderIP.bytes(), 4) +
+      // Target MAC
+      "00 00 00 00 00 00"
+      // Target IP: 10.0.0.1
+      "0a 00 00 01");
+  pkt->padToLength(68);
+  pkt->setSrcPort(PortID(1));
+  pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+/*
+ * Have kNumNeighbors neighbors resolve at once, and wait until all of them
+ * are programmed. Each run moves all neighbors to new MACs, so every run
+ * updates all of them.
+ */
+void learnNeighbors(bool coalesce) {
+  static uint64_t run = 0;
+  std::vector<unique_ptr<MockRxPacket>> requests;
+  BENCHMARK_SUSPEND {
+    FLAGS_coalesce_neighbor_updates = coalesce;
+    ++run;
+    auto firstIP = IPAddressV4("10.1.0.2").toLongHBO();
+    for (int i = 0; i < kNumNeighbors; ++i) {
+      auto senderIP = IPAddressV4::fromLongHBO(firstIP + i);
+      auto senderMac = MacAddress::fromHBO((0x02ULL << 40) | (run << 20) | i);
+      requests.push_back(makeArpRequest(senderIP, senderMac));
+    }
+  }
+
+  for (auto& request : requests) {
+    sw->packetReceived(std::move(request));
+  }
+  waitForNeighborCacheThread(sw.get());
+  waitForStateUpdates(sw.get());
+
+  BENCHMARK_SUSPEND {
+    FLAGS_coalesce_neighbor_updates = false;
+  }
+}
+
 } // unnamed namespace
 
 BENCHMARK(ArpRequest, numIters) {
@@ -193,6 +259,16 @@ BENCHMARK(ArpRequestNotMine, numIters) {
   }
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ArpLearnNeighbors) {
+  learnNeighbors(false);
+}
+
+BENCHMARK_RELATIVE(ArpLearnNeighborsCoalesced) {
+  learnNeighbors(true);
+}
+
 int main(int argc, char** argv) {
   gflags::ParseCommandLineFlags(&argc, &argv, true);
 
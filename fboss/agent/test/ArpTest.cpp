@@ -9,8 +9,10 @@
  */
 #include <fb303/ServiceData.h>
 #include <folly/Memory.h>
+#include <folly/ScopeGuard.h>
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
+#include <folly/synchronization/Baton.h>
 #include "fboss/agent/AddressUtil.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
@@ -42,6 +44,8 @@
 #include <future>
 #include <string>
 
+DECLARE_bool(coalesce_neighbor_updates);
+
 using namespace facebook::fboss;
 using facebook::network::toBinaryAddress;
 using facebook::network::toIPAddress;
@@ -913,6 +917,56 @@ TYPED_TEST(ArpTest, FlushEntry) {
       thriftHandler.flushNeighborEntry(std::move(binAddrPtr), 123), FbossError);
 }
 
+TYPED_TEST(ArpTest, CoalescedUpdates) {
+  FLAGS_coalesce_neighbor_updates = true;
+  SCOPE_EXIT {
+    FLAGS_coalesce_neighbor_updates = false;
+  };
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  // Hold the update thread until the replies below are all queued, so that
+  // none of them is applied ahead of the others
+  folly::Baton<> queued;
+  sw->updateState(
+      "wait for queued neighbor updates",
+      [&queued](const std::shared_ptr<SwitchState>& /* state */) {
+        queued.wait();
+        return std::shared_ptr<SwitchState>();
+      });
+
+  // Send ARP replies from several nodes of the same VLAN, batched into a
+  // single state update
+  EXPECT_STATE_UPDATE_TIMES(sw, 1);
+  sendArpReply(handle.get(), "10.0.0.11", "02:10:20:30:40:11", 2);
+  sendArpReply(handle.get(), "10.0.0.15", "02:10:20:30:40:15", 3);
+  sendArpReply(handle.get(), "10.0.0.7", "02:10:20:30:40:07", 1);
+  sendArpReply(handle.get(), "10.0.0.22", "02:10:20:30:40:22", 4);
+  waitForNeighborCacheThread(sw);
+  queued.post();
+  waitForStateUpdates(sw);
+
+  auto arpTable = this->getArpTable(sw, VlanID(1), InterfaceID(1));
+  EXPECT_EQ(arpTable->size(), 4);
+  auto entry = arpTable->getEntryIf(IPAddressV4("10.0.0.15"));
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->getMac(), MacAddress("02:10:20:30:40:15"));
+  EXPECT_EQ(entry->getPort(), PortDescriptor(PortID(3)));
+  EXPECT_FALSE(entry->isPending());
+
+  // A blocking flush applies the queued flush before returning
+  EXPECT_STATE_UPDATE_TIMES(sw, 1);
+  ThriftHandler thriftHandler(sw);
+  auto binAddr = toBinaryAddress(IPAddressV4("10.0.0.11"));
+  auto numFlushed =
+      thriftHandler.flushNeighborEntry(make_unique<BinaryAddress>(binAddr), 1);
+  EXPECT_EQ(numFlushed, 1);
+  waitForStateUpdates(sw);
+  arpTable = this->getArpTable(sw, VlanID(1), InterfaceID(1));
+  EXPECT_EQ(arpTable->size(), 3);
+  EXPECT_EQ(arpTable->getEntryIf(IPAddressV4("10.0.0.11")), nullptr);
+}
+
 TYPED_TEST(ArpTest, PendingArp) {
   // Keep test disabled for intf nbr tables because pending neighbor entries are
   // currently not stored in intfs.
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/AgentFeatures.h"
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+namespace facebook::fboss {
+
+namespace {
+// roughly the ACL scale of a production switch config
+static constexpr int kNumAcls = 2000;
+static constexpr int kNumChanges = 10;
+static constexpr int kNumQosPolicies = 64;
+static constexpr int kConfigApplyThreads = 4;
+
+cfg::SwitchConfig makeConfig(
+    cfg::SwitchType switchType = cfg::SwitchType::NPU) {
+  auto config = testConfigA(switchType);
+  cfg::TrafficPolicyConfig dataPlaneTrafficPolicy;
+  for (int i = 0; i < kNumAcls; ++i) {
+    auto name = folly::to<std::string>("acl", i);
+    cfg::AclEntry acl;
+    acl.name() = name;
+    acl.actionType() = cfg::AclActionType::PERMIT;
+    acl.l4SrcPort() = 1000 + i;
+    acl.dscp() = i % 64;
+    config.acls()->push_back(acl);
+
+    cfg::TrafficCounter counter;
+    counter.name() = name;
+    config.trafficCounters()->push_back(counter);
+
+    cfg::MatchToAction matchToAction;
+    matchToAction.matcher() = name;
+    matchToAction.action()->counter() = name;
+    dataPlaneTrafficPolicy.matchToAction()->push_back(matchToAction);
+  }
+  config.dataPlaneTrafficPolicy() = dataPlaneTrafficPolicy;
+  for (int i = 0; i < kNumQosPolicies; ++i) {
+    cfg::QosPolicy policy;
+    policy.name() = folly::to<std::string>("qos", i);
+    for (int queue = 0; queue < 8; ++queue) {
+      cfg::QosRule rule;
+      rule.queueId() = queue;
+      rule.dscp() = {static_cast<int16_t>((queue * 8 + i) % 64)};
+      policy.rules()->push_back(rule);
+    }
+    config.qosPolicies()->push_back(policy);
+  }
+  return config;
+}
+
+/*
+ * Apply a full VOQ switch config to an empty switch state, as on cold boot.
+ */
+void applyColdBootConfig(int numThreads) {
+  std::unique_ptr<MockPlatform> platform;
+  cfg::SwitchConfig config;
+  std::shared_ptr<SwitchState> state;
+  BENCHMARK_SUSPEND {
+    FLAGS_config_apply_threads = numThreads;
+    platform = createMockPlatform(cfg::SwitchType::VOQ, 1);
+    config = makeConfig(cfg::SwitchType::VOQ);
+    state = std::make_shared<SwitchState>();
+    addSwitchInfo(state, cfg::SwitchType::VOQ, 1 /* switchId */);
+  }
+  for (int i = 0; i < kNumChanges; ++i) {
+    auto newState = publishAndApplyConfig(state, &config, platform.get());
+    BENCHMARK_SUSPEND {
+      CHECK(newState);
+    }
+  }
+  BENCHMARK_SUSPEND {
+    FLAGS_config_apply_threads = 0;
+  }
+}
+
+/*
+ * Apply a series of one line port description changes, with or without the
+ * previously applied config available to skip unchanged sections.
+ */
+void applyOneLineChanges(bool usePrevAppliedConfig) {
+  std::unique_ptr<HwTestHandle> handle;
+  std::unique_ptr<MockPlatform> platform;
+  cfg::SwitchConfig config;
+  std::shared_ptr<SwitchState> state;
+  std::optional<PrevAppliedConfig> prevApplied;
+  BENCHMARK_SUSPEND {
+    config = makeConfig();
+    handle = createTestHandle(&config);
+    platform = createMockPlatform();
+    state = handle->getSw()->getState();
+  }
+  for (int i = 0; i < kNumChanges; ++i) {
+    BENCHMARK_SUSPEND {
+      if (usePrevAppliedConfig) {
+        prevApplied = PrevAppliedConfig{
+            configSectionFingerprints(config), configDerivedSections(state)};
+      }
+      config.ports()->at(0).description() =
+          folly::to<std::string>("change", i);
+    }
+    auto newState = publishAndApplyConfig(
+        state,
+        &config,
+        platform.get(),
+        nullptr /* rib */,
+        prevApplied ? &prevApplied.value() : nullptr);
+    BENCHMARK_SUSPEND {
+      CHECK(newState);
+      state = newState;
+    }
+  }
+}
+} // namespace
+
+BENCHMARK(ApplyOneLineChangeFull) {
+  applyOneLineChanges(false);
+}
+
+BENCHMARK_RELATIVE(ApplyOneLineChangeIncremental) {
+  applyOneLineChanges(true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ApplyVoqConfigSerial) {
+  applyColdBootConfig(0);
+}
+
+BENCHMARK_RELATIVE(ApplyVoqConfigParallel) {
+  applyColdBootConfig(kConfigApplyThreads);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
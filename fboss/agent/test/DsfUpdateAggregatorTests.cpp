@@ -0,0 +1,176 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/DsfUpdateAggregator.h"
+#include "fboss/agent/AgentFeatures.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/SystemPortMap.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+#include "fboss/lib/CommonUtils.h"
+
+#include <folly/Conv.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+namespace facebook::fboss {
+namespace {
+constexpr auto kRemoteSwitchIdBegin = 4;
+constexpr auto kSysPortBlockSize = 50;
+
+using ::testing::_;
+
+std::map<SwitchID, std::shared_ptr<SystemPortMap>> makeSysPorts(
+    SwitchID switchId) {
+  auto sysPorts = std::make_shared<SystemPortMap>();
+  sysPorts->addNode(
+      makeSysPort(std::nullopt, switchId * kSysPortBlockSize + 1, switchId));
+  return {{switchId, sysPorts}};
+}
+} // namespace
+
+class DsfUpdateAggregatorTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto config = testConfigA(cfg::SwitchType::VOQ);
+    handle_ = createTestHandle(&config);
+    sw_ = handle_->getSw();
+    aggregator_ = std::make_unique<DsfUpdateAggregator>(
+        sw_, hwUpdateThread_->getEventBase());
+  }
+
+  void TearDown() override {
+    FLAGS_dsf_update_batch_window_ms = 0;
+    // Let any batch in flight finish before the aggregator goes away
+    hwUpdateThread_.reset();
+    aggregator_.reset();
+  }
+
+  void queueUpdate(
+      const std::string& peer,
+      SwitchID switchId,
+      std::atomic<int>* failures = nullptr) {
+    aggregator_->queueUpdate(peer, makeSysPorts(switchId), {}, [failures]() {
+      if (failures) {
+        (*failures)++;
+      }
+    });
+  }
+
+  size_t numRemoteSysPorts() const {
+    return numRemoteSysPorts(sw_->getState());
+  }
+
+  static size_t numRemoteSysPorts(const std::shared_ptr<SwitchState>& state) {
+    return state->getRemoteSystemPorts()->getAllNodes()->size();
+  }
+
+  static bool hasRemoteSysPort(
+      const std::shared_ptr<SwitchState>& state,
+      SwitchID switchId) {
+    return state->getRemoteSystemPorts()->getNodeIf(
+               SystemPortID(switchId * kSysPortBlockSize + 1)) != nullptr;
+  }
+
+ protected:
+  std::unique_ptr<HwTestHandle> handle_;
+  SwSwitch* sw_;
+  std::unique_ptr<folly::ScopedEventBaseThread> hwUpdateThread_{
+      std::make_unique<folly::ScopedEventBaseThread>("DsfHwUpdate")};
+  std::unique_ptr<DsfUpdateAggregator> aggregator_;
+};
+
+TEST_F(DsfUpdateAggregatorTest, updatesOfAllPeersAreApplied) {
+  FLAGS_dsf_update_batch_window_ms = 100;
+  queueUpdate("peer1", SwitchID(kRemoteSwitchIdBegin));
+  queueUpdate("peer2", SwitchID(kRemoteSwitchIdBegin + 1));
+
+  // Both peers were queued within the window, so they show up together
+  WITH_RETRIES(ASSERT_EVENTUALLY_GT(numRemoteSysPorts(), 0));
+  EXPECT_EQ(numRemoteSysPorts(), 2);
+}
+
+TEST_F(DsfUpdateAggregatorTest, failedPeerDoesNotBlockOthers) {
+  auto localSwitchId = *sw_->getSwitchInfoTable().getSwitchIDs().begin();
+  std::atomic<int> goodPeerFailures{0};
+  std::atomic<int> badPeerFailures{0};
+  FLAGS_dsf_update_batch_window_ms = 100;
+  queueUpdate("good", SwitchID(kRemoteSwitchIdBegin), &goodPeerFailures);
+  queueUpdate("bad", localSwitchId, &badPeerFailures);
+
+  WITH_RETRIES({
+    ASSERT_EVENTUALLY_EQ(badPeerFailures.load(), 1);
+    ASSERT_EVENTUALLY_EQ(numRemoteSysPorts(), 1);
+  });
+  EXPECT_EQ(goodPeerFailures.load(), 0);
+}
+
+TEST_F(DsfUpdateAggregatorTest, cancelledUpdateIsDropped) {
+  FLAGS_dsf_update_batch_window_ms = 100;
+  queueUpdate("peer1", SwitchID(kRemoteSwitchIdBegin));
+  aggregator_->cancelUpdate("peer1");
+  queueUpdate("peer2", SwitchID(kRemoteSwitchIdBegin + 1));
+
+  WITH_RETRIES(ASSERT_EVENTUALLY_EQ(numRemoteSysPorts(), 1));
+  EXPECT_NE(
+      sw_->getState()->getRemoteSystemPorts()->getNodeIf(SystemPortID(
+          (kRemoteSwitchIdBegin + 1) * kSysPortBlockSize + 1)),
+      nullptr);
+}
+
+TEST_F(DsfUpdateAggregatorTest, peerFailingHwProgrammingIsRetriedAlone) {
+  auto goodSwitchId = SwitchID(kRemoteSwitchIdBegin);
+  auto badSwitchId = SwitchID(kRemoteSwitchIdBegin + 1);
+  // Hw rejects any state with the sysports of the bad peer, which rolls
+  // back the whole batch
+  auto rejectedUpdates = std::make_shared<std::atomic<int>>(0);
+  EXPECT_HW_CALL(sw_, stateChangedImpl(_))
+      .WillRepeatedly(::testing::Invoke([=](const StateDelta& delta) {
+        if (hasRemoteSysPort(delta.newState(), badSwitchId)) {
+          (*rejectedUpdates)++;
+          return delta.oldState();
+        }
+        return delta.newState();
+      }));
+
+  std::atomic<int> goodPeerFailures{0};
+  std::atomic<int> badPeerFailures{0};
+  FLAGS_dsf_update_batch_window_ms = 100;
+  queueUpdate("good", goodSwitchId, &goodPeerFailures);
+  queueUpdate("bad", badSwitchId, &badPeerFailures);
+
+  WITH_RETRIES(ASSERT_EVENTUALLY_EQ(badPeerFailures.load(), 1));
+  // Once for the batch and once for the bad peer on its own
+  EXPECT_EQ(rejectedUpdates->load(), 2);
+  EXPECT_EQ(goodPeerFailures.load(), 0);
+  EXPECT_TRUE(hasRemoteSysPort(sw_->getState(), goodSwitchId));
+  EXPECT_FALSE(hasRemoteSysPort(sw_->getState(), badSwitchId));
+}
+
+TEST_F(DsfUpdateAggregatorTest, peersQueuedInWindowShareOneStateUpdate) {
+  auto sysPortUpdates = std::make_shared<std::atomic<int>>(0);
+  EXPECT_HW_CALL(sw_, stateChangedImpl(_))
+      .WillRepeatedly(::testing::Invoke([=](const StateDelta& delta) {
+        if (numRemoteSysPorts(delta.oldState()) !=
+            numRemoteSysPorts(delta.newState())) {
+          (*sysPortUpdates)++;
+        }
+        return delta.newState();
+      }));
+
+  constexpr auto kNumPeers = 5;
+  FLAGS_dsf_update_batch_window_ms = 100;
+  for (int i = 0; i < kNumPeers; ++i) {
+    queueUpdate(
+        folly::to<std::string>("peer", i), SwitchID(kRemoteSwitchIdBegin + i));
+  }
+
+  WITH_RETRIES(ASSERT_EVENTUALLY_EQ(numRemoteSysPorts(), kNumPeers));
+  EXPECT_EQ(sysPortUpdates->load(), 1);
+}
+
+} // namespace facebook::fboss
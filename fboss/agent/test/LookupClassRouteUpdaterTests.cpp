@@ -1247,6 +1247,27 @@ TYPED_TEST(LookupClassRouteUpdaterTest, PortLookupClassesChange) {
       this->kroutePrefix1(), cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_3);
 }
 
+TYPED_TEST(LookupClassRouteUpdaterTest, PortLookupClassesRemoveAndRestore) {
+  this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
+  this->resolveNeighbor(this->kIpAddressA(), this->kMacAddressA());
+
+  // Subnet is dropped from the cache and added back
+  this->updateLookupClasses({});
+  this->verifyClassIDHelper(this->kroutePrefix1(), std::nullopt);
+  this->updateLookupClasses(
+      {cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0,
+       cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_1,
+       cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_2,
+       cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_3,
+       cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_4});
+  this->verifyClassIDHelper(
+      this->kroutePrefix1(), cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0);
+
+  // Nexthop is tracked again, so losing the neighbor clears the classID
+  this->unresolveNeighbor(this->kIpAddressA());
+  this->verifyClassIDHelper(this->kroutePrefix1(), std::nullopt);
+}
+
 TYPED_TEST(LookupClassRouteUpdaterTest, CompeteClassIdUpdatesWithRouteUpdates) {
   this->addRoute(this->kroutePrefix1(), {this->kIpAddressA()});
   std::thread classIdUpdates([this]() {
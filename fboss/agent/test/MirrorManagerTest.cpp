@@ -1348,4 +1348,69 @@ TYPED_TEST(MirrorManagerTest, UpdateRoute) {
     EXPECT_EQ(egressPort, params.neighborPorts[0]);
   });
 }
+
+TYPED_TEST(MirrorManagerTest, ReResolveOnlyOnAffectingRouteChange) {
+  using AddrT = typename TestFixture::AddrT;
+  const auto params = this->getParamsHelper();
+  this->updateState(
+      "ReResolveOnlyOnAffectingRouteChange: addNode",
+      [=](const std::shared_ptr<SwitchState>& state) {
+        auto updatedState =
+            this->addErspanMirror(state, kMirrorName, params.mirrorDestination);
+        updatedState = this->addNeighbor(
+            updatedState,
+            params.interfaces[0],
+            params.neighborIPs[0],
+            params.neighborMACs[0],
+            params.neighborPorts[0]);
+        updatedState = this->addNeighbor(
+            updatedState,
+            params.interfaces[1],
+            params.neighborIPs[1],
+            params.neighborMACs[1],
+            params.neighborPorts[1]);
+        return updatedState;
+      });
+  this->addRoute(params.shorterPrefix, {params.nextHop(1)});
+  // Mirror resolution is applied in an update of its own
+  waitForStateUpdates(this->sw_);
+  auto state = waitForStateUpdates(this->sw_);
+  auto mirror = state->getMirrors()->getNodeIf(kMirrorName);
+  ASSERT_NE(mirror, nullptr);
+  ASSERT_TRUE(mirror->isResolved());
+  EXPECT_EQ(
+      mirror->getEgressPortDesc().value().phyPortID(), params.neighborPorts[1]);
+
+  // A manager of our own, to tell which deltas the mirror is re-resolved for
+  MirrorManager mirrorManager(this->sw_);
+  EXPECT_TRUE(mirrorManager.processDelta(
+      StateDelta(std::make_shared<SwitchState>(), state)));
+  mirrorManager.resolvePendingMirrors(state);
+
+  // A route to some other destination leaves the mirror alone
+  RoutePrefix<AddrT> otherPrefix = std::is_same_v<AddrT, IPAddressV4>
+      ? RoutePrefix<AddrT>{AddrT("200.0.0.0"), 24}
+      : RoutePrefix<AddrT>{AddrT("2000::"), 64};
+  this->addRoute(otherPrefix, {params.nextHop(0)});
+  auto otherRouteState = waitForStateUpdates(this->sw_);
+  EXPECT_FALSE(
+      mirrorManager.processDelta(StateDelta(state, otherRouteState)));
+
+  // A more specific route to the destination takes over. Keep the mirror as
+  // resolved before, so that the delta is just the route.
+  this->addRoute(params.longerPrefix, {params.nextHop(0)});
+  waitForStateUpdates(this->sw_);
+  auto longerRouteState =
+      this->updateMirror(waitForStateUpdates(this->sw_), mirror);
+  longerRouteState->publish();
+  EXPECT_TRUE(mirrorManager.processDelta(
+      StateDelta(otherRouteState, longerRouteState)));
+  auto resolvedState = mirrorManager.resolvePendingMirrors(longerRouteState);
+  ASSERT_NE(resolvedState, nullptr);
+  auto resolvedMirror = resolvedState->getMirrors()->getNodeIf(kMirrorName);
+  ASSERT_TRUE(resolvedMirror->isResolved());
+  EXPECT_EQ(
+      resolvedMirror->getEgressPortDesc().value().phyPortID(),
+      params.neighborPorts[0]);
+}
 } // namespace facebook::fboss
@@ -0,0 +1,148 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/ResolutionDependencyIndex.h"
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/IPAddress.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <set>
+#include <string>
+
+using folly::IPAddress;
+
+namespace facebook::fboss {
+
+namespace {
+const IPAddress kLookupV4("10.1.4.1");
+const IPAddress kLookupV6("2803:6080:d038:3066::1");
+// On the subnets of interface 1 in testConfigA
+const IPAddress kNextHopV4("10.0.0.2");
+const IPAddress kNextHopV6("2401:db00:2110:3001::2");
+} // namespace
+
+class ResolutionDependencyIndexTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto config = testConfigA();
+    handle_ = createTestHandle(&config);
+    sw_ = handle_->getSw();
+  }
+
+ protected:
+  // Dependents affected by the state updates made by change
+  std::set<std::string> getAffected(const std::function<void()>& change) {
+    auto oldState = waitForStateUpdates(sw_);
+    change();
+    auto newState = waitForStateUpdates(sw_);
+    return index_.getAffected(StateDelta(oldState, newState));
+  }
+
+  void addRoute(const std::string& prefix) {
+    auto network = folly::IPAddress::createNetwork(prefix);
+    auto nexthop = network.first.isV4() ? kNextHopV4 : kNextHopV6;
+    auto updater = sw_->getRouteUpdater();
+    updater.addRoute(
+        RouterID(0),
+        network.first,
+        network.second,
+        ClientID(1000),
+        RouteNextHopEntry(
+            RouteNextHopSet{UnresolvedNextHop(nexthop, UCMP_DEFAULT_WEIGHT)},
+            AdminDistance::STATIC_ROUTE));
+    updater.program();
+  }
+
+  void delRoute(const std::string& prefix) {
+    auto network = folly::IPAddress::createNetwork(prefix);
+    auto updater = sw_->getRouteUpdater();
+    updater.delRoute(
+        RouterID(0), network.first, network.second, ClientID(1000));
+    updater.program();
+  }
+
+  void changeIntfMac(InterfaceID intfId, folly::MacAddress mac) {
+    sw_->updateStateBlocking(
+        "change interface mac", [=](const std::shared_ptr<SwitchState>& in) {
+          auto newState = in->clone();
+          auto intf =
+              newState->getInterfaces()->getNode(intfId)->modify(&newState);
+          intf->setMac(mac);
+          return newState;
+        });
+  }
+
+  std::unique_ptr<HwTestHandle> handle_;
+  SwSwitch* sw_;
+  ResolutionDependencyIndex index_;
+};
+
+TEST_F(ResolutionDependencyIndexTest, RouteCoveringLookupAffects) {
+  index_.setDependencies("v4", {{kLookupV4}, {}, {}});
+  index_.setDependencies("v6", {{kLookupV6}, {}, {}});
+
+  using Affected = std::set<std::string>;
+  EXPECT_EQ(getAffected([&]() { addRoute("10.1.0.0/16"); }), Affected{"v4"});
+  // A more specific route takes over the longest match
+  EXPECT_EQ(getAffected([&]() { addRoute("10.1.4.0/24"); }), Affected{"v4"});
+  EXPECT_EQ(getAffected([&]() { addRoute("10.1.4.1/32"); }), Affected{"v4"});
+  EXPECT_EQ(getAffected([&]() { delRoute("10.1.4.1/32"); }), Affected{"v4"});
+  // Routes next to, but not covering, the looked up address
+  EXPECT_EQ(getAffected([&]() { addRoute("10.1.5.0/24"); }), Affected{});
+  EXPECT_EQ(getAffected([&]() { addRoute("10.1.4.2/31"); }), Affected{});
+  EXPECT_EQ(
+      getAffected([&]() { addRoute("2803:6080:d038:3066::/64"); }),
+      Affected{"v6"});
+  EXPECT_EQ(
+      getAffected([&]() { addRoute("2803:6080:d038:3067::/64"); }),
+      Affected{});
+}
+
+TEST_F(ResolutionDependencyIndexTest, RemovedDependentIsNotAffected) {
+  index_.setDependencies("mirror0", {{kLookupV4}, {}, {}});
+  index_.setDependencies("mirror1", {{kLookupV4}, {}, {}});
+  EXPECT_EQ(index_.size(), 2);
+
+  index_.removeDependent("mirror0");
+  EXPECT_EQ(index_.size(), 1);
+  EXPECT_EQ(
+      getAffected([&]() { addRoute("10.1.4.0/24"); }),
+      std::set<std::string>{"mirror1"});
+
+  index_.removeDependent("mirror1");
+  // Removing an unknown dependent is a no-op
+  index_.removeDependent("mirror1");
+  EXPECT_EQ(index_.size(), 0);
+  EXPECT_TRUE(getAffected([&]() { delRoute("10.1.4.0/24"); }).empty());
+}
+
+TEST_F(ResolutionDependencyIndexTest, SetDependenciesReplacesPrevious) {
+  index_.setDependencies("acl", {{kLookupV4}, {}, {}});
+  index_.setDependencies("acl", {{kLookupV6}, {}, {}});
+  EXPECT_EQ(index_.size(), 1);
+
+  EXPECT_TRUE(getAffected([&]() { addRoute("10.1.4.0/24"); }).empty());
+  EXPECT_EQ(
+      getAffected([&]() { addRoute("2803:6080:d038:3066::/64"); }),
+      std::set<std::string>{"acl"});
+}
+
+TEST_F(ResolutionDependencyIndexTest, EgressInterfaceChangeAffects) {
+  index_.setDependencies("mirror", {{}, {kNextHopV4}, {InterfaceID(1)}});
+
+  auto affected = getAffected([&]() {
+    changeIntfMac(InterfaceID(1), folly::MacAddress("02:00:00:00:00:11"));
+  });
+  EXPECT_EQ(affected, std::set<std::string>{"mirror"});
+  affected = getAffected([&]() {
+    changeIntfMac(InterfaceID(55), folly::MacAddress("02:00:00:00:00:55"));
+  });
+  EXPECT_TRUE(affected.empty());
+}
+
+} // namespace facebook::fboss
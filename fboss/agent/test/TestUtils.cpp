@@ -572,20 +572,26 @@ shared_ptr<SwitchState> publishAndApplyConfig(
     const shared_ptr<SwitchState>& state,
     cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    const PrevAppliedConfig* prevAppliedConfig) {
   if (config->switchSettings()->switchIdToSwitchInfo()->empty()) {
     config->switchSettings()->switchIdToSwitchInfo() = {
         {0, createSwitchInfo(cfg::SwitchType::NPU)}};
   }
   return publishAndApplyConfig(
-      state, (const cfg::SwitchConfig*)config, platform, rib);
+      state,
+      (const cfg::SwitchConfig*)config,
+      platform,
+      rib,
+      prevAppliedConfig);
 }
 
 shared_ptr<SwitchState> publishAndApplyConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    const PrevAppliedConfig* prevAppliedConfig) {
   state->publish();
   auto platformMapping = std::make_unique<MockPlatformMapping>();
   auto hwAsicTable = HwAsicTable(
@@ -600,7 +606,9 @@ shared_ptr<SwitchState> publishAndApplyConfig(
       platform->supportsAddRemovePort(),
       platformMapping.get(),
       &hwAsicTable,
-      rib);
+      rib,
+      nullptr /* aclNexthopHandler */,
+      prevAppliedConfig);
 }
 
 std::unique_ptr<SwSwitch> setupMockSwitchWithoutHW(
@@ -41,6 +41,7 @@ class SwSwitch;
 class TxPacket;
 class HwTestHandle;
 class RoutingInformationBase;
+struct PrevAppliedConfig;
 
 namespace cfg {
 class SwitchConfig;
@@ -111,13 +112,15 @@ std::shared_ptr<SwitchState> publishAndApplyConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    const PrevAppliedConfig* prevAppliedConfig = nullptr);
 
 std::shared_ptr<SwitchState> publishAndApplyConfig(
     const std::shared_ptr<SwitchState>& state,
     cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib = nullptr);
+    RoutingInformationBase* rib = nullptr,
+    const PrevAppliedConfig* prevAppliedConfig = nullptr);
 
 /*
  * Create a SwSwitch for testing purposes, with the specified initial state.
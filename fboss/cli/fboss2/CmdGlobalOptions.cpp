@@ -56,6 +56,16 @@ void CmdGlobalOptions::init(CLI::App& app) {
       "--aggregate-hosts",
       aggregateAcrossDevices_,
       "whether to perform aggregation across all hosts or not");
+  app.add_option(
+         "--max-parallel-hosts",
+         maxParallelHosts_,
+         "maximum number of hosts to query at the same time")
+      ->check(CLI::PositiveNumber);
+  app.add_option(
+         "--host-timeout",
+         hostTimeoutSec_,
+         "seconds to wait for the response of each host")
+      ->check(CLI::PositiveNumber);
 
   initAdditional(app);
 }
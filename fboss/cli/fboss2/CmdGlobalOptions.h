@@ -463,6 +463,14 @@ class CmdGlobalOptions {
     return color_;
   }
 
+  int getMaxParallelHosts() const {
+    return maxParallelHosts_;
+  }
+
+  int getHostTimeoutMs() const {
+    return hostTimeoutSec_ * 1000;
+  }
+
   // Setters for testing purposes
   void setSslPolicy(SSLPolicy& sslPolicy) {
     sslPolicy_ = sslPolicy;
@@ -520,6 +528,10 @@ class CmdGlobalOptions {
     aggregateAcrossDevices_ = acrossDevices;
   }
 
+  void setMaxParallelHosts(int maxParallelHosts) {
+    maxParallelHosts_ = maxParallelHosts;
+  }
+
   UnionList getFilters(cli::CliOptionResult& filterParsingEC) const;
   std::optional<AggregateOption> parseAggregate(
       cli::CliOptionResult& aggregateParsingEC) const;
@@ -557,6 +569,8 @@ class CmdGlobalOptions {
   std::string filter_;
   std::string aggregate_;
   bool aggregateAcrossDevices_{false};
+  int maxParallelHosts_{32};
+  int hostTimeoutSec_{45};
   int localDrainerThriftPort_{10701};
 };
 
@@ -11,143 +11,146 @@
 #include "fboss/cli/fboss2/CmdHandler.h"
 #include "fboss/cli/fboss2/CmdGlobalOptions.h"
 #include "fboss/cli/fboss2/utils/CmdUtilsCommon.h"
+#include "fboss/cli/fboss2/utils/ParallelHostQuery.h"
 #include "thrift/lib/cpp/util/EnumUtils.h"
 #include "thrift/lib/cpp2/protocol/Serializer.h"
 
+#include <folly/json.h>
 #include <folly/logging/xlog.h>
 #include <cstring>
-#include <future>
 #include <iostream>
 #include <stdexcept>
 
+template <typename CmdTypeT>
+using HostResult =
+    std::tuple<std::string, typename CmdTypeT::RetType, std::string>;
+
 template <typename CmdTypeT>
 void printTabular(
     CmdTypeT& cmd,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
+    const HostResult<CmdTypeT>& result,
+    bool multiHost,
     std::ostream& out,
     std::ostream& err) {
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
-      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
-    }
+  const auto& [host, data, errStr] = result;
+  if (multiHost) {
+    out << host << "::" << std::endl << std::string(80, '=') << std::endl;
+  }
 
-    if (errStr.empty()) {
-      cmd.printOutput(data);
-    } else {
-      err << errStr << std::endl << std::endl;
-    }
+  if (errStr.empty()) {
+    cmd.printOutput(data);
+  } else {
+    err << errStr << std::endl << std::endl;
   }
 }
 
+/*
+ * Prints a JSON object keyed by host, one host at a time, so that a host's
+ * response can be released as soon as it has been printed.
+ */
 template <typename CmdTypeT>
-void printJson(
-    const CmdTypeT& /* cmd */,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
-    std::ostream& err) {
-  std::map<std::string, typename CmdTypeT::RetType> hostResults;
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (errStr.empty()) {
-      hostResults[host] = data;
-    } else {
-      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
-      err << errStr << std::endl << std::endl;
+class JsonPrinter {
+ public:
+  JsonPrinter(std::ostream& out, std::ostream& err) : out_(out), err_(err) {}
+
+  void print(const HostResult<CmdTypeT>& result) {
+    const auto& [host, data, errStr] = result;
+    if (!errStr.empty()) {
+      err_ << host << "::" << std::endl << std::string(80, '=') << std::endl;
+      err_ << errStr << std::endl << std::endl;
+      return;
     }
+    out_ << (first_ ? "{" : ",") << folly::toJson(host) << ":"
+         << apache::thrift::SimpleJSONSerializer::serialize<std::string>(data);
+    first_ = false;
   }
 
-  out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
-             hostResults)
-      << std::endl;
-}
+  void finish() {
+    out_ << (first_ ? "{" : "") << "}" << std::endl;
+  }
+
+ private:
+  std::ostream& out_;
+  std::ostream& err_;
+  bool first_{true};
+};
 
 template <typename CmdTypeT>
 void printAggregate(
     const std::optional<facebook::fboss::CmdGlobalOptions::AggregateOption>&
         parsedAgg,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    const facebook::fboss::ValidAggMapType& validAggMap) {
+    const HostResult<CmdTypeT>& result,
+    const facebook::fboss::ValidAggMapType& validAggMap,
+    std::vector<double>& hostAggResults) {
+  const auto& [host, data, errStr] = result;
+  if (!errStr.empty()) {
+    std::cerr << host << "::" << std::endl
+              << std::string(80, '=') << std::endl;
+    std::cerr << errStr << std::endl << std::endl;
+    return;
+  }
+  auto aggResult = facebook::fboss::performAggregation<CmdTypeT>(
+      data, parsedAgg, validAggMap);
   if (!parsedAgg->acrossHosts) {
-    for (auto& result : results) {
-      auto [host, data, errStr] = result.get();
-      if (errStr.empty()) {
-        std::cout << host << " Aggregation result:: "
-                  << facebook::fboss::performAggregation<CmdTypeT>(
-                         data, parsedAgg, validAggMap)
-                  << std::endl;
-      } else {
-        std::cerr << host << "::" << std::endl
-                  << std::string(80, '=') << std::endl;
-        std::cerr << errStr << std::endl << std::endl;
-      }
-    }
+    std::cout << host << " Aggregation result:: " << aggResult << std::endl;
   } else {
     // double because aggregation results are doubles.
-    std::vector<double> hostAggResults;
-    for (auto& result : results) {
-      auto [host, data, errStr] = result.get();
-      if (errStr.empty()) {
-        hostAggResults.push_back(facebook::fboss::performAggregation<CmdTypeT>(
-            data, parsedAgg, validAggMap));
-      } else {
-        std::cerr << host << "::" << std::endl
-                  << std::string(80, '=') << std::endl;
-        std::cerr << errStr << std::endl << std::endl;
-      }
-    }
+    hostAggResults.push_back(aggResult);
+  }
+}
 
-    double aggregateAcrossHosts;
-    int rowNumber = 0;
-    const auto& aggOp = parsedAgg->aggOp;
-    const auto& aggColumn = parsedAgg->columnName;
-    auto it = validAggMap.find(aggColumn);
-    for (auto result : hostAggResults) {
-      if (rowNumber == 0) {
-        if (aggOp != facebook::fboss::AggregateOpEnum::COUNT) {
-          aggregateAcrossHosts =
-              (it->second)->getInitValue(std::to_string(result), aggOp);
-        } else {
-          // can't use init value from the countAgg() here, hence separate
-          // handling
-          aggregateAcrossHosts = result;
-        }
-        rowNumber += 1;
+inline void printAggregateAcrossHosts(
+    const std::optional<facebook::fboss::CmdGlobalOptions::AggregateOption>&
+        parsedAgg,
+    const std::vector<double>& hostAggResults,
+    const facebook::fboss::ValidAggMapType& validAggMap) {
+  if (!parsedAgg->acrossHosts) {
+    return;
+  }
+  double aggregateAcrossHosts;
+  int rowNumber = 0;
+  const auto& aggOp = parsedAgg->aggOp;
+  const auto& aggColumn = parsedAgg->columnName;
+  auto it = validAggMap.find(aggColumn);
+  for (auto result : hostAggResults) {
+    if (rowNumber == 0) {
+      if (aggOp != facebook::fboss::AggregateOpEnum::COUNT) {
+        aggregateAcrossHosts =
+            (it->second)->getInitValue(std::to_string(result), aggOp);
       } else {
-        switch (aggOp) {
-          case facebook::fboss::AggregateOpEnum::SUM:
-            aggregateAcrossHosts = facebook::fboss::SumAgg<double>().accumulate(
-                result, aggregateAcrossHosts);
-
-            break;
-          case facebook::fboss::AggregateOpEnum::MIN:
-            aggregateAcrossHosts = facebook::fboss::MinAgg<double>().accumulate(
-                result, aggregateAcrossHosts);
-            break;
-          case facebook::fboss::AggregateOpEnum::MAX:
-            aggregateAcrossHosts = facebook::fboss::MaxAgg<double>().accumulate(
-                result, aggregateAcrossHosts);
-            break;
-          // when aggregating counts across hosts, we need to sum them!
-          case facebook::fboss::AggregateOpEnum::COUNT:
-            aggregateAcrossHosts = facebook::fboss::SumAgg<double>().accumulate(
-                result, aggregateAcrossHosts);
-            break;
-          case facebook::fboss::AggregateOpEnum::AVG:
-            std::cerr << "Average aggregation not supported yet!" << std::endl;
-            break;
-        }
+        // can't use init value from the countAgg() here, hence separate
+        // handling
+        aggregateAcrossHosts = result;
+      }
+      rowNumber += 1;
+    } else {
+      switch (aggOp) {
+        case facebook::fboss::AggregateOpEnum::SUM:
+          aggregateAcrossHosts = facebook::fboss::SumAgg<double>().accumulate(
+              result, aggregateAcrossHosts);
+
+          break;
+        case facebook::fboss::AggregateOpEnum::MIN:
+          aggregateAcrossHosts = facebook::fboss::MinAgg<double>().accumulate(
+              result, aggregateAcrossHosts);
+          break;
+        case facebook::fboss::AggregateOpEnum::MAX:
+          aggregateAcrossHosts = facebook::fboss::MaxAgg<double>().accumulate(
+              result, aggregateAcrossHosts);
+          break;
+        // when aggregating counts across hosts, we need to sum them!
+        case facebook::fboss::AggregateOpEnum::COUNT:
+          aggregateAcrossHosts = facebook::fboss::SumAgg<double>().accumulate(
+              result, aggregateAcrossHosts);
+          break;
+        case facebook::fboss::AggregateOpEnum::AVG:
+          std::cerr << "Average aggregation not supported yet!" << std::endl;
+          break;
       }
     }
-    std::cout << "Result of aggregating across all hosts: "
-              << aggregateAcrossHosts << std::endl;
   }
+  std::cout << "Result of aggregating across all hosts: "
+            << aggregateAcrossHosts << std::endl;
 }
 
 namespace facebook::fboss {
@@ -223,37 +226,43 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::runHelper() {
   }
 
   auto hosts = getHosts();
+  parsedFilters_ = parsedFilters;
+
+  // Hosts are queried on a bounded pool and each response is rendered, then
+  // released, as soon as it arrives.
+  bool multiHost = hosts.size() != 1;
+  bool isJson = CmdGlobalOptions::getInstance()->getFmt().isJson();
+  JsonPrinter<CmdTypeT> jsonPrinter(std::cout, std::cerr);
+  std::vector<double> hostAggResults;
+  bool anyFailed = false;
+  utils::queryHostsInParallel<HostResult<CmdTypeT>>(
+      hosts,
+      CmdGlobalOptions::getInstance()->getMaxParallelHosts(),
+      [&](const std::string& host) {
+        return asyncHandler(host, parsedFilters, validFilters);
+      },
+      [&](HostResult<CmdTypeT>&& result) {
+        anyFailed |= !std::get<2>(result).empty();
+        if (parsedAggregationInput.has_value()) {
+          printAggregate<CmdTypeT>(
+              parsedAggregationInput, result, validAggs, hostAggResults);
+        } else if (isJson) {
+          jsonPrinter.print(result);
+        } else {
+          printTabular(impl(), result, multiHost, std::cout, std::cerr);
+        }
+      });
 
-  std::vector<std::shared_future<std::tuple<std::string, RetType, std::string>>>
-      futureList;
-
-  for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-                             std::launch::async,
-                             &CmdHandler::asyncHandler,
-                             this,
-                             host,
-                             parsedFilters,
-                             validFilters)
-                             .share());
-  }
-
-  if (!parsedAggregationInput.has_value()) {
-    if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
-      printJson(impl(), futureList, std::cout, std::cerr);
-    } else {
-      printTabular(impl(), futureList, std::cout, std::cerr);
-    }
-  } else {
-    printAggregate<CmdTypeT>(parsedAggregationInput, futureList, validAggs);
+  if (parsedAggregationInput.has_value()) {
+    printAggregateAcrossHosts(
+        parsedAggregationInput, hostAggResults, validAggs);
+  } else if (isJson) {
+    jsonPrinter.finish();
   }
 
-  for (auto& fut : futureList) {
-    auto [host, data, errStr] = fut.get();
-    // exit with failure if any of the calls failed
-    if (!errStr.empty()) {
-      throw std::runtime_error("Error in command execution");
-    }
+  // exit with failure if any of the calls failed
+  if (anyFailed) {
+    throw std::runtime_error("Error in command execution");
   }
 }
 
@@ -129,6 +129,16 @@ class CmdHandler {
     return {"localhost"};
   }
 
+  /*
+   * Filters given with --filter. Commands whose thrift API can narrow down
+   * what it returns may consult these in queryClient() so that hosts send
+   * less data, see getFilterEqValues(). The filters are still applied to the
+   * response afterwards, so pushing them down is only an optimization.
+   */
+  const CmdGlobalOptions::UnionList& getParsedFilters() const {
+    return parsedFilters_;
+  }
+
  private:
   RetType queryClientHelper(const HostInfo& hostInfo) {
     using ArgTypes = resolve_arg_types<CmdTypeT>;
@@ -145,22 +155,31 @@ class CmdHandler {
       const std::string& host,
       const CmdGlobalOptions::UnionList& parsedFilters,
       const ValidFilterMapType& validFilterMap) {
-    auto hostInfo = HostInfo(host);
-    XLOG(DBG2) << "host: " << host << " ip: " << hostInfo.getIpStr();
-
     std::string errStr;
     RetType result;
     try {
+      // Resolving the host may throw too, report it as that host's failure
+      auto hostInfo = HostInfo(host);
+      XLOG(DBG2) << "host: " << host << " ip: " << hostInfo.getIpStr();
       result = queryClientHelper(hostInfo);
     } catch (std::exception const& err) {
       errStr = folly::to<std::string>("Thrift call failed: '", err.what(), "'");
     }
-    if (!parsedFilters.empty()) {
-      result = filterOutput<CmdTypeT>(result, parsedFilters, validFilterMap);
+    // Filter on the worker so only the matching entries wait to be printed
+    if (!parsedFilters.empty() && errStr.empty()) {
+      try {
+        result = filterOutput<CmdTypeT>(
+            std::move(result), parsedFilters, validFilterMap);
+      } catch (std::exception const& err) {
+        errStr = folly::to<std::string>("Filtering failed: '", err.what(), "'");
+      }
     }
 
-    return std::make_tuple(host, result, errStr);
+    return std::make_tuple(host, std::move(result), errStr);
   }
+
+  // Set once before hosts are queried, read only afterwards
+  CmdGlobalOptions::UnionList parsedFilters_;
 };
 
 } // namespace facebook::fboss
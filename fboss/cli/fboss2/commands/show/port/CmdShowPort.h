@@ -53,22 +53,43 @@ class CmdShowPort : public CmdHandler<CmdShowPort, CmdShowPortTraits> {
 
     auto client =
         utils::createClient<facebook::fboss::FbossCtrlAsyncClient>(hostInfo);
-    client->sync_getAllPortInfo(portEntries);
+    auto ids = getFilterEqValues(getParsedFilters(), "id");
+    if (ids) {
+      // Fetch only the ports, and their transceivers, the filter can match
+      for (const auto& id : *ids) {
+        auto portId = folly::to<int32_t>(id);
+        try {
+          client->sync_getPortInfo(portEntries[portId], portId);
+        } catch (const facebook::fboss::thrift::FbossBaseError&) {
+          // Unknown port, nothing to show for it
+          portEntries.erase(portId);
+          continue;
+        }
+        if (auto tcvrId = portEntries[portId].transceiverIdx()) {
+          requiredTransceiverEntries.push_back(tcvrId->get_transceiverId());
+        }
+      }
+    } else {
+      client->sync_getAllPortInfo(portEntries);
+    }
 
     auto opt = CmdGlobalOptions::getInstance();
     if (opt->isDetailed()) {
       client->sync_getHwPortStats(portStats);
     }
 
-    try {
-      auto qsfpService =
-          utils::createClient<facebook::fboss::QsfpServiceAsyncClient>(
-              hostInfo);
-
-      qsfpService->sync_getTransceiverInfo(
-          transceiverEntries, requiredTransceiverEntries);
-    } catch (apache::thrift::transport::TTransportException&) {
-      std::cerr << "Cannot connect to qsfp_service\n";
+    // An empty list of transceivers asks for all of them
+    if (!ids || !requiredTransceiverEntries.empty()) {
+      try {
+        auto qsfpService =
+            utils::createClient<facebook::fboss::QsfpServiceAsyncClient>(
+                hostInfo);
+
+        qsfpService->sync_getTransceiverInfo(
+            transceiverEntries, requiredTransceiverEntries);
+      } catch (apache::thrift::transport::TTransportException&) {
+        std::cerr << "Cannot connect to qsfp_service\n";
+      }
     }
 
     return createModel(
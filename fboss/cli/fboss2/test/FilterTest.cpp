@@ -233,4 +233,24 @@ TEST_F(FilterTestFixture, allEntriesSatisfyFilter) {
   // All entries satisfy (linkState == Up || linkState == Down)
   EXPECT_EQ(filteredResult.get_portEntries().size(), 6);
 }
+
+TEST(FilterTest, filterEqValues) {
+  CmdGlobalOptions::IntersectionList intersectList1 = {
+      {"id", std::make_shared<FilterOpEq>(), "1"},
+      {"linkState", std::make_shared<FilterOpEq>(), "Up"}};
+  CmdGlobalOptions::IntersectionList intersectList2 = {
+      {"id", std::make_shared<FilterOpEq>(), "5"}};
+  CmdGlobalOptions::UnionList unionList = {intersectList1, intersectList2};
+  EXPECT_EQ(
+      getFilterEqValues(unionList, "id"), std::set<std::string>({"1", "5"}));
+  // linkState is open in the second intersection list
+  EXPECT_EQ(getFilterEqValues(unionList, "linkState"), std::nullopt);
+
+  // Only equality pins the values
+  CmdGlobalOptions::IntersectionList intersectList3 = {
+      {"id", std::make_shared<FilterOpGt>(), "3"}};
+  unionList.push_back(intersectList3);
+  EXPECT_EQ(getFilterEqValues(unionList, "id"), std::nullopt);
+  EXPECT_EQ(getFilterEqValues({}, "id"), std::nullopt);
+}
 } // namespace facebook::fboss
@@ -0,0 +1,108 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <gtest/gtest.h>
+
+#include "fboss/cli/fboss2/utils/ParallelHostQuery.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace facebook::fboss {
+
+namespace {
+std::vector<std::string> makeHosts(int count) {
+  std::vector<std::string> hosts;
+  for (int i = 0; i < count; i++) {
+    hosts.push_back("host" + std::to_string(i));
+  }
+  return hosts;
+}
+} // namespace
+
+TEST(ParallelHostQueryTest, queriesAreBounded) {
+  constexpr int kMaxParallel = 4;
+  auto hosts = makeHosts(50);
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+
+  std::set<std::string> seen;
+  utils::queryHostsInParallel<std::string>(
+      hosts,
+      kMaxParallel,
+      [&](const std::string& host) {
+        auto now = ++running;
+        auto prev = maxRunning.load();
+        while (now > prev && !maxRunning.compare_exchange_weak(prev, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --running;
+        return host;
+      },
+      [&](std::string&& host) { seen.insert(std::move(host)); });
+
+  EXPECT_EQ(seen, std::set<std::string>(hosts.begin(), hosts.end()));
+  EXPECT_LE(maxRunning.load(), kMaxParallel);
+}
+
+TEST(ParallelHostQueryTest, resultsArriveAsHostsComplete) {
+  // The first host is slow, the others must not wait for it
+  auto hosts = makeHosts(3);
+  std::vector<std::string> order;
+  utils::queryHostsInParallel<std::string>(
+      hosts,
+      3,
+      [](const std::string& host) {
+        if (host == "host0") {
+          std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        return host;
+      },
+      [&](std::string&& host) { order.push_back(std::move(host)); });
+
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order.back(), "host0");
+}
+
+TEST(ParallelHostQueryTest, consumerErrorIsRethrown) {
+  auto hosts = makeHosts(20);
+  int delivered = 0;
+  EXPECT_THROW(
+      utils::queryHostsInParallel<std::string>(
+          hosts,
+          2,
+          [](const std::string& host) { return host; },
+          [&](std::string&& /* host */) {
+            delivered++;
+            throw std::runtime_error("render failed");
+          }),
+      std::runtime_error);
+  // Remaining results are drained, not handed to the failed consumer
+  EXPECT_EQ(delivered, 1);
+}
+
+TEST(ParallelHostQueryTest, queryErrorIsRethrown) {
+  auto hosts = makeHosts(20);
+  std::atomic<int> queried{0};
+  int delivered = 0;
+  EXPECT_THROW(
+      utils::queryHostsInParallel<std::string>(
+          hosts,
+          4,
+          [&](const std::string& host) {
+            queried++;
+            if (host == "host0") {
+              throw std::runtime_error("query failed");
+            }
+            return host;
+          },
+          [&](std::string&& /* host */) { delivered++; }),
+      std::runtime_error);
+  // Every host is still queried, even after the failure was seen
+  EXPECT_EQ(queried.load(), static_cast<int>(hosts.size()));
+  EXPECT_LT(delivered, static_cast<int>(hosts.size()));
+}
+
+} // namespace facebook::fboss
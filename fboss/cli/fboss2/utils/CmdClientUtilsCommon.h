@@ -11,12 +11,12 @@
 
 #include <thrift/lib/cpp2/async/HeaderClientChannel.h>
 
+#include "fboss/cli/fboss2/CmdGlobalOptions.h"
 #include "fboss/cli/fboss2/utils/HostInfo.h"
 
 namespace facebook::fboss::utils {
 
 static auto constexpr kConnTimeout = 1000;
-static auto constexpr kRecvTimeout = 45000;
 static auto constexpr kSendTimeout = 5000;
 
 template <typename T>
@@ -39,7 +39,7 @@ std::unique_ptr<Client> createPlaintextClient(
   sock->setSendTimeout(kSendTimeout);
   auto channel =
       apache::thrift::HeaderClientChannel::newChannel(std::move(sock));
-  channel->setTimeout(kRecvTimeout);
+  channel->setTimeout(CmdGlobalOptions::getInstance()->getHostTimeoutMs());
   return std::make_unique<Client>(std::move(channel));
 }
 
@@ -7,6 +7,11 @@
 #include <thrift/lib/thrift/gen-cpp2/metadata_types.h>
 #include "fboss/cli/fboss2/CmdGlobalOptions.h"
 
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <string>
+
 namespace facebook::fboss {
 
 template <class T>
@@ -91,6 +96,35 @@ bool satisfiesFilterCondition(
   return false;
 }
 
+/* Returns the values filterKey is pinned to with == in every intersection
+list of the union, or std::nullopt if some intersection list leaves it open.
+Commands can ask the host for just these entries instead of all of them. The
+full filter is still applied to the response, so the values only need to be a
+superset of what matches.
+*/
+inline std::optional<std::set<std::string>> getFilterEqValues(
+    const CmdGlobalOptions::UnionList& unionList,
+    std::string_view filterKey) {
+  if (unionList.empty()) {
+    return std::nullopt;
+  }
+  std::set<std::string> values;
+  for (const auto& intersectList : unionList) {
+    auto term = std::find_if(
+        intersectList.begin(),
+        intersectList.end(),
+        [&](const CmdGlobalOptions::FilterTerm& filterTerm) {
+          return std::get<0>(filterTerm) == filterKey &&
+              dynamic_cast<FilterOpEq*>(std::get<1>(filterTerm).get());
+        });
+    if (term == intersectList.end()) {
+      return std::nullopt;
+    }
+    values.insert(std::get<2>(*term));
+  }
+  return values;
+}
+
 /* logic: We use the result model obtained from queryClient and perform thrift
 reflection on the model fields to obtain the field_refs (which correspond to the
 result values). Here, the model would be a struct containing a single list of
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include <folly/Try.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss::utils {
+
+/*
+ * Run query() for every host on a pool of at most maxParallel threads and
+ * hand each result to onResult() on the calling thread as soon as it is
+ * ready, i.e. in completion order rather than in the order of hosts.
+ *
+ * Only maxParallel results are buffered while onResult() runs, so a slow
+ * consumer throttles the queries instead of every host's response piling up
+ * in memory.
+ *
+ * If query() or onResult() throws, the remaining results are drained
+ * without being handed to onResult() and the first exception is rethrown on
+ * the calling thread once every query is done.
+ */
+template <typename ResultT, typename QueryFn, typename ResultFn>
+void queryHostsInParallel(
+    const std::vector<std::string>& hosts,
+    int maxParallel,
+    const QueryFn& query,
+    const ResultFn& onResult) {
+  if (hosts.empty()) {
+    return;
+  }
+  size_t numThreads =
+      std::min<size_t>(hosts.size(), std::max<int>(maxParallel, 1));
+  // Exceptions are carried back to the calling thread, a worker must always
+  // write a result or the calling thread would wait for it forever
+  folly::MPMCQueue<folly::Try<ResultT>> results(numThreads);
+  folly::CPUThreadPoolExecutor executor(numThreads);
+  for (const auto& host : hosts) {
+    executor.add([&results, &query, &host]() {
+      results.blockingWrite(folly::makeTryWith([&] { return query(host); }));
+    });
+  }
+
+  std::exception_ptr ex;
+  for (size_t i = 0; i < hosts.size(); i++) {
+    folly::Try<ResultT> result;
+    results.blockingRead(result);
+    if (ex) {
+      // Keep draining so no worker stays blocked on a full queue
+      continue;
+    }
+    try {
+      onResult(std::move(result).value());
+    } catch (...) {
+      ex = std::current_exception();
+    }
+  }
+  executor.join();
+  if (ex) {
+    std::rethrow_exception(ex);
+  }
+}
+
+} // namespace facebook::fboss::utils
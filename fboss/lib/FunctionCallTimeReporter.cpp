@@ -58,6 +58,7 @@ FunctionCallTimeReporter::CallTimeTracker::~CallTimeTracker() {
 
 void FunctionCallTimeReporter::start() {
   CHECK(!isOn_);
+  timedCallUsecs_ = 0;
   isOn_ = true;
   startTime_ = std::chrono::steady_clock::now();
 }
@@ -66,8 +67,17 @@ void FunctionCallTimeReporter::end() {
   CHECK(isOn_);
   std::chrono::duration<double, std::micro> durationUsecs =
       std::chrono::steady_clock::now() - startTime_;
-  XLOG(INFO) << "Total time, msecs: " << (durationUsecs.count() / 1000.0);
   isOn_ = false;
+  uint64_t windowUsecs = durationUsecs.count();
+  uint64_t timedCallUsecs = timedCallUsecs_.load();
+  totalUsecs_ += windowUsecs;
+  totalTimedCallUsecs_ += timedCallUsecs;
+  XLOG(INFO) << "Total time, msecs: " << (windowUsecs / 1000.0)
+             << ", SDK call time, msecs: " << (timedCallUsecs / 1000.0)
+             << ", software time, msecs: "
+             << (windowUsecs > timedCallUsecs
+                     ? (windowUsecs - timedCallUsecs) / 1000.0
+                     : 0.0);
 }
 
 ScopedCallTimer::ScopedCallTimer() {
@@ -15,6 +15,7 @@
 #include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
+#include <atomic>
 #include <chrono>
 
 namespace facebook::fboss {
@@ -35,20 +36,35 @@ class FunctionCallTimeReporter {
   }
   void callEnd() {
     if (UNLIKELY(isOn_)) {
-      tracker_.callEnd();
+      auto callUsecs = tracker_.callEnd();
+      timedCallUsecs_ += static_cast<uint64_t>(callUsecs.count());
     }
   }
 
+  /*
+   * Accumulated over all start()/end() windows so far. Total is the wall
+   * clock time of the windows, timed call usecs is the time spent inside
+   * timed calls (i.e. SDK calls) across all threads. The difference is the
+   * time spent in software outside of the SDK.
+   */
+  uint64_t getTotalUsecs() const {
+    return totalUsecs_;
+  }
+  uint64_t getTotalTimedCallUsecs() const {
+    return totalTimedCallUsecs_;
+  }
+
  private:
   struct CallTimeTracker {
     ~CallTimeTracker();
     void callStart() {
       startTime_ = std::chrono::steady_clock::now();
     }
-    void callEnd() {
+    std::chrono::duration<double, std::micro> callEnd() {
       std::chrono::duration<double, std::micro> callUsecs =
           std::chrono::steady_clock::now() - startTime_;
       cumalativeUsecs_ += callUsecs;
+      return callUsecs;
     }
 
     std::chrono::time_point<std::chrono::steady_clock> startTime_;
@@ -63,6 +79,9 @@ class FunctionCallTimeReporter {
    * and would need heavier means of synchronization
    */
   std::atomic<bool> isOn_{false};
+  std::atomic<uint64_t> timedCallUsecs_{0};
+  std::atomic<uint64_t> totalUsecs_{0};
+  std::atomic<uint64_t> totalTimedCallUsecs_{0};
   static thread_local CallTimeTracker tracker_;
 };
 
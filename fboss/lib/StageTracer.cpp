@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/StageTracer.h"
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Singleton.h>
+#include <folly/json/json.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadId.h>
+#include <gflags/gflags.h>
+#include <unistd.h>
+
+DEFINE_bool(
+    enable_stage_tracer,
+    false,
+    "Export the time taken by each stage of multi stage operations (e.g. "
+    "switch state updates) as fb303 histograms");
+
+DEFINE_string(
+    stage_trace_file,
+    "",
+    "If set, append a Chrome trace event for every traced stage (e.g. "
+    "switch state update stages) to this file");
+
+namespace {
+struct singleton_tag_type {};
+
+// histogram range [0, 10s], 10ms width
+constexpr int64_t kHistogramBucketUsecs = 10000;
+constexpr int64_t kHistogramMaxUsecs = 10000000;
+// histogram range [0, 1000], width 10 for counts
+constexpr int64_t kValueHistogramBucket = 10;
+constexpr int64_t kValueHistogramMax = 1000;
+} // namespace
+
+namespace facebook::fboss {
+
+static folly::Singleton<StageTracer, singleton_tag_type> stageTracerSingleton;
+
+std::shared_ptr<StageTracer> StageTracer::getInstance() {
+  return stageTracerSingleton.try_get();
+}
+
+StageTracer::StageTracer() {
+  if (!FLAGS_stage_trace_file.empty()) {
+    auto file = std::make_unique<std::ofstream>(FLAGS_stage_trace_file);
+    if (file->good()) {
+      // Chrome trace JSON array format. The closing bracket is optional,
+      // which lets us append events until the process exits.
+      *file << "[\n";
+      *traceFile_.wlock() = std::move(file);
+      traceFileEnabled_ = true;
+    } else {
+      XLOG(ERR) << "Unable to open stage trace file: "
+                << FLAGS_stage_trace_file;
+    }
+  }
+  enabled_ = FLAGS_enable_stage_tracer || traceFileEnabled_;
+}
+
+StageTracer::~StageTracer() {
+  auto traceFile = traceFile_.wlock();
+  if (*traceFile) {
+    (*traceFile)->flush();
+  }
+}
+
+void StageTracer::exportHistogramIfNeeded(
+    const std::string& key,
+    int64_t bucketSize,
+    int64_t max) {
+  if (exportedKeys_.rlock()->count(key)) {
+    return;
+  }
+  auto exportedKeys = exportedKeys_.wlock();
+  if (exportedKeys->insert(key).second) {
+    fb303::ThreadCachedServiceData::get()->addHistogram(
+        key, bucketSize, 0, max);
+    fb303::ThreadCachedServiceData::get()->exportHistogram(key, 50, 95, 99);
+  }
+}
+
+void StageTracer::recordStage(
+    folly::StringPiece stage,
+    Clock::time_point start,
+    Clock::time_point end,
+    folly::StringPiece detail) {
+  if (!enabled()) {
+    return;
+  }
+  auto key = folly::to<std::string>(stage, ".us");
+  exportHistogramIfNeeded(key, kHistogramBucketUsecs, kHistogramMaxUsecs);
+  fb303::ThreadCachedServiceData::get()->addHistogramValue(
+      key,
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count());
+  writeTraceEvent(stage, start, end, detail);
+}
+
+void StageTracer::recordValue(folly::StringPiece stage, int64_t value) {
+  if (!enabled()) {
+    return;
+  }
+  auto key = stage.str();
+  exportHistogramIfNeeded(key, kValueHistogramBucket, kValueHistogramMax);
+  fb303::ThreadCachedServiceData::get()->addHistogramValue(key, value);
+}
+
+void StageTracer::writeTraceEvent(
+    folly::StringPiece stage,
+    Clock::time_point start,
+    Clock::time_point end,
+    folly::StringPiece detail) {
+  if (!traceFileEnabled_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  folly::dynamic event = folly::dynamic::object;
+  event["name"] = stage;
+  event["ph"] = "X";
+  event["ts"] = std::chrono::duration_cast<std::chrono::microseconds>(
+                    start.time_since_epoch())
+                    .count();
+  event["dur"] =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+  event["pid"] = static_cast<int64_t>(getpid());
+  event["tid"] = static_cast<int64_t>(folly::getOSThreadID());
+  if (!detail.empty()) {
+    event["args"] = folly::dynamic::object("detail", detail);
+  }
+  auto line = folly::toJson(event) + ",\n";
+  **traceFile_.wlock() << line;
+}
+
+ScopedStageTimer::ScopedStageTimer(folly::StringPiece stage) : stage_(stage) {
+  auto tracer = StageTracer::getInstance();
+  if (tracer && tracer->enabled()) {
+    tracer_ = std::move(tracer);
+    start_ = StageTracer::Clock::now();
+  }
+}
+
+ScopedStageTimer::~ScopedStageTimer() {
+  if (tracer_) {
+    tracer_->recordStage(stage_, start_, StageTracer::Clock::now());
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace facebook::fboss {
+
+/*
+ * Records the time taken by stages of a multi stage operation (e.g. the
+ * stages of a switch state update: queue wait, update functions, HW
+ * programming per manager, observers).
+ *
+ * With --enable_stage_tracer, each stage is exported as a fb303 histogram
+ * "<stage>.us". If --stage_trace_file is set, every stage is also appended
+ * to that file as a Chrome trace event (loadable in chrome://tracing or
+ * Perfetto) for offline analysis. Otherwise recording a stage is a no-op.
+ */
+class StageTracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static std::shared_ptr<StageTracer> getInstance();
+
+  StageTracer();
+  ~StageTracer();
+  StageTracer(const StageTracer&) = delete;
+  StageTracer& operator=(const StageTracer&) = delete;
+
+  // Callers may check this to skip gathering what they would record
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  void recordStage(
+      folly::StringPiece stage,
+      Clock::time_point start,
+      Clock::time_point end,
+      folly::StringPiece detail = "");
+
+  // For stages that are measured as a count rather than a duration, e.g.
+  // number of coalesced updates
+  void recordValue(folly::StringPiece stage, int64_t value);
+
+ private:
+  void exportHistogramIfNeeded(
+      const std::string& key,
+      int64_t bucketSize,
+      int64_t max);
+  void writeTraceEvent(
+      folly::StringPiece stage,
+      Clock::time_point start,
+      Clock::time_point end,
+      folly::StringPiece detail);
+
+  // Set once in the constructor, checked before taking any lock
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> traceFileEnabled_{false};
+  folly::Synchronized<std::unordered_set<std::string>> exportedKeys_;
+  folly::Synchronized<std::unique_ptr<std::ofstream>> traceFile_;
+};
+
+/*
+ * Records the time between construction and destruction as a stage. Whether
+ * tracing is on is checked once on construction, if it is off neither end
+ * reads the clock.
+ */
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(folly::StringPiece stage);
+  ~ScopedStageTimer();
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  folly::StringPiece stage_;
+  // Null when tracing is off
+  std::shared_ptr<StageTracer> tracer_;
+  StageTracer::Clock::time_point start_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,277 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/lib/i2c/I2cTransactionScheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+namespace {
+uint8_t i2cAddress(const TransceiverAccessParameter& param) {
+  return param.i2cAddress.value_or(TransceiverAccessParameter::ADDR_QSFP);
+}
+} // namespace
+
+I2cTransactionScheduler::I2cTransactionScheduler(TransceiverI2CApi* i2cBus)
+    : i2cBus_(i2cBus) {}
+
+I2cTransactionScheduler::~I2cTransactionScheduler() {
+  // Drains are queued in order, so once a no-op has run on every bus thread
+  // none of them references this scheduler anymore.
+  for (auto& [evb, bus] : *buses_.rlock()) {
+    evb->runInEventBaseThreadAndWait([]() {});
+  }
+}
+
+folly::SemiFuture<folly::Unit> I2cTransactionScheduler::read(
+    unsigned int module,
+    const TransceiverAccessParameter& param,
+    uint8_t* buf) {
+  std::vector<Transaction> transactions;
+  transactions.emplace_back(module, param, buf);
+  return submit(std::move(transactions));
+}
+
+folly::SemiFuture<folly::Unit> I2cTransactionScheduler::readBatch(
+    unsigned int module,
+    const std::vector<std::pair<TransceiverAccessParameter, uint8_t*>>&
+        reads) {
+  if (reads.empty()) {
+    return folly::makeSemiFuture();
+  }
+  std::vector<Transaction> transactions;
+  transactions.reserve(reads.size());
+  for (const auto& [param, buf] : reads) {
+    transactions.emplace_back(module, param, buf);
+  }
+  return submit(std::move(transactions));
+}
+
+folly::SemiFuture<folly::Unit> I2cTransactionScheduler::submitBatch(
+    unsigned int module,
+    const std::vector<TransceiverAccess>& accesses) {
+  if (accesses.empty()) {
+    return folly::makeSemiFuture();
+  }
+  std::vector<Transaction> transactions;
+  transactions.reserve(accesses.size());
+  for (const auto& access : accesses) {
+    if (access.isWrite) {
+      transactions.emplace_back(module, access.param, nullptr);
+      transactions.back().writeData.assign(
+          access.buf, access.buf + access.param.len);
+    } else {
+      transactions.emplace_back(module, access.param, access.buf);
+    }
+  }
+  return submit(std::move(transactions));
+}
+
+folly::SemiFuture<folly::Unit> I2cTransactionScheduler::write(
+    unsigned int module,
+    const TransceiverAccessParameter& param,
+    const uint8_t* buf) {
+  std::vector<Transaction> transactions;
+  transactions.emplace_back(module, param, nullptr);
+  transactions.back().writeData.assign(buf, buf + param.len);
+  return submit(std::move(transactions));
+}
+
+I2cTransactionScheduler::Stats I2cTransactionScheduler::getStats() const {
+  Stats stats;
+  stats.submitted = submitted_.load();
+  stats.issued = issued_.load();
+  stats.segmentSwitches = segmentSwitches_.load();
+  return stats;
+}
+
+folly::SemiFuture<folly::Unit> I2cTransactionScheduler::submit(
+    std::vector<Transaction> transactions) {
+  submitted_ += transactions.size();
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(transactions.size());
+  for (auto& transaction : transactions) {
+    futures.push_back(transaction.promise.getSemiFuture());
+  }
+  // All transactions of one submission belong to the same module
+  auto bus = getBus(transactions.front().module);
+  bool scheduleDrain = false;
+  {
+    auto pending = bus->pending.wlock();
+    std::move(
+        transactions.begin(),
+        transactions.end(),
+        std::back_inserter(pending->transactions));
+    scheduleDrain = !pending->drainScheduled;
+    pending->drainScheduled = true;
+  }
+
+  if (bus->evb->isInEventBaseThread()) {
+    // The caller is running on the bus thread and will likely wait for the
+    // result, so a drain queued behind it would never run.
+    drain(bus);
+  } else if (scheduleDrain) {
+    bus->evb->runInEventBaseThread([this, bus]() { drain(bus); });
+  }
+
+  if (futures.size() == 1) {
+    return std::move(futures.front());
+  }
+  // Wait for every read to finish, even after one failed, since they all
+  // write into buffers owned by the caller.
+  return folly::collectAll(std::move(futures))
+      .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+      });
+}
+
+I2cTransactionScheduler::Bus* I2cTransactionScheduler::getBus(
+    unsigned int module) {
+  auto evb = i2cBus_->getEventBase(module);
+  if (!evb) {
+    evb = defaultBusThread_.getEventBase();
+  }
+  {
+    auto buses = buses_.rlock();
+    auto it = buses->find(evb);
+    if (it != buses->end()) {
+      return it->second.get();
+    }
+  }
+  auto buses = buses_.wlock();
+  auto& bus = (*buses)[evb];
+  if (!bus) {
+    bus = std::make_unique<Bus>(evb);
+  }
+  return bus.get();
+}
+
+void I2cTransactionScheduler::drain(Bus* bus) {
+  std::vector<Transaction> batch;
+  {
+    auto pending = bus->pending.wlock();
+    batch.swap(pending->transactions);
+    pending->drainScheduled = false;
+  }
+  if (batch.empty()) {
+    return;
+  }
+
+  // Group by module, keeping the bus on its current module first and the
+  // submission order within each module.
+  std::unordered_map<unsigned int, size_t> moduleRank;
+  if (bus->lastModule) {
+    moduleRank[*bus->lastModule] = 0;
+  }
+  for (const auto& transaction : batch) {
+    moduleRank.emplace(transaction.module, moduleRank.size());
+  }
+  std::stable_sort(
+      batch.begin(), batch.end(), [&](const auto& lhs, const auto& rhs) {
+        return moduleRank[lhs.module] < moduleRank[rhs.module];
+      });
+
+  size_t begin = 0;
+  while (begin < batch.size()) {
+    auto module = batch[begin].module;
+    if (bus->lastModule != module) {
+      if (bus->lastModule) {
+        segmentSwitches_++;
+      }
+      bus->lastModule = module;
+    }
+    if (!batch[begin].readBuf) {
+      runWrite(batch[begin]);
+      begin++;
+      continue;
+    }
+
+    // Extend the read as long as the next one continues the same range
+    const auto& first = batch[begin].param;
+    int rangeEnd = first.offset + first.len;
+    size_t end = begin + 1;
+    for (; end < batch.size(); end++) {
+      const auto& next = batch[end];
+      if (!next.readBuf || next.module != module ||
+          i2cAddress(next.param) != i2cAddress(first) ||
+          next.param.page != first.page || next.param.bank != first.bank ||
+          next.param.offset < first.offset || next.param.offset > rangeEnd) {
+        break;
+      }
+      auto nextEnd = std::max(rangeEnd, next.param.offset + next.param.len);
+      if (nextEnd - first.offset > kMaxCoalescedLen) {
+        break;
+      }
+      rangeEnd = nextEnd;
+    }
+    runReads(batch, begin, end);
+    begin = end;
+  }
+}
+
+void I2cTransactionScheduler::runReads(
+    std::vector<Transaction>& batch,
+    size_t begin,
+    size_t end) {
+  auto& first = batch[begin];
+  issued_++;
+  if (end - begin == 1) {
+    try {
+      i2cBus_->moduleRead(first.module, first.param, first.readBuf);
+      first.promise.setValue();
+    } catch (const std::exception& ex) {
+      first.promise.setException(
+          folly::exception_wrapper(std::current_exception(), ex));
+    }
+    return;
+  }
+
+  int rangeEnd = first.param.offset;
+  for (auto i = begin; i < end; i++) {
+    rangeEnd = std::max(rangeEnd, batch[i].param.offset + batch[i].param.len);
+  }
+  TransceiverAccessParameter merged = first.param;
+  merged.len = rangeEnd - first.param.offset;
+  std::vector<uint8_t> buf(merged.len);
+  XLOG(DBG5) << "Module " << first.module << ": coalesced " << end - begin
+             << " reads into offset " << merged.offset << " length "
+             << merged.len;
+  try {
+    i2cBus_->moduleRead(first.module, merged, buf.data());
+  } catch (const std::exception& ex) {
+    folly::exception_wrapper ew(std::current_exception(), ex);
+    for (auto i = begin; i < end; i++) {
+      batch[i].promise.setException(ew);
+    }
+    return;
+  }
+  for (auto i = begin; i < end; i++) {
+    auto& transaction = batch[i];
+    std::memcpy(
+        transaction.readBuf,
+        buf.data() + (transaction.param.offset - merged.offset),
+        transaction.param.len);
+    transaction.promise.setValue();
+  }
+}
+
+void I2cTransactionScheduler::runWrite(Transaction& transaction) {
+  issued_++;
+  try {
+    i2cBus_->moduleWrite(
+        transaction.module, transaction.param, transaction.writeData.data());
+    transaction.promise.setValue();
+  } catch (const std::exception& ex) {
+    transaction.promise.setException(
+        folly::exception_wrapper(std::current_exception(), ex));
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,143 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+
+#include "fboss/lib/usb/TransceiverI2CApi.h"
+
+namespace facebook::fboss {
+
+/*
+ * Queues transceiver I2C transactions per physical bus and runs them in
+ * batches on the thread owning the bus.
+ *
+ * Modules that share an event base (see TransceiverI2CApi::getEventBase())
+ * share a bus. Modules without one all share a single bus that gets its own
+ * thread. Different buses run concurrently.
+ *
+ * Within a batch, transactions are grouped by module (i.e. mux segment),
+ * starting with the module the bus was last used for, so the mux is switched
+ * as little as possible. Transactions of one module keep the order they were
+ * submitted in, and writes are never merged. Back to back reads of the same
+ * module, device address and page whose ranges touch or overlap are merged
+ * into a single transaction of at most kMaxCoalescedLen bytes.
+ *
+ * Module numbers are the 1-based ones used by TransceiverI2CApi.
+ */
+class I2cTransactionScheduler {
+ public:
+  static constexpr int kMaxCoalescedLen = 128;
+
+  struct Stats {
+    // Transactions requested by callers
+    uint64_t submitted{0};
+    // Transactions actually issued on the buses
+    uint64_t issued{0};
+    // Times a bus had to switch to a different module
+    uint64_t segmentSwitches{0};
+  };
+
+  explicit I2cTransactionScheduler(TransceiverI2CApi* i2cBus);
+  ~I2cTransactionScheduler();
+
+  /*
+   * buf must stay valid until the returned future completes.
+   *
+   * Called from the thread owning the bus, the transactions queued for that
+   * bus are run right away and the returned future is already complete.
+   */
+  folly::SemiFuture<folly::Unit> read(
+      unsigned int module,
+      const TransceiverAccessParameter& param,
+      uint8_t* buf);
+
+  /*
+   * Queue several reads of one module at once, so that adjacent ones can be
+   * merged even when called from the thread owning the bus. The returned
+   * future completes once all of them are done and carries the first error.
+   */
+  folly::SemiFuture<folly::Unit> readBatch(
+      unsigned int module,
+      const std::vector<std::pair<TransceiverAccessParameter, uint8_t*>>&
+          reads);
+
+  /*
+   * Queue a sequence of reads and writes of one module at once, e.g. the
+   * page select writes and page reads of a transceiver refresh. They are
+   * issued in order. Write data is copied, read buffers must stay valid
+   * until the returned future completes. The future carries the first error.
+   */
+  folly::SemiFuture<folly::Unit> submitBatch(
+      unsigned int module,
+      const std::vector<TransceiverAccess>& accesses);
+
+  // buf is copied, so it can be released as soon as this returns
+  folly::SemiFuture<folly::Unit> write(
+      unsigned int module,
+      const TransceiverAccessParameter& param,
+      const uint8_t* buf);
+
+  Stats getStats() const;
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  I2cTransactionScheduler(I2cTransactionScheduler const&) = delete;
+  I2cTransactionScheduler& operator=(I2cTransactionScheduler const&) = delete;
+
+  struct Transaction {
+    Transaction(
+        unsigned int module,
+        const TransceiverAccessParameter& param,
+        uint8_t* readBuf)
+        : module(module), param(param), readBuf(readBuf) {}
+
+    unsigned int module;
+    TransceiverAccessParameter param;
+    // Null for writes
+    uint8_t* readBuf;
+    std::vector<uint8_t> writeData;
+    folly::Promise<folly::Unit> promise;
+  };
+
+  struct PendingTransactions {
+    std::vector<Transaction> transactions;
+    bool drainScheduled{false};
+  };
+
+  struct Bus {
+    explicit Bus(folly::EventBase* evb) : evb(evb) {}
+
+    folly::EventBase* const evb;
+    folly::Synchronized<PendingTransactions> pending;
+    // Only accessed from the bus thread
+    std::optional<unsigned int> lastModule;
+  };
+
+  folly::SemiFuture<folly::Unit> submit(std::vector<Transaction> transactions);
+  Bus* getBus(unsigned int module);
+  void drain(Bus* bus);
+  void runReads(std::vector<Transaction>& batch, size_t begin, size_t end);
+  void runWrite(Transaction& transaction);
+
+  TransceiverI2CApi* const i2cBus_;
+  // Runs the transactions of modules without an event base of their own
+  folly::ScopedEventBaseThread defaultBusThread_{"I2cDefaultBus"};
+  folly::Synchronized<std::map<folly::EventBase*, std::unique_ptr<Bus>>>
+      buses_;
+
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> issued_{0};
+  std::atomic<uint64_t> segmentSwitches_{0};
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,334 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/futures/Future.h>
+#include <folly/synchronization/Baton.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <gtest/gtest.h>
+
+#include "fboss/lib/i2c/I2cTransactionScheduler.h"
+
+namespace facebook::fboss {
+
+namespace {
+
+/*
+ * Simulated I2C bus. Every transaction takes a fixed time, plus the time to
+ * switch the mux when it is for another module than the previous one on its
+ * bus. Register N of every module reads back as N. Modules 1 to 4 are on bus
+ * A and modules 5 to 8 on bus B, other modules have no bus of their own.
+ */
+class FakeI2CBus : public TransceiverI2CApi {
+ public:
+  struct Access {
+    unsigned int module;
+    int offset;
+    int len;
+    bool isWrite;
+  };
+
+  explicit FakeI2CBus(
+      std::chrono::milliseconds latency,
+      std::chrono::milliseconds muxSwitchLatency =
+          std::chrono::milliseconds(0))
+      : latency_(latency), muxSwitchLatency_(muxSwitchLatency) {}
+
+  void open() override {}
+  void close() override {}
+  void verifyBus(bool /* autoReset */) override {}
+  bool isPresent(unsigned int /* module */) override {
+    return true;
+  }
+  void scanPresence(std::map<int32_t, ModulePresence>& /* presences */)
+      override {}
+
+  void moduleRead(
+      unsigned int module,
+      const TransceiverAccessParameter& param,
+      uint8_t* buf) override {
+    record(module, param, false);
+    if (module == kFailingModule) {
+      throw I2cError("injected read failure");
+    }
+    for (int i = 0; i < param.len; i++) {
+      buf[i] = param.offset + i;
+    }
+  }
+
+  void moduleWrite(
+      unsigned int module,
+      const TransceiverAccessParameter& param,
+      const uint8_t* /* buf */) override {
+    record(module, param, true);
+  }
+
+  folly::EventBase* getEventBase(unsigned int module) override {
+    if (module >= 1 && module <= 4) {
+      return busA_.getEventBase();
+    } else if (module >= 5 && module <= 8) {
+      return busB_.getEventBase();
+    }
+    return nullptr;
+  }
+
+  std::vector<Access> accesses() {
+    std::lock_guard<std::mutex> g(mutex_);
+    return accesses_;
+  }
+
+  static constexpr unsigned int kFailingModule = 4;
+
+ private:
+  void record(
+      unsigned int module,
+      const TransceiverAccessParameter& param,
+      bool isWrite) {
+    bool muxSwitch;
+    {
+      std::lock_guard<std::mutex> g(mutex_);
+      auto& lastModule = lastModules_[getEventBase(module)];
+      muxSwitch = lastModule != module;
+      lastModule = module;
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(
+        muxSwitch ? latency_ + muxSwitchLatency_ : latency_);
+    std::lock_guard<std::mutex> g(mutex_);
+    accesses_.push_back({module, param.offset, param.len, isWrite});
+  }
+
+  const std::chrono::milliseconds latency_;
+  const std::chrono::milliseconds muxSwitchLatency_;
+  folly::ScopedEventBaseThread busA_{"BusA"};
+  folly::ScopedEventBaseThread busB_{"BusB"};
+  std::mutex mutex_;
+  std::vector<Access> accesses_;
+  std::map<folly::EventBase*, unsigned int> lastModules_;
+};
+
+TransceiverAccessParameter param(int offset, int len) {
+  return TransceiverAccessParameter(
+      TransceiverAccessParameter::ADDR_QSFP, offset, len, 0x11);
+}
+
+} // namespace
+
+class I2cTransactionSchedulerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    bus_ = std::make_unique<FakeI2CBus>(std::chrono::milliseconds(20));
+    scheduler_ = std::make_unique<I2cTransactionScheduler>(bus_.get());
+  }
+
+  void TearDown() override {
+    scheduler_.reset();
+    bus_.reset();
+  }
+
+  // Hold the bus thread until the baton is posted, so that everything
+  // submitted meanwhile is run as a single batch.
+  void pauseBus(unsigned int module, folly::Baton<>& resume) {
+    folly::Baton<> paused;
+    bus_->getEventBase(module)->runInEventBaseThread([&paused, &resume]() {
+      paused.post();
+      resume.wait();
+    });
+    paused.wait();
+  }
+
+  std::unique_ptr<FakeI2CBus> bus_;
+  std::unique_ptr<I2cTransactionScheduler> scheduler_;
+};
+
+TEST_F(I2cTransactionSchedulerTest, adjacentReadsAreCoalesced) {
+  folly::Baton<> resume;
+  pauseBus(2, resume);
+  std::vector<uint8_t> lanes(8);
+  std::vector<folly::SemiFuture<folly::Unit>> futs;
+  for (int lane = 0; lane < 8; lane++) {
+    futs.push_back(scheduler_->read(2, param(206 + lane, 1), &lanes[lane]));
+  }
+  resume.post();
+  folly::collectAll(std::move(futs)).get();
+
+  for (int lane = 0; lane < 8; lane++) {
+    EXPECT_EQ(lanes[lane], 206 + lane);
+  }
+  auto accesses = bus_->accesses();
+  ASSERT_EQ(accesses.size(), 1);
+  EXPECT_EQ(accesses[0].offset, 206);
+  EXPECT_EQ(accesses[0].len, 8);
+  EXPECT_EQ(scheduler_->getStats().submitted, 8);
+  EXPECT_EQ(scheduler_->getStats().issued, 1);
+}
+
+TEST_F(I2cTransactionSchedulerTest, transactionsAreGroupedByModule) {
+  uint8_t buf[5];
+  std::vector<folly::SemiFuture<folly::Unit>> futs;
+  // Leave the bus on module 1
+  scheduler_->read(1, param(0, 1), &buf[0]).get();
+
+  folly::Baton<> resume;
+  pauseBus(1, resume);
+  futs.push_back(scheduler_->read(2, param(10, 1), &buf[1]));
+  futs.push_back(scheduler_->read(1, param(20, 1), &buf[2]));
+  futs.push_back(scheduler_->read(2, param(30, 1), &buf[3]));
+  futs.push_back(scheduler_->read(1, param(40, 1), &buf[4]));
+  resume.post();
+  folly::collectAll(std::move(futs)).get();
+
+  // Module 1 is drained before switching to module 2 once
+  std::vector<unsigned int> modules;
+  for (const auto& access : bus_->accesses()) {
+    modules.push_back(access.module);
+  }
+  EXPECT_EQ(modules, std::vector<unsigned int>({1, 1, 1, 2, 2}));
+  EXPECT_EQ(scheduler_->getStats().segmentSwitches, 1);
+}
+
+TEST_F(I2cTransactionSchedulerTest, writesAreNotReordered) {
+  uint8_t page = 0x11, before, after;
+  folly::Baton<> resume;
+  pauseBus(2, resume);
+  // Adjacent reads, but the page write in between must not be skipped over
+  auto beforeFut = scheduler_->read(2, param(200, 1), &before);
+  auto writeFut = scheduler_->write(2, param(127, 1), &page);
+  auto afterFut = scheduler_->read(2, param(201, 1), &after);
+  resume.post();
+  std::move(beforeFut).get();
+  std::move(writeFut).get();
+  std::move(afterFut).get();
+
+  auto accesses = bus_->accesses();
+  ASSERT_EQ(accesses.size(), 3);
+  EXPECT_EQ(accesses[0].offset, 200);
+  EXPECT_TRUE(accesses[1].isWrite);
+  EXPECT_EQ(accesses[2].offset, 201);
+}
+
+TEST_F(I2cTransactionSchedulerTest, independentBusesRunConcurrently) {
+  constexpr int kReadsPerBus = 5;
+  std::vector<uint8_t> bufs(2 * kReadsPerBus);
+  std::vector<folly::SemiFuture<folly::Unit>> futs;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kReadsPerBus; i++) {
+    // Non adjacent offsets, so nothing is coalesced
+    futs.push_back(scheduler_->read(1, param(i * 2, 1), &bufs[i]));
+    futs.push_back(
+        scheduler_->read(5, param(i * 2, 1), &bufs[kReadsPerBus + i]));
+  }
+  folly::collectAll(std::move(futs)).get();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // Serialized this would take 10 transactions of 20ms each
+  EXPECT_LT(elapsed, std::chrono::milliseconds(180));
+  EXPECT_EQ(scheduler_->getStats().issued, 2 * kReadsPerBus);
+}
+
+TEST_F(I2cTransactionSchedulerTest, failureIsReportedToEveryCoalescedRead) {
+  uint8_t first, second;
+  folly::Baton<> resume;
+  pauseBus(FakeI2CBus::kFailingModule, resume);
+  auto firstFut =
+      scheduler_->read(FakeI2CBus::kFailingModule, param(0, 1), &first);
+  auto secondFut =
+      scheduler_->read(FakeI2CBus::kFailingModule, param(1, 1), &second);
+  resume.post();
+  EXPECT_THROW(std::move(firstFut).get(), I2cError);
+  EXPECT_THROW(std::move(secondFut).get(), I2cError);
+}
+
+TEST_F(I2cTransactionSchedulerTest, readFromBusThreadCompletesInline) {
+  // A module refreshed on its bus thread must not wait on itself
+  auto evb = bus_->getEventBase(1);
+  uint8_t buf = 0;
+  evb->runInEventBaseThreadAndWait([&]() {
+    auto fut = scheduler_->read(1, param(42, 1), &buf);
+    EXPECT_TRUE(fut.isReady());
+  });
+  EXPECT_EQ(buf, 42);
+}
+
+TEST_F(I2cTransactionSchedulerTest, batchFromBusThreadIsCoalesced) {
+  auto evb = bus_->getEventBase(1);
+  std::array<uint8_t, 4> lanes;
+  std::vector<std::pair<TransceiverAccessParameter, uint8_t*>> reads;
+  for (size_t lane = 0; lane < lanes.size(); lane++) {
+    reads.emplace_back(param(206 + lane, 1), &lanes[lane]);
+  }
+  evb->runInEventBaseThreadAndWait(
+      [&]() { scheduler_->readBatch(1, reads).get(); });
+
+  for (size_t lane = 0; lane < lanes.size(); lane++) {
+    EXPECT_EQ(lanes[lane], 206 + lane);
+  }
+  EXPECT_EQ(bus_->accesses().size(), 1);
+}
+
+namespace {
+
+// What a CMIS refresh of two pages looks like on the bus
+std::vector<TransceiverAccess> pageRefresh(
+    std::array<uint8_t, 2>& pageSelects,
+    std::array<std::array<uint8_t, 128>, 2>& pages) {
+  std::vector<TransceiverAccess> accesses;
+  for (size_t i = 0; i < pages.size(); i++) {
+    pageSelects[i] = 0x10 + i;
+    accesses.push_back({param(127, 1), &pageSelects[i], /*isWrite*/ true});
+    accesses.push_back({param(128, 128), pages[i].data()});
+  }
+  return accesses;
+}
+
+} // namespace
+
+TEST(I2cTransactionSchedulerMuxTest, batchedRefreshesSwitchMuxLess) {
+  // Four modules on one bus refresh at the same time from their own threads
+  constexpr unsigned int kModules = 4;
+  auto refreshAll = [](bool batched) {
+    FakeI2CBus bus(std::chrono::milliseconds(5), std::chrono::milliseconds(20));
+    I2cTransactionScheduler scheduler(&bus);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int module = 1; module <= kModules; module++) {
+      threads.emplace_back([&scheduler, module, batched]() {
+        std::array<uint8_t, 2> pageSelects;
+        std::array<std::array<uint8_t, 128>, 2> pages;
+        auto accesses = pageRefresh(pageSelects, pages);
+        if (batched) {
+          scheduler.submitBatch(module, accesses).get();
+          return;
+        }
+        // One transaction at a time, like blocking readTransceiver() calls
+        for (const auto& access : accesses) {
+          if (access.isWrite) {
+            scheduler.write(module, access.param, access.buf).get();
+          } else {
+            scheduler.read(module, access.param, access.buf).get();
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(scheduler.getStats().issued, 4 * kModules);
+    return std::make_pair(scheduler.getStats().segmentSwitches, elapsed);
+  };
+
+  auto [unbatchedSwitches, unbatchedElapsed] = refreshAll(false);
+  auto [batchedSwitches, batchedElapsed] = refreshAll(true);
+  // Batches reach the bus whole and are run module by module
+  EXPECT_LE(batchedSwitches, kModules - 1);
+  EXPECT_LT(batchedSwitches, unbatchedSwitches);
+  EXPECT_LT(batchedElapsed, unbatchedElapsed);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/StageTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/json/json.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+
+DECLARE_bool(enable_stage_tracer);
+DECLARE_string(stage_trace_file);
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kTraceFile = "/tmp/stage_tracer_test.json";
+} // namespace
+
+class StageTracerTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    std::remove(kTraceFile);
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(StageTracerTest, disabledByDefault) {
+  FLAGS_enable_stage_tracer = false;
+  FLAGS_stage_trace_file = "";
+  StageTracer tracer;
+  EXPECT_FALSE(tracer.enabled());
+  // No-ops, must not need anything to be set up
+  auto now = StageTracer::Clock::now();
+  tracer.recordStage("stage", now, now);
+  tracer.recordValue("value", 1);
+}
+
+TEST_F(StageTracerTest, enabledByFlag) {
+  FLAGS_enable_stage_tracer = true;
+  FLAGS_stage_trace_file = "";
+  StageTracer tracer;
+  EXPECT_TRUE(tracer.enabled());
+}
+
+TEST_F(StageTracerTest, writesTraceEvents) {
+  FLAGS_enable_stage_tracer = false;
+  FLAGS_stage_trace_file = kTraceFile;
+  {
+    StageTracer tracer;
+    EXPECT_TRUE(tracer.enabled());
+    auto start = StageTracer::Clock::now();
+    tracer.recordStage("stage1", start, start + std::chrono::milliseconds(5));
+    tracer.recordStage(
+        "stage2", start, start + std::chrono::milliseconds(1), "detail");
+  }
+
+  std::string content;
+  ASSERT_TRUE(folly::readFile(kTraceFile, content));
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', content, lines, true /* ignoreEmpty */);
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], "[");
+
+  std::vector<folly::dynamic> events;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    auto line = lines[i];
+    ASSERT_TRUE(line.removeSuffix(","));
+    events.push_back(folly::parseJson(line));
+  }
+  EXPECT_EQ(events[0]["name"], "stage1");
+  EXPECT_EQ(events[0]["ph"], "X");
+  EXPECT_EQ(events[0]["dur"], 5000);
+  EXPECT_EQ(events[0].count("args"), 0);
+  EXPECT_EQ(events[1]["name"], "stage2");
+  EXPECT_EQ(events[1]["dur"], 1000);
+  EXPECT_EQ(events[1]["args"]["detail"], "detail");
+}
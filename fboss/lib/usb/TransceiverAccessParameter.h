@@ -31,4 +31,14 @@ struct TransceiverAccessParameter {
   };
 };
 
+/*
+ * One transaction of a batch. A read fills buf, a write sends the param.len
+ * bytes at buf.
+ */
+struct TransceiverAccess {
+  TransceiverAccessParameter param;
+  uint8_t* buf;
+  bool isWrite{false};
+};
+
 } // namespace facebook::fboss
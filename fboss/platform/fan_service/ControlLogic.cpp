@@ -5,13 +5,23 @@
 
 #include "fboss/platform/fan_service/ControlLogic.h"
 
+#include <algorithm>
+
 #include <folly/logging/xlog.h>
 
 #include "common/time/Time.h"
+#include "fboss/fsdb/common/Flags.h"
 #include "fboss/platform/fan_service/SensorData.h"
 #include "fboss/platform/fan_service/if/gen-cpp2/fan_service_config_constants.h"
 #include "fboss/platform/fan_service/if/gen-cpp2/fan_service_config_types.h"
 
+DEFINE_bool(
+    event_driven_fan_control,
+    false,
+    "Re-evaluate zones as sensor updates are pushed by FSDB, instead of "
+    "only on the periodic control cycle. Requires "
+    "--subscribe_to_stats_from_fsdb");
+
 namespace {
 
 auto constexpr kDefaultSensorReadFrequencyInSec = 30;
@@ -60,11 +70,113 @@ namespace facebook::fboss::platform::fan_service {
 ControlLogic::ControlLogic(FanServiceConfig config, std::shared_ptr<Bsp> bsp)
     : config_(config), pBsp_(bsp) {
   pSensorData_ = std::make_shared<SensorData>();
+  resolveConfigHandles();
 
   XLOG(INFO)
       << "Upon fan_service start up, program all fan pwm with transitional value of "
       << *config_.pwmTransitionValue();
   setTransitionValue();
+
+  if (FLAGS_event_driven_fan_control) {
+    if (FLAGS_subscribe_to_stats_from_fsdb) {
+      eventDriven_ = true;
+      pBsp_->fsdbSensorSubscriber()->setSensorDataCallback(
+          [this](const auto& changedSensors) {
+            processSensorUpdates(changedSensors);
+          });
+    } else {
+      XLOG(ERR) << "Event driven fan control needs sensor data from FSDB. "
+                << "Falling back to periodic control.";
+    }
+  }
+}
+
+ControlLogic::~ControlLogic() {
+  if (eventDriven_) {
+    // Waits for an in-flight update to finish
+    pBsp_->fsdbSensorSubscriber()->setSensorDataCallback(nullptr);
+  }
+}
+
+void ControlLogic::resolveConfigHandles() {
+  for (size_t i = 0; i < config_.sensors()->size(); ++i) {
+    sensorHandles_[*config_.sensors()->at(i).sensorName()] = i;
+  }
+  for (size_t i = 0; i < config_.optics()->size(); ++i) {
+    opticHandles_[*config_.optics()->at(i).opticName()] = i;
+  }
+  std::unordered_map<std::string, size_t> fanHandles;
+  for (size_t i = 0; i < config_.fans()->size(); ++i) {
+    fanHandles[*config_.fans()->at(i).fanName()] = i;
+  }
+
+  sensorReadCaches_.resize(config_.sensors()->size());
+  sensorPwmCalcCaches_.resize(config_.sensors()->size());
+  opticReadCaches_.resize(config_.optics()->size());
+  opticPwmCalcCaches_.resize(config_.optics()->size());
+  opticTypePwmCalcCaches_.resize(config_.optics()->size());
+  fanStatuses_.wlock()->resize(config_.fans()->size());
+
+  sensorZones_.resize(config_.sensors()->size());
+  zoneFans_.resize(config_.zones()->size());
+  zoneSensors_.resize(config_.zones()->size());
+  zoneOptics_.resize(config_.zones()->size());
+  for (size_t zoneIdx = 0; zoneIdx < config_.zones()->size(); ++zoneIdx) {
+    const auto& zone = config_.zones()->at(zoneIdx);
+    // A zone component is looked up as a sensor first, then as an optic
+    for (const auto& sensorName : *zone.sensorNames()) {
+      if (auto it = sensorHandles_.find(sensorName);
+          it != sensorHandles_.end()) {
+        zoneSensors_[zoneIdx].push_back(it->second);
+        sensorZones_[it->second].push_back(zoneIdx);
+      } else if (auto opticIt = opticHandles_.find(sensorName);
+                 opticIt != opticHandles_.end()) {
+        zoneOptics_[zoneIdx].push_back(opticIt->second);
+      }
+    }
+    // Keep fans in config order, which is the order they are programmed in
+    for (const auto& fanName : *zone.fanNames()) {
+      if (auto it = fanHandles.find(fanName); it != fanHandles.end()) {
+        zoneFans_[zoneIdx].push_back(it->second);
+      }
+    }
+    std::sort(zoneFans_[zoneIdx].begin(), zoneFans_[zoneIdx].end());
+    zoneFans_[zoneIdx].erase(
+        std::unique(zoneFans_[zoneIdx].begin(), zoneFans_[zoneIdx].end()),
+        zoneFans_[zoneIdx].end());
+  }
+}
+
+void ControlLogic::setSensorData(std::shared_ptr<SensorData> pS) {
+  if (pS == pSensor_) {
+    return;
+  }
+  pSensor_ = pS;
+  sensorDataHandles_.clear();
+  for (const auto& sensor : *config_.sensors()) {
+    sensorDataHandles_.push_back(
+        pSensor_->resolveSensorHandle(*sensor.sensorName()));
+  }
+}
+
+const std::map<std::string, FanStatus> ControlLogic::getFanStatuses() {
+  std::map<std::string, FanStatus> fanStatuses;
+  auto lockedFanStatuses = fanStatuses_.rlock();
+  for (size_t fanIdx = 0; fanIdx < config_.fans()->size(); ++fanIdx) {
+    fanStatuses[*config_.fans()->at(fanIdx).fanName()] =
+        (*lockedFanStatuses)[fanIdx];
+  }
+  return fanStatuses;
+}
+
+std::map<std::string, SensorReadCache> ControlLogic::getSensorCaches() const {
+  std::map<std::string, SensorReadCache> sensorCaches;
+  for (size_t sensorIdx = 0; sensorIdx < config_.sensors()->size();
+       ++sensorIdx) {
+    sensorCaches[*config_.sensors()->at(sensorIdx).sensorName()] =
+        sensorReadCaches_[sensorIdx];
+  }
+  return sensorCaches;
 }
 
 unsigned int ControlLogic::getControlFrequency() const {
@@ -82,13 +194,15 @@ unsigned int ControlLogic::getSensorFetchFrequency() const {
 }
 
 void ControlLogic::controlFan() {
+  std::lock_guard<std::mutex> lock(controlMutex_);
   uint64_t currentTimeSec = pBsp_->getCurrentTime();
   // Update Sensor Value based according to fetch frequency
   if ((currentTimeSec - lastSensorFetchTimeSec_) >= getSensorFetchFrequency()) {
     bool sensorReadOK = false;
     bool opticsReadOK = false;
 
-    // Get the updated sensor data
+    // Get the updated sensor data. In event driven mode this is a copy of
+    // what FSDB pushed, and catches up on anything the callback skipped.
     try {
       pBsp_->getSensorData(pSensorData_);
       sensorReadOK = true;
@@ -218,11 +332,12 @@ float ControlLogic::calculateIncrementalPid(
   return pwm;
 }
 
-void ControlLogic::updateTargetPwm(const Sensor& sensor) {
+void ControlLogic::updateTargetPwm(size_t sensorIdx, uint64_t lastCalcTimeSec) {
   int16_t targetPwm{0};
   TempToPwmMap tableToUse;
-  auto& readCache = sensorReadCaches_[*sensor.sensorName()];
-  auto& pwmCalcCache = pwmCalcCaches_[*sensor.sensorName()];
+  const auto& sensor = config_.sensors()->at(sensorIdx);
+  auto& readCache = sensorReadCaches_[sensorIdx];
+  auto& pwmCalcCache = sensorPwmCalcCaches_[sensorIdx];
   const auto& pwmCalcType = *sensor.pwmCalcType();
 
   if (pwmCalcType == constants::SENSOR_PWM_CALC_TYPE_FOUR_LINEAR_TABLE()) {
@@ -270,7 +385,7 @@ void ControlLogic::updateTargetPwm(const Sensor& sensor) {
   }
 
   if (pwmCalcType == constants::SENSOR_PWM_CALC_TYPE_PID()) {
-    uint64_t dT = pBsp_->getCurrentTime() - lastControlExecutionTimeSec_;
+    uint64_t dT = pBsp_->getCurrentTime() - lastCalcTimeSec;
     targetPwm = calculatePid(
         *sensor.sensorName(),
         readCache.lastReadValue,
@@ -285,50 +400,125 @@ void ControlLogic::updateTargetPwm(const Sensor& sensor) {
 }
 
 void ControlLogic::getSensorUpdate() {
-  for (const auto& sensor : *config_.sensors()) {
-    bool sensorAccessFail = false;
-    const auto sensorName = *sensor.sensorName();
-    auto& readCache = sensorReadCaches_[sensorName];
-
-    // STEP 1: Get reading.
-    auto sensorEntry = pSensor_->getSensorEntry(sensorName);
-    if (sensorEntry) {
-      float readValue = sensorEntry->value / *sensor.scale();
-      readCache.lastReadValue = readValue;
-      readCache.lastUpdatedTime = sensorEntry->lastUpdated;
-      readCache.sensorFailed = false;
-      XLOG(ERR) << fmt::format(
-          "{}: Sensor read value (after scaling) is {}", sensorName, readValue);
-    } else {
-      XLOG(INFO) << fmt::format(
-          "{}: Failure to get data (either wrong entry or read failure)",
-          sensorName);
-      sensorAccessFail = true;
+  for (size_t sensorIdx = 0; sensorIdx < config_.sensors()->size();
+       ++sensorIdx) {
+    processSensorReading(sensorIdx);
+
+    // STEP 2: Calculate target pwm. Pushed updates may already have done
+    // so since the last cycle.
+    const auto& readCache = sensorReadCaches_[sensorIdx];
+    if (readCache.lastEventCalcTimeSec == pBsp_->getCurrentTime()) {
+      continue;
     }
+    updateTargetPwm(
+        sensorIdx,
+        std::max(lastControlExecutionTimeSec_, readCache.lastEventCalcTimeSec));
+  }
+}
 
-    fb303::fbData->setCounter(
-        fmt::format(kSensorReadFailure, sensorName), sensorAccessFail);
-    fb303::fbData->setCounter(
-        fmt::format(kSensorReadValue, sensorName), readCache.lastReadValue);
-    if (sensorAccessFail) {
-      // If the sensor data cache is stale for a while, we consider it as the
-      // failure of such sensor
-      uint64_t timeDiffInSec =
-          pBsp_->getCurrentTime() - readCache.lastUpdatedTime;
-      if (timeDiffInSec >= kSensorFailThresholdInSec) {
-        readCache.sensorFailed = true;
-        numSensorFailed_++;
+void ControlLogic::processSensorReading(size_t sensorIdx) {
+  bool sensorAccessFail = false;
+  const auto& sensor = config_.sensors()->at(sensorIdx);
+  const auto& sensorName = *sensor.sensorName();
+  auto& readCache = sensorReadCaches_[sensorIdx];
+
+  // STEP 1: Get reading.
+  const auto* sensorEntry =
+      pSensor_->getSensorEntry(sensorDataHandles_[sensorIdx]);
+  if (sensorEntry) {
+    float readValue = sensorEntry->value / *sensor.scale();
+    readCache.lastReadValue = readValue;
+    readCache.lastUpdatedTime = sensorEntry->lastUpdated;
+    readCache.sensorFailed = false;
+    XLOG(ERR) << fmt::format(
+        "{}: Sensor read value (after scaling) is {}", sensorName, readValue);
+  } else {
+    XLOG(INFO) << fmt::format(
+        "{}: Failure to get data (either wrong entry or read failure)",
+        sensorName);
+    sensorAccessFail = true;
+  }
+
+  fb303::fbData->setCounter(
+      fmt::format(kSensorReadFailure, sensorName), sensorAccessFail);
+  fb303::fbData->setCounter(
+      fmt::format(kSensorReadValue, sensorName), readCache.lastReadValue);
+  if (sensorAccessFail) {
+    // If the sensor data cache is stale for a while, we consider it as the
+    // failure of such sensor
+    uint64_t timeDiffInSec =
+        pBsp_->getCurrentTime() - readCache.lastUpdatedTime;
+    if (timeDiffInSec >= kSensorFailThresholdInSec) {
+      readCache.sensorFailed = true;
+      numSensorFailed_++;
+    }
+  }
+}
+
+void ControlLogic::processSensorUpdates(
+    const FsdbSensorSubscriber::SensorDataMap& changedSensors) {
+  std::lock_guard<std::mutex> lock(controlMutex_);
+  // Until the first full cycle has run there is no fan state or boost
+  // decision to act on. Keep the readings for that cycle.
+  if (!pSensor_) {
+    for (const auto& [sensorName, sensorData] : changedSensors) {
+      if (sensorData.value().has_value() &&
+          sensorData.timeStamp().has_value()) {
+        pSensorData_->updateSensorEntry(
+            sensorName, *sensorData.value(), *sensorData.timeStamp());
       }
     }
+    return;
+  }
 
-    // STEP 2: Calculate target pwm
-    updateTargetPwm(sensor);
+  auto now = pBsp_->getCurrentTime();
+  std::vector<bool> zonesToUpdate(config_.zones()->size(), false);
+  bool anyZone = false;
+  for (const auto& [sensorName, sensorData] : changedSensors) {
+    auto it = sensorHandles_.find(sensorName);
+    if (it == sensorHandles_.end() || !sensorData.value().has_value() ||
+        !sensorData.timeStamp().has_value()) {
+      continue;
+    }
+    auto sensorIdx = it->second;
+    pSensor_->updateSensorEntry(
+        sensorDataHandles_[sensorIdx],
+        *sensorData.value(),
+        *sensorData.timeStamp());
+    processSensorReading(sensorIdx);
+
+    auto& readCache = sensorReadCaches_[sensorIdx];
+    auto lastCalcTimeSec =
+        std::max(lastControlExecutionTimeSec_, readCache.lastEventCalcTimeSec);
+    if (now == lastCalcTimeSec) {
+      // PID needs time to have passed. The reading is cached and will be
+      // used by the next sample or the next control cycle.
+      continue;
+    }
+    updateTargetPwm(sensorIdx, lastCalcTimeSec);
+    readCache.lastEventCalcTimeSec = now;
+    for (auto zoneIdx : sensorZones_[sensorIdx]) {
+      zonesToUpdate[zoneIdx] = true;
+      anyZone = true;
+    }
+  }
+  if (!anyZone) {
+    return;
   }
+
+  fanStatuses_.withWLock([&](auto& fanStatuses) {
+    for (size_t zoneIdx = 0; zoneIdx < zonesToUpdate.size(); ++zoneIdx) {
+      if (zonesToUpdate[zoneIdx]) {
+        programZoneFans(zoneIdx, boostMode_, fanStatuses);
+      }
+    }
+  });
 }
 
 void ControlLogic::getOpticsUpdate() {
-  for (const auto& optic : *config_.optics()) {
-    std::string opticName = *optic.opticName();
+  for (size_t opticIdx = 0; opticIdx < config_.optics()->size(); ++opticIdx) {
+    const auto& optic = config_.optics()->at(opticIdx);
+    const auto& opticName = *optic.opticName();
 
     auto opticEntry = pSensor_->getOpticEntry(opticName);
     if (!opticEntry || opticEntry->data.size() == 0) {
@@ -370,7 +560,6 @@ void ControlLogic::getOpticsUpdate() {
       // pwm using PID method
       // Step 1. Get the max temperature per optic type
       std::unordered_map<std::string, float> maxValue;
-      std::string cacheKey;
       for (const auto& [opticType, value] : opticEntry->data) {
         if (maxValue.find(opticType) == maxValue.end()) {
           maxValue[opticType] = value;
@@ -389,11 +578,9 @@ void ControlLogic::getOpticsUpdate() {
               "Optic {} does not have PID setting", opticType);
           continue;
         }
-        // Cache key is unique as long as opticName is unique
-        cacheKey = opticName + opticType;
-        auto& pwmCalcCache = pwmCalcCaches_[cacheKey];
+        auto& pwmCalcCache = opticTypePwmCalcCaches_[opticIdx][opticType];
         pwmCalcCache.previousTargetPwm =
-            pwmCalcCaches_[opticName].previousTargetPwm;
+            opticPwmCalcCaches_[opticIdx].previousTargetPwm;
 
         uint64_t dT = pBsp_->getCurrentTime() - lastControlExecutionTimeSec_;
         float pwm =
@@ -410,26 +597,12 @@ void ControlLogic::getOpticsUpdate() {
         "Optics: Aggregation Type: {}. Aggregate PWM is {}",
         aggregationType,
         aggOpticPwm);
-    opticReadCaches_[opticName] = aggOpticPwm;
+    opticReadCaches_[opticIdx] = aggOpticPwm;
     pSensor_->updateOpticDataProcessingTimestamp(
         opticName, opticEntry->qsfpServiceTimeStamp);
   }
 }
 
-bool ControlLogic::isSensorPresentInConfig(const std::string& sensorName) {
-  for (auto& sensor : *config_.sensors()) {
-    if (*sensor.sensorName() == sensorName) {
-      return true;
-    }
-  }
-  for (auto& optic : *config_.optics()) {
-    if (*optic.opticName() == sensorName) {
-      return true;
-    }
-  }
-  return false;
-}
-
 bool ControlLogic::isFanPresentInDevice(const Fan& fan) {
   unsigned int readVal;
   bool readSuccessful = false;
@@ -528,19 +701,21 @@ void ControlLogic::programLed(const Fan& fan, bool fanFailed) {
       valueToWrite);
 }
 
-int16_t ControlLogic::calculateZonePwm(const Zone& zone, bool boostMode) {
+int16_t ControlLogic::calculateZonePwm(size_t zoneIdx, bool boostMode) {
+  const auto& zone = config_.zones()->at(zoneIdx);
   auto zoneType = *zone.zoneType();
   int16_t zonePwm{0};
   int totalPwmConsidered{0};
-  for (const auto& sensorName : *zone.sensorNames()) {
-    int16_t pwmForThisSensor;
-    if (sensorReadCaches_.find(sensorName) != sensorReadCaches_.end()) {
-      pwmForThisSensor = sensorReadCaches_[sensorName].targetPwmCache;
-    } else if (opticReadCaches_.find(sensorName) != opticReadCaches_.end()) {
-      pwmForThisSensor = opticReadCaches_[sensorName];
-    } else {
-      continue;
+  std::vector<int16_t> componentPwms;
+  for (auto sensorIdx : zoneSensors_[zoneIdx]) {
+    componentPwms.push_back(sensorReadCaches_[sensorIdx].targetPwmCache);
+  }
+  for (auto opticIdx : zoneOptics_[zoneIdx]) {
+    if (opticReadCaches_[opticIdx]) {
+      componentPwms.push_back(*opticReadCaches_[opticIdx]);
     }
+  }
+  for (auto pwmForThisSensor : componentPwms) {
     if (zoneType == constants::ZONE_TYPE_MAX()) {
       zonePwm = std::max(zonePwm, pwmForThisSensor);
     } else if (zoneType == constants::ZONE_TYPE_MIN()) {
@@ -566,48 +741,48 @@ int16_t ControlLogic::calculateZonePwm(const Zone& zone, bool boostMode) {
       zonePwm);
   // Update the previous pwm value in each associated sensors,
   // so that they may be used in the next calculation.
-  for (const auto& sensorName : *zone.sensorNames()) {
-    if (isSensorPresentInConfig(sensorName)) {
-      pwmCalcCaches_[sensorName].previousTargetPwm = zonePwm;
-    }
+  for (auto sensorIdx : zoneSensors_[zoneIdx]) {
+    sensorPwmCalcCaches_[sensorIdx].previousTargetPwm = zonePwm;
+  }
+  for (auto opticIdx : zoneOptics_[zoneIdx]) {
+    opticPwmCalcCaches_[opticIdx].previousTargetPwm = zonePwm;
   }
   return zonePwm;
 }
 
 void ControlLogic::setTransitionValue() {
   fanStatuses_.withWLock([&](auto& fanStatuses) {
-    for (const auto& zone : *config_.zones()) {
-      for (const auto& fan : *config_.fans()) {
-        // If this fan belongs to the zone, then write the transitional value
-        if (std::find(
-                zone.fanNames()->begin(),
-                zone.fanNames()->end(),
-                *fan.fanName()) == zone.fanNames()->end()) {
-          continue;
-        }
-        for (const auto& sensorName : *zone.sensorNames()) {
-          if (isSensorPresentInConfig(sensorName)) {
-            pwmCalcCaches_[sensorName].previousTargetPwm =
-                *config_.pwmTransitionValue();
-          }
-        }
+    for (size_t zoneIdx = 0; zoneIdx < config_.zones()->size(); ++zoneIdx) {
+      const auto& zone = config_.zones()->at(zoneIdx);
+      // Write the transitional value to the fans of this zone
+      for (auto sensorIdx : zoneSensors_[zoneIdx]) {
+        sensorPwmCalcCaches_[sensorIdx].previousTargetPwm =
+            *config_.pwmTransitionValue();
+      }
+      for (auto opticIdx : zoneOptics_[zoneIdx]) {
+        opticPwmCalcCaches_[opticIdx].previousTargetPwm =
+            *config_.pwmTransitionValue();
+      }
+      for (auto fanIdx : zoneFans_[zoneIdx]) {
+        const auto& fan = config_.fans()->at(fanIdx);
+        auto& fanStatus = fanStatuses[fanIdx];
         const auto [fanFailed, newFanPwm] = programFan(
             zone,
             fan,
-            *fanStatuses[*fan.fanName()].pwmToProgram(),
+            *fanStatus.pwmToProgram(),
             *config_.pwmTransitionValue());
-        fanStatuses[*fan.fanName()].pwmToProgram() = newFanPwm;
+        fanStatus.pwmToProgram() = newFanPwm;
         if (fanFailed) {
           programLed(fan, fanFailed);
         }
-        fanStatuses[*fan.fanName()].fanFailed() = fanFailed;
+        fanStatus.fanFailed() = fanFailed;
       }
     }
   });
 }
 
 void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
-  pSensor_ = pS;
+  setSensorData(pS);
 
   numFanFailed_ = 0;
   numSensorFailed_ = 0;
@@ -633,23 +808,25 @@ void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
   XLOG(INFO) << "Processing Fans ...";
   fanStatuses_.withWLock([&](auto& fanStatuses) {
     // Update fan status with new rpm and timestamp.
-    for (const auto& fan : *config_.fans()) {
+    for (size_t fanIdx = 0; fanIdx < config_.fans()->size(); ++fanIdx) {
+      const auto& fan = config_.fans()->at(fanIdx);
+      auto& fanStatus = fanStatuses[fanIdx];
       auto [fanAccessFailed, fanRpm, fanTimestamp] = readFanRpm(fan);
       if (fanAccessFailed) {
-        fanStatuses[*fan.fanName()].rpm().reset();
+        fanStatus.rpm().reset();
       } else {
-        fanStatuses[*fan.fanName()].rpm() = fanRpm;
-        fanStatuses[*fan.fanName()].lastSuccessfulAccessTime() = fanTimestamp;
+        fanStatus.rpm() = fanRpm;
+        fanStatus.lastSuccessfulAccessTime() = fanTimestamp;
       }
       // Ignore last access failure if it happened < kFanFailThresholdInSec
       auto timeSinceLastSuccessfulAccess = pBsp_->getCurrentTime() -
-          *fanStatuses[*fan.fanName()].lastSuccessfulAccessTime();
+          *fanStatus.lastSuccessfulAccessTime();
       auto fanFailed = fanAccessFailed &&
           (timeSinceLastSuccessfulAccess >= kFanFailThresholdInSec);
       if (fanFailed) {
         numFanFailed_++;
       }
-      fanStatuses[*fan.fanName()].fanFailed() = fanFailed;
+      fanStatus.fanFailed() = fanFailed;
     }
   });
 
@@ -679,33 +856,38 @@ void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
   bool boostMode = (missingOpticsUpdate || fanFailures || sensorFailures);
 
   // STEP 5: Calculate and program fan PWMs
+  boostMode_ = boostMode;
   fanStatuses_.withWLock([&](auto& fanStatuses) {
-    for (const auto& zone : *config_.zones()) {
-      int16_t zonePwm = calculateZonePwm(zone, boostMode);
-      for (const auto& fan : *config_.fans()) {
-        if (std::find(
-                zone.fanNames()->begin(),
-                zone.fanNames()->end(),
-                *fan.fanName()) == zone.fanNames()->end()) {
-          continue;
-        }
-        const auto [fanFailed, newFanPwm] = programFan(
-            zone, fan, *fanStatuses[*fan.fanName()].pwmToProgram(), zonePwm);
-        fanStatuses[*fan.fanName()].pwmToProgram() = newFanPwm;
-        if (fanFailed) {
-          // Only override the fanFailed if fan programming failed.
-          fanStatuses[*fan.fanName()].fanFailed() = fanFailed;
-        }
-      }
+    for (size_t zoneIdx = 0; zoneIdx < config_.zones()->size(); ++zoneIdx) {
+      programZoneFans(zoneIdx, boostMode, fanStatuses);
     }
 
     // STEP 6: Program fan LEDs
-    for (const auto& fan : *config_.fans()) {
-      programLed(fan, *fanStatuses[*fan.fanName()].fanFailed());
+    for (size_t fanIdx = 0; fanIdx < config_.fans()->size(); ++fanIdx) {
+      programLed(config_.fans()->at(fanIdx), *fanStatuses[fanIdx].fanFailed());
     }
   });
 }
 
+void ControlLogic::programZoneFans(
+    size_t zoneIdx,
+    bool boostMode,
+    std::vector<FanStatus>& fanStatuses) {
+  const auto& zone = config_.zones()->at(zoneIdx);
+  int16_t zonePwm = calculateZonePwm(zoneIdx, boostMode);
+  for (auto fanIdx : zoneFans_[zoneIdx]) {
+    const auto& fan = config_.fans()->at(fanIdx);
+    auto& fanStatus = fanStatuses[fanIdx];
+    const auto [fanFailed, newFanPwm] =
+        programFan(zone, fan, *fanStatus.pwmToProgram(), zonePwm);
+    fanStatus.pwmToProgram() = newFanPwm;
+    if (fanFailed) {
+      // Only override the fanFailed if fan programming failed.
+      fanStatus.fanFailed() = fanFailed;
+    }
+  }
+}
+
 void ControlLogic::setFanHold(std::optional<int> pwm) {
   fanHoldPwm_.store(pwm);
 }
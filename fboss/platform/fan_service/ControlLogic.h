@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "fboss/platform/fan_service/Bsp.h"
 #include "fboss/platform/fan_service/SensorData.h"
 #include "fboss/platform/fan_service/if/gen-cpp2/fan_service_types.h"
@@ -13,6 +17,8 @@ struct SensorReadCache {
   int16_t targetPwmCache{0};
   uint64_t lastUpdatedTime;
   bool sensorFailed{false};
+  // When the target pwm was last calculated from a pushed sensor update
+  uint64_t lastEventCalcTimeSec{0};
 };
 
 struct PwmCalcCache {
@@ -28,19 +34,23 @@ struct PwmCalcCache {
 // Role : This class contains the logics to detect sensor/fan failures and,
 //        the logics to calculate the PWM values from sensor reading.
 //        Currently supports PID, Incremental PID and Four Tables method
+//
+// With --event_driven_fan_control, sensor readings pushed by FSDB are
+// applied as they arrive and only the zones fed by the changed sensors are
+// re-evaluated. The periodic control cycle then acts as a safety deadline
+// that re-reads all sensors and fans and re-evaluates every zone.
 class ControlLogic {
  public:
   ControlLogic(FanServiceConfig config, std::shared_ptr<Bsp> bsp);
-  ~ControlLogic() = default;
+  ~ControlLogic();
 
   void updateControl(std::shared_ptr<SensorData> pS);
+  // Apply sensor readings that changed and re-program the affected zones
+  void processSensorUpdates(
+      const FsdbSensorSubscriber::SensorDataMap& changedSensors);
   void setTransitionValue();
-  const std::map<std::string, FanStatus> getFanStatuses() {
-    return fanStatuses_.copy();
-  }
-  const std::map<std::string, SensorReadCache>& getSensorCaches() {
-    return sensorReadCaches_;
-  }
+  const std::map<std::string, FanStatus> getFanStatuses();
+  std::map<std::string, SensorReadCache> getSensorCaches() const;
 
   void controlFan();
   void getSensorDataThrift(std::shared_ptr<SensorData> pSensorData) const {
@@ -76,7 +86,10 @@ class ControlLogic {
   uint64_t lastSensorFetchTimeSec_{0};
 
   // Private Methods
+  void resolveConfigHandles();
+  void setSensorData(std::shared_ptr<SensorData> pS);
   void getSensorUpdate();
+  void processSensorReading(size_t sensorIdx);
   std::tuple<bool /*fanAccessFailed*/, int /*rpm*/, uint64_t /*timestamp*/>
   readFanRpm(const Fan& fan);
   void getOpticsUpdate();
@@ -91,18 +104,49 @@ class ControlLogic {
       float value,
       PwmCalcCache& pwmCalcCache,
       const PidSetting& pidSetting);
-  int16_t calculateZonePwm(const Zone& zone, bool boostMode);
-  void updateTargetPwm(const Sensor& sensorItem);
+  int16_t calculateZonePwm(size_t zoneIdx, bool boostMode);
+  void programZoneFans(
+      size_t zoneIdx,
+      bool boostMode,
+      std::vector<FanStatus>& fanStatuses);
+  void updateTargetPwm(size_t sensorIdx, uint64_t lastCalcTimeSec);
   void programLed(const Fan& fan, bool fanFailed);
   bool isFanPresentInDevice(const Fan& fan);
-  bool isSensorPresentInConfig(const std::string& sensorName);
 
-  folly::Synchronized<std::map<std::string /* fanName */, FanStatus>>
-      fanStatuses_;
+  // Per component state is indexed by the component's position in the
+  // config, e.g. sensorReadCaches_[i] is the cache of config_.sensors()[i].
+  folly::Synchronized<std::vector<FanStatus>> fanStatuses_;
   std::atomic<std::optional<int>> fanHoldPwm_;
-  std::map<std::string /* sensorName */, SensorReadCache> sensorReadCaches_;
-  std::map<std::string /* sensorName */, int16_t /* pwm */> opticReadCaches_;
-  std::map<std::string /* sensorName */, PwmCalcCache> pwmCalcCaches_;
+  std::vector<SensorReadCache> sensorReadCaches_;
+  // Unset until the optic is first read
+  std::vector<std::optional<int16_t> /* pwm */> opticReadCaches_;
+  std::vector<PwmCalcCache> sensorPwmCalcCaches_;
+  std::vector<PwmCalcCache> opticPwmCalcCaches_;
+  // Optic index -> PID state per optic type
+  std::vector<std::unordered_map<std::string, PwmCalcCache>>
+      opticTypePwmCalcCaches_;
   std::shared_ptr<SensorData> pSensorData_{nullptr};
+  // Sensor index -> handle of the sensor in pSensor_
+  std::vector<SensorHandle> sensorDataHandles_;
+
+  // Config lookups resolved to indices once at startup, so the control
+  // loop does not search the config by name.
+  // Sensor name -> index into config_.sensors()
+  std::unordered_map<std::string, size_t> sensorHandles_;
+  // Optic name -> index into config_.optics()
+  std::unordered_map<std::string, size_t> opticHandles_;
+  // Zone index -> indices of its fans in config_.fans()
+  std::vector<std::vector<size_t>> zoneFans_;
+  // Zone index -> indices of the sensors and optics it aggregates
+  std::vector<std::vector<size_t>> zoneSensors_;
+  std::vector<std::vector<size_t>> zoneOptics_;
+  // Sensor index -> indices of the zones it feeds in config_.zones()
+  std::vector<std::vector<size_t>> sensorZones_;
+
+  bool eventDriven_{false};
+  // Boost decision of the last full control cycle, reused by pushed updates
+  bool boostMode_{false};
+  // Serializes the periodic control cycle with pushed sensor updates
+  std::mutex controlMutex_;
 };
 } // namespace facebook::fboss::platform::fan_service
@@ -3,6 +3,7 @@
 #include "fboss/platform/fan_service/FsdbSensorSubscriber.h"
 
 #include <optional>
+#include <utility>
 
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -27,22 +28,33 @@ void FsdbSensorSubscriber::subscribeToStatsOrState(
     std::vector<std::string> path,
     folly::Synchronized<T>& storage,
     bool stats,
-    std::atomic<uint64_t>& lastUpdateTime) {
+    std::atomic<uint64_t>& lastUpdateTime,
+    std::function<void(const T& oldData, const T& newData)> onUpdate) {
   auto stateCb = [](fsdb::SubscriptionState /*old*/,
                     fsdb::SubscriptionState /*new*/) {};
-  auto dataCb = [&](fsdb::OperState&& state) {
+  auto dataCb = [&storage, &lastUpdateTime, onUpdate = std::move(onUpdate)](
+                    fsdb::OperState&& state) {
+    T newData{};
+    if (auto contents = state.contents()) {
+      newData = apache::thrift::BinarySerializer::deserialize<T>(*contents);
+    }
+    T oldData;
     storage.withWLock([&](auto& locked) {
       if (auto metadata = state.metadata()) {
         if (auto lastConfirmedAt = metadata->lastConfirmedAt()) {
           lastUpdateTime.store(*lastConfirmedAt);
         }
       }
-      if (auto contents = state.contents()) {
-        locked = apache::thrift::BinarySerializer::deserialize<T>(*contents);
+      if (onUpdate) {
+        oldData = std::exchange(locked, newData);
       } else {
-        locked = {};
+        locked = std::move(newData);
       }
     });
+    // Outside the lock, so onUpdate may read back through the getters
+    if (onUpdate) {
+      onUpdate(oldData, newData);
+    }
   };
   if (stats) {
     pubSubMgr()->addStatPathSubscription(path, stateCb, dataCb);
@@ -72,7 +84,36 @@ void FsdbSensorSubscriber::subscribeToSensorServiceStat() {
       getSensorDataStatsPath(),
       sensorSvcData,
       true /* stats */,
-      sensorStatsLastUpdatedTime);
+      sensorStatsLastUpdatedTime,
+      std::function<void(const SensorDataMap&, const SensorDataMap&)>(
+          [this](const auto& oldData, const auto& newData) {
+            notifySensorDataChanges(oldData, newData);
+          }));
+}
+
+void FsdbSensorSubscriber::setSensorDataCallback(SensorDataCallback callback) {
+  *sensorDataCallback_.wlock() = std::move(callback);
+}
+
+void FsdbSensorSubscriber::notifySensorDataChanges(
+    const SensorDataMap& oldData,
+    const SensorDataMap& newData) {
+  auto callback = sensorDataCallback_.rlock();
+  if (!*callback) {
+    return;
+  }
+  SensorDataMap changed;
+  for (const auto& [sensorName, sensorData] : newData) {
+    auto it = oldData.find(sensorName);
+    if (it == oldData.end() || !(it->second == sensorData)) {
+      changed.emplace(sensorName, sensorData);
+    }
+  }
+  // Sensors that went missing are left to the staleness check in the
+  // periodic control cycle
+  if (!changed.empty()) {
+    (*callback)(changed);
+  }
 }
 
 std::map<std::string, fboss::platform::sensor_service::SensorData>
@@ -9,6 +9,7 @@
 #include "fboss/qsfp_service/if/gen-cpp2/qsfp_stats_types.h"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace facebook::fboss {
@@ -18,6 +19,11 @@ class FsdbPubSubManager;
 
 class FsdbSensorSubscriber {
  public:
+  using SensorDataMap =
+      std::map<std::string, fboss::platform::sensor_service::SensorData>;
+  // Invoked with the sensors whose reading changed in an FSDB update
+  using SensorDataCallback = std::function<void(const SensorDataMap&)>;
+
   explicit FsdbSensorSubscriber(fsdb::FsdbPubSubManager* pubSubMgr)
       : fsdbPubSubMgr_(pubSubMgr) {}
 
@@ -40,6 +46,7 @@ class FsdbSensorSubscriber {
 
   std::map<std::string, fboss::platform::sensor_service::SensorData>
   getSensorData() const;
+  void setSensorDataCallback(SensorDataCallback callback);
   std::map<int32_t, TcvrState> getTcvrState() const;
   std::map<int32_t, TcvrStats> getTcvrStats() const;
 
@@ -49,7 +56,12 @@ class FsdbSensorSubscriber {
       std::vector<std::string> path,
       folly::Synchronized<T>& storage,
       bool stats,
-      std::atomic<uint64_t>& lastUpdateTime);
+      std::atomic<uint64_t>& lastUpdateTime,
+      std::function<void(const T& oldData, const T& newData)> onUpdate =
+          nullptr);
+  void notifySensorDataChanges(
+      const SensorDataMap& oldData,
+      const SensorDataMap& newData);
   fsdb::FsdbPubSubManager* fsdbPubSubMgr_;
   std::atomic<uint64_t> sensorStatsLastUpdatedTime{0};
   std::atomic<uint64_t> qsfpStatsLastUpdatedTime{0};
@@ -60,6 +72,7 @@ class FsdbSensorSubscriber {
       sensorSvcData;
   folly::Synchronized<std::map<int32_t /* tcvrId */, TcvrState>> tcvrState;
   folly::Synchronized<std::map<int32_t /* tcvrId */, TcvrStats>> tcvrStats;
+  folly::Synchronized<SensorDataCallback> sensorDataCallback_;
 };
 
 } // namespace facebook::fboss
@@ -8,26 +8,62 @@ namespace facebook::fboss::platform::fan_service {
 
 std::optional<SensorEntry> SensorData::getSensorEntry(
     const std::string& name) const {
-  auto itr = sensorEntries_.find(name);
-  if (itr == sensorEntries_.end()) {
+  auto itr = sensorHandles_.find(name);
+  if (itr == sensorHandles_.end()) {
     return std::nullopt;
   }
-  return itr->second;
+  return sensorEntries_[itr->second];
 }
 
 void SensorData::updateSensorEntry(
     const std::string& name,
     float value,
     uint64_t timeStamp) {
-  auto sensorEntry = SensorEntry();
-  sensorEntry.name = name;
-  sensorEntry.value = value;
-  sensorEntry.lastUpdated = timeStamp;
-  sensorEntries_[name] = sensorEntry;
+  updateSensorEntry(resolveSensorHandle(name), value, timeStamp);
 }
 
 void SensorData::delSensorEntry(const std::string& name) {
-  sensorEntries_.erase(name);
+  if (auto itr = sensorHandles_.find(name); itr != sensorHandles_.end()) {
+    sensorEntries_[itr->second].reset();
+  }
+}
+
+SensorHandle SensorData::resolveSensorHandle(const std::string& name) {
+  auto [itr, inserted] = sensorHandles_.emplace(name, sensorEntries_.size());
+  if (inserted) {
+    sensorNames_.push_back(name);
+    sensorEntries_.emplace_back();
+  }
+  return itr->second;
+}
+
+const SensorEntry* SensorData::getSensorEntry(SensorHandle handle) const {
+  const auto& sensorEntry = sensorEntries_.at(handle);
+  return sensorEntry ? &*sensorEntry : nullptr;
+}
+
+void SensorData::updateSensorEntry(
+    SensorHandle handle,
+    float value,
+    uint64_t timeStamp) {
+  auto& sensorEntry = sensorEntries_.at(handle);
+  if (!sensorEntry) {
+    sensorEntry = SensorEntry();
+    sensorEntry->name = sensorNames_[handle];
+  }
+  sensorEntry->value = value;
+  sensorEntry->lastUpdated = timeStamp;
+}
+
+std::unordered_map<std::string, SensorEntry> SensorData::getSensorEntries()
+    const {
+  std::unordered_map<std::string, SensorEntry> sensorEntries;
+  for (const auto& [name, handle] : sensorHandles_) {
+    if (sensorEntries_[handle]) {
+      sensorEntries.emplace(name, *sensorEntries_[handle]);
+    }
+  }
+  return sensorEntries;
 }
 
 std::optional<OpticEntry> SensorData::getOpticEntry(
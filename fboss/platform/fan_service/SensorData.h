@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -32,12 +33,22 @@ struct OpticEntry {
   uint64_t dataProcessTimeStamp{0};
 };
 
+// Index of a sensor in a SensorData, for lookups that do not hash its name
+using SensorHandle = size_t;
+
 class SensorData {
  public:
   std::optional<SensorEntry> getSensorEntry(const std::string& name) const;
   void updateSensorEntry(const std::string& name, float data, uint64_t ts);
   void delSensorEntry(const std::string& name);
 
+  // Handle of the named sensor, whether or not it has data yet. Handles are
+  // only valid for the SensorData they were resolved from.
+  SensorHandle resolveSensorHandle(const std::string& name);
+  // nullptr if the sensor has no data
+  const SensorEntry* getSensorEntry(SensorHandle handle) const;
+  void updateSensorEntry(SensorHandle handle, float data, uint64_t ts);
+
   std::optional<OpticEntry> getOpticEntry(const std::string& name) const;
   void updateOpticEntry(
       const std::string& name,
@@ -50,14 +61,15 @@ class SensorData {
     return opticEntries_;
   }
 
-  std::unordered_map<std::string, SensorEntry> getSensorEntries() const {
-    return sensorEntries_;
-  }
+  std::unordered_map<std::string, SensorEntry> getSensorEntries() const;
 
   uint64_t getLastQsfpSvcTime();
 
  private:
-  std::unordered_map<std::string, SensorEntry> sensorEntries_;
+  std::unordered_map<std::string, SensorHandle> sensorHandles_;
+  std::vector<std::string> sensorNames_;
+  // Indexed by handle, unset while the sensor has no data
+  std::vector<std::optional<SensorEntry>> sensorEntries_;
   std::unordered_map<std::string, OpticEntry> opticEntries_;
   uint64_t lastSuccessfulQsfpServiceContact_;
 };
@@ -1,5 +1,6 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
+#include <set>
 #include <stdexcept>
 
 #include <gmock/gmock.h>
@@ -305,6 +306,72 @@ TEST_F(ControlLogicTests, UpdateControlSensorReadFailure) {
   }
 }
 
+TEST_F(ControlLogicTests, ProcessSensorUpdatesReprogramsAffectedZones) {
+  EXPECT_CALL(*mockBsp_, checkIfInitialSensorDataRead()).WillOnce(Return(true));
+  const auto& sensorName = *fanServiceConfig_.sensors()->at(1).sensorName();
+  std::set<std::string> affectedFans;
+  for (const auto& zone : *fanServiceConfig_.zones()) {
+    if (std::find(
+            zone.sensorNames()->begin(),
+            zone.sensorNames()->end(),
+            sensorName) != zone.sensorNames()->end()) {
+      affectedFans.insert(zone.fanNames()->begin(), zone.fanNames()->end());
+    }
+  }
+  ASSERT_FALSE(affectedFans.empty());
+
+  for (const auto& fan : *fanServiceConfig_.fans()) {
+    // Pushed updates only program the fans of affected zones, and never
+    // read fan rpm or presence
+    EXPECT_CALL(*mockBsp_, setFanPwmSysfs(*fan.pwmSysfsPath(), _))
+        .Times(affectedFans.count(*fan.fanName()) ? 3 : 2)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*mockBsp_, setFanLedSysfs(*fan.ledSysfsPath(), _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*mockBsp_, readSysfs(*fan.rpmSysfsPath()))
+        .WillOnce(Return(kDefaultRpm));
+    EXPECT_CALL(*mockBsp_, readSysfs(*fan.presenceSysfsPath()))
+        .WillOnce(Return(1 /* fan exists */));
+  }
+
+  controlLogic_->setTransitionValue();
+  // Updates pushed before the first control cycle are kept for that cycle
+  FsdbSensorSubscriber::SensorDataMap changedSensors;
+  sensor_service::SensorData hotSensor;
+  hotSensor.name() = sensorName;
+  hotSensor.value() = 120000;
+  hotSensor.timeStamp() = mockBsp_->getCurrentTime();
+  changedSensors[sensorName] = hotSensor;
+  controlLogic_->processSensorUpdates(changedSensors);
+  ASSERT_TRUE(controlLogic_->sensorData().getSensorEntry(sensorName));
+  EXPECT_EQ(
+      controlLogic_->sensorData().getSensorEntry(sensorName)->value,
+      *hotSensor.value());
+
+  controlLogic_->updateControl(sensorData_);
+  const auto fanStatuses = controlLogic_->getFanStatuses();
+
+  // Sensors not used by the config are ignored
+  FsdbSensorSubscriber::SensorDataMap unknownSensors;
+  unknownSensors["NOT_A_SENSOR"] = hotSensor;
+  controlLogic_->processSensorUpdates(unknownSensors);
+
+  controlLogic_->processSensorUpdates(changedSensors);
+  EXPECT_EQ(
+      sensorData_->getSensorEntry(sensorName)->value, *hotSensor.value());
+  for (const auto& [fanName, fanStatus] : controlLogic_->getFanStatuses()) {
+    if (affectedFans.count(fanName)) {
+      EXPECT_GT(
+          *fanStatus.pwmToProgram(),
+          *fanStatuses.at(fanName).pwmToProgram());
+    } else {
+      EXPECT_EQ(
+          *fanStatus.pwmToProgram(),
+          *fanStatuses.at(fanName).pwmToProgram());
+    }
+  }
+}
+
 TEST_F(ControlLogicTests, CalculatePid) {
   PidSetting pidSetting;
   pidSetting.setPoint() = 60;
@@ -0,0 +1,120 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/platform/platform_manager/DeviceWaiter.h"
+
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+
+#include <folly/File.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kInotifyMask =
+    IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_ATTRIB | IN_CLOSE_WRITE;
+
+// Subscribes to kernel uevents. Returns an invalid file if not permitted.
+folly::File openUeventSocket() {
+  int fd = socket(
+      AF_NETLINK,
+      SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+      NETLINK_KOBJECT_UEVENT);
+  if (fd < 0) {
+    XLOG(DBG1) << "Failed to open uevent socket: " << folly::errnoStr(errno);
+    return folly::File();
+  }
+  folly::File file(fd, true /* ownsFd */);
+  struct sockaddr_nl addr {};
+  addr.nl_family = AF_NETLINK;
+  addr.nl_groups = 1 /* kernel uevents */;
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+    XLOG(DBG1) << "Failed to bind uevent socket: " << folly::errnoStr(errno);
+    return folly::File();
+  }
+  return file;
+}
+
+// Watches the given directories, or their nearest existing ancestor for the
+// ones not created yet. Returns an invalid file if nothing could be watched.
+folly::File openInotify(const std::vector<fs::path>& watchDirs) {
+  if (watchDirs.empty()) {
+    return folly::File();
+  }
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0) {
+    XLOG(DBG1) << "Failed to init inotify: " << folly::errnoStr(errno);
+    return folly::File();
+  }
+  folly::File file(fd, true /* ownsFd */);
+  bool watching = false;
+  for (auto dir : watchDirs) {
+    std::error_code ec;
+    while (!dir.empty() && !fs::exists(dir, ec) && dir != dir.parent_path()) {
+      dir = dir.parent_path();
+    }
+    if (inotify_add_watch(fd, dir.c_str(), kInotifyMask) >= 0) {
+      watching = true;
+    }
+  }
+  return watching ? std::move(file) : folly::File();
+}
+
+void drain(int fd) {
+  std::array<char, 4096> buf;
+  while (read(fd, buf.data(), buf.size()) > 0) {
+  }
+}
+
+} // namespace
+
+namespace facebook::fboss::platform::platform_manager {
+
+bool waitUntil(
+    const std::function<bool()>& ready,
+    std::chrono::milliseconds timeout,
+    const std::vector<fs::path>& watchDirs,
+    std::chrono::milliseconds recheckInterval) {
+  if (ready()) {
+    return true;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  // Subscribe before the first check so that no event is missed in between.
+  auto uevents = openUeventSocket();
+  auto inotify = openInotify(watchDirs);
+  std::vector<struct pollfd> fds;
+  for (const auto& file : {&uevents, &inotify}) {
+    if (*file) {
+      fds.push_back({file->fd(), POLLIN, 0});
+    }
+  }
+  while (true) {
+    if (ready()) {
+      return true;
+    }
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+      return false;
+    }
+    auto waitMs = std::max<int64_t>(
+        1, std::min(remaining, recheckInterval).count());
+    if (poll(fds.data(), fds.size(), waitMs) > 0) {
+      for (auto& pfd : fds) {
+        if (pfd.revents & POLLIN) {
+          drain(pfd.fd);
+        }
+        pfd.revents = 0;
+      }
+    }
+  }
+}
+
+} // namespace facebook::fboss::platform::platform_manager
@@ -0,0 +1,25 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace facebook::fboss::platform::platform_manager {
+
+// Waits until `ready` returns true or `timeout` elapses, and returns the last
+// result of `ready`. Instead of sleeping for the whole timeout, `ready` is
+// re-evaluated whenever the kernel announces a device change (uevent netlink)
+// or an entry in one of `watchDirs` changes (inotify). sysfs does not support
+// inotify and uevents may be unavailable (e.g. in a container), so `ready` is
+// also re-evaluated every `recheckInterval`.
+bool waitUntil(
+    const std::function<bool()>& ready,
+    std::chrono::milliseconds timeout,
+    const std::vector<std::filesystem::path>& watchDirs = {},
+    std::chrono::milliseconds recheckInterval =
+        std::chrono::milliseconds(100));
+
+} // namespace facebook::fboss::platform::platform_manager
@@ -2,6 +2,7 @@
 
 #include "fboss/platform/platform_manager/I2cExplorer.h"
 #include "fboss/lib/i2c/I2cDevIo.h"
+#include "fboss/platform/platform_manager/DeviceWaiter.h"
 
 #include <folly/FileUtil.h>
 #include <folly/String.h>
@@ -14,8 +15,8 @@ namespace fs = std::filesystem;
 namespace {
 
 const re2::RE2 kI2cMuxChannelRegex{"channel-\\d+"};
-constexpr auto kI2cDevCreationWaitSecs = 5;
-constexpr auto kCpuI2cBusNumsWaitSecs = 1;
+constexpr auto kI2cDevCreationWaitSecs = std::chrono::seconds(5);
+constexpr auto kCpuI2cBusNumsWaitSecs = std::chrono::seconds(10);
 
 std::string getI2cAdapterName(const fs::path& busPath) {
   auto nameFile = busPath / "name";
@@ -48,9 +49,7 @@ std::map<std::string, uint16_t> I2cExplorer::getBusNums(
     const std::vector<std::string>& i2cAdaptersFromCpu) {
   std::map<std::string, uint16_t> busNums;
   const auto deviceRoot = fs::path("/sys/bus/i2c/devices");
-  const int maxRetries = 10;
-  for (int attempt = 1; attempt <= maxRetries; attempt++) {
-    XLOG(INFO) << "Probing CPU I2C BusNums -- Attempt #" << attempt;
+  auto probeBusNums = [&]() {
     for (const auto& dirEntry : fs::directory_iterator(deviceRoot)) {
       if (re2::RE2::FullMatch(
               dirEntry.path().filename().string(), kI2cBusNameRegex)) {
@@ -63,15 +62,16 @@ std::map<std::string, uint16_t> I2cExplorer::getBusNums(
         }
       }
     }
-    if (busNums.size() == i2cAdaptersFromCpu.size()) {
-      XLOG(INFO) << "Probed all CPU I2C BusNums";
-      return busNums;
-    }
-    sleep(kCpuI2cBusNumsWaitSecs);
+    return busNums.size() == i2cAdaptersFromCpu.size();
+  };
+  XLOG(INFO) << "Probing CPU I2C BusNums";
+  if (waitUntil(probeBusNums, kCpuI2cBusNumsWaitSecs, {deviceRoot})) {
+    XLOG(INFO) << "Probed all CPU I2C BusNums";
+    return busNums;
   }
   throw std::runtime_error(fmt::format(
       "Failed to get all CPU I2C BusNums over {}s",
-      kCpuI2cBusNumsWaitSecs * maxRetries));
+      kCpuI2cBusNumsWaitSecs.count()));
 }
 
 bool I2cExplorer::isI2cDevicePresent(uint16_t busNum, const I2cAddr& addr)
@@ -225,12 +225,14 @@ bool I2cExplorer::isI2cDeviceCreated(uint16_t busNum, const I2cAddr& addr)
     return true;
   }
   XLOG(INFO) << fmt::format(
-      "I2cDevice at busNum: {} and addr: {} is not yet created. Waiting for {}s",
+      "I2cDevice at busNum: {} and addr: {} is not yet created. Waiting for "
+      "up to {}s",
       busNum,
       addr.hex4Str(),
+      kI2cDevCreationWaitSecs.count());
+  return waitUntil(
+      [&]() { return isI2cDevicePresent(busNum, addr); },
       kI2cDevCreationWaitSecs);
-  sleep(kI2cDevCreationWaitSecs);
-  return isI2cDevicePresent(busNum, addr);
 }
 
 } // namespace facebook::fboss::platform::platform_manager
@@ -10,6 +10,7 @@
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
+#include "fboss/platform/platform_manager/DeviceWaiter.h"
 #include "fboss/platform/platform_manager/I2cExplorer.h"
 #include "fboss/platform/platform_manager/Utils.h"
 
@@ -19,8 +20,7 @@ using namespace facebook::fboss::platform::platform_manager;
 namespace {
 const re2::RE2 kSpiBusRe{"spi\\d+"};
 const re2::RE2 kSpiDevIdRe{"spi(?P<BusNum>\\d+).(?P<ChipSelect>\\d+)"};
-// TODO (T181346009) for more granular interval retries.
-constexpr auto kPciWaitSecs = 5;
+constexpr auto kPciWaitSecs = std::chrono::seconds(5);
 
 bool hasEnding(std::string const& input, std::string const& ending) {
   if (input.length() >= ending.length()) {
@@ -66,13 +66,15 @@ PciDevice::PciDevice(
 
   if (!fs::exists(charDevPath_)) {
     XLOG(INFO) << fmt::format(
-        "No character device found at {} for {}. Waiting for {}s",
+        "No character device found at {} for {}. Waiting for up to {}s",
         charDevPath_,
         name,
-        kPciWaitSecs);
-    sleep(kPciWaitSecs);
+        kPciWaitSecs.count());
   }
-  if (!fs::exists(charDevPath_)) {
+  if (!waitUntil(
+          [&]() { return fs::exists(charDevPath_); },
+          kPciWaitSecs,
+          {fs::path(charDevPath_).parent_path()})) {
     throw std::runtime_error(fmt::format(
         "No character device found at {} for {}. This could either mean the "
         "FPGA does not show up as PCI device (see lspci output), or the kmods "
@@ -566,17 +568,17 @@ bool PciExplorer::checkPciSubDeviceReadiness(
   }
   XLOG(INFO) << fmt::format(
       "PciSubDevice {} with deviceName {} and instId {} is not yet created "
-      "at {}. Waiting for {}s",
+      "at {}. Waiting for up to {}s",
       *fpgaIpBlockConfig.pmUnitScopedName(),
       *fpgaIpBlockConfig.deviceName(),
       instanceId,
       pciDevice.sysfsPath(),
+      kPciWaitSecs.count());
+  return waitUntil(
+      [&]() {
+        return isPciSubDeviceReady(pciDevice, fpgaIpBlockConfig, instanceId);
+      },
       kPciWaitSecs);
-  sleep(kPciWaitSecs);
-  if (isPciSubDeviceReady(pciDevice, fpgaIpBlockConfig, instanceId)) {
-    return true;
-  }
-  return false;
 }
 
 bool PciExplorer::isPciSubDeviceReady(
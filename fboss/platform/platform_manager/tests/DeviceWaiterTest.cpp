@@ -0,0 +1,106 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/testing/TestUtil.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <thread>
+
+#include "fboss/platform/platform_manager/DeviceWaiter.h"
+
+using namespace ::testing;
+using namespace facebook::fboss::platform::platform_manager;
+
+namespace fs = std::filesystem;
+
+namespace {
+// Long enough that a test only passes when woken up by an inotify event.
+constexpr auto kRecheckInterval = std::chrono::seconds(30);
+
+// Fake sysfs tree where a device shows up `delay` after the test starts.
+class DeviceWaiterTest : public Test {
+ public:
+  void SetUp() override {
+    devicesDir_ = fs::path(tmpDir_.path().string()) / "sys/bus/i2c/devices";
+    fs::create_directories(devicesDir_);
+  }
+
+  void TearDown() override {
+    if (creator_.joinable()) {
+      creator_.join();
+    }
+  }
+
+  void createDeviceAfter(
+      const fs::path& devicePath,
+      std::chrono::milliseconds delay) {
+    creator_ = std::thread([devicePath, delay]() {
+      std::this_thread::sleep_for(delay);
+      fs::create_directories(devicePath);
+    });
+  }
+
+  folly::test::TemporaryDirectory tmpDir_;
+  fs::path devicesDir_;
+  std::thread creator_;
+};
+} // namespace
+
+TEST_F(DeviceWaiterTest, AlreadyPresent) {
+  fs::create_directories(devicesDir_ / "4-000f");
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(waitUntil(
+      [&]() { return fs::exists(devicesDir_ / "4-000f"); },
+      std::chrono::seconds(5),
+      {devicesDir_},
+      kRecheckInterval));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_F(DeviceWaiterTest, WakesUpOnCreation) {
+  auto devicePath = devicesDir_ / "4-000f";
+  createDeviceAfter(devicePath, std::chrono::milliseconds(100));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(waitUntil(
+      [&]() { return fs::exists(devicePath); },
+      std::chrono::seconds(5),
+      {devicesDir_},
+      kRecheckInterval));
+  // A fixed sleep would have taken the full 5s.
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
+
+TEST_F(DeviceWaiterTest, WatchesNearestExistingAncestor) {
+  // Neither the device nor its parent directory exist yet.
+  auto devicePath = devicesDir_ / "i2c-4";
+  auto watchDir = devicePath / "4-000f";
+  createDeviceAfter(devicePath, std::chrono::milliseconds(100));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(waitUntil(
+      [&]() { return fs::exists(devicePath); },
+      std::chrono::seconds(5),
+      {watchDir},
+      kRecheckInterval));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
+
+TEST_F(DeviceWaiterTest, RechecksWithoutEvents) {
+  // Nothing is watched (as with sysfs), so only the recheck picks it up.
+  auto devicePath = devicesDir_ / "4-000f";
+  createDeviceAfter(devicePath, std::chrono::milliseconds(100));
+  EXPECT_TRUE(waitUntil(
+      [&]() { return fs::exists(devicePath); },
+      std::chrono::seconds(5),
+      {},
+      std::chrono::milliseconds(10)));
+}
+
+TEST_F(DeviceWaiterTest, TimesOut) {
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(waitUntil(
+      [&]() { return fs::exists(devicesDir_ / "4-000f"); },
+      std::chrono::milliseconds(200),
+      {devicesDir_}));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+  EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
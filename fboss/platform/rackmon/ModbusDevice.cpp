@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "ModbusDevice.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include "Log.h"
@@ -26,6 +27,23 @@ ModbusDevice::ModbusDevice(
   for (auto& it : registerMap.registerDescriptors) {
     info_.registerList.emplace_back(it.second);
   }
+  // Register maps not loaded from JSON come without a read plan.
+  const auto& ranges = registerMap.readRanges.empty()
+      ? planReadRanges(
+            registerMap.registerDescriptors, registerMap.coalesceReads)
+      : registerMap.readRanges;
+  // Ranges are not movable, create them all in place
+  readRanges_ = std::vector<RegisterStoreRange>(ranges.size());
+  size_t first = 0;
+  for (size_t i = 0; i < ranges.size(); i++) {
+    auto& storeRange = readRanges_[i];
+    storeRange.begin = ranges[i].begin;
+    storeRange.length = ranges[i].length;
+    storeRange.first = first;
+    storeRange.count = ranges[i].registers.size();
+    storeRange.coalesce = storeRange.count > 1;
+    first += storeRange.count;
+  }
 
   for (const auto& sp : registerMap.specialHandlers) {
     ModbusSpecialHandler hdl(deviceAddress);
@@ -164,16 +182,23 @@ void ModbusDevice::setBaudrate(uint32_t baud) {
   }
 }
 
-bool ModbusDevice::reloadRegister(
+bool ModbusDevice::reloadDue(
     RegisterStore& registerStore,
+    time_t now,
     bool singleShot) {
   if (!registerStore.isEnabled()) {
     return false;
   }
   const auto& lastReg = registerStore.back();
+  return singleShot || !lastReg ||
+      (time_t)lastReg.timestamp + registerStore.interval() <= now;
+}
+
+bool ModbusDevice::reloadRegister(
+    RegisterStore& registerStore,
+    bool singleShot) {
   time_t reloadTime = getCurrentTime();
-  if (!singleShot && lastReg &&
-      (time_t)lastReg.timestamp + registerStore.interval() > reloadTime) {
+  if (!reloadDue(registerStore, reloadTime, singleShot)) {
     return false;
   }
   uint16_t registerOffset = registerStore.regAddr();
@@ -204,6 +229,47 @@ bool ModbusDevice::reloadRegister(
   return true;
 }
 
+bool ModbusDevice::reloadRange(RegisterStoreRange& range, bool singleShot) {
+  auto stores = info_.registerList.begin() + range.first;
+  time_t reloadTime = getCurrentTime();
+  // Registers of a range share their interval, so if one of them is due
+  // reading the rest along with it costs next to nothing.
+  if (std::none_of(stores, stores + range.count, [&](auto& registerStore) {
+        return reloadDue(registerStore, reloadTime, singleShot);
+      })) {
+    return false;
+  }
+  std::vector<uint16_t> values(range.length);
+  try {
+    readHoldingRegisters(range.begin, values);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRange 0x" << std::hex << range.begin << " len "
+            << std::dec << range.length << " caught: " << e.what()
+            << std::endl;
+    if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
+      // Some register in the range is unsupported, find out which
+      // by reading them individually from now on.
+      range.coalesce = false;
+    }
+    return true;
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRange 0x" << std::hex << range.begin << " len "
+            << std::dec << range.length << " caught: " << e.what()
+            << std::endl;
+    return true;
+  }
+  auto valueIt = values.begin();
+  for (auto it = stores; it != stores + range.count; ++it) {
+    std::vector<uint16_t>& value = it->beginReloadRegister();
+    std::copy_n(valueIt, value.size(), value.begin());
+    valueIt += value.size();
+    it->endReloadRegister(reloadTime);
+  }
+  return true;
+}
+
 void ModbusDevice::reloadRegisters() {
   setPreferredBaudrate();
   // If the number of consecutive failures has exceeded
@@ -217,14 +283,29 @@ void ModbusDevice::reloadRegisters() {
   }
   bool singleShot = singleShotReload_;
   singleShotReload_ = false;
-  for (auto& registerStore : info_.registerList) {
+  for (auto& range : readRanges_) {
     // Break early, if we are entering exclusive mode
     if (exclusiveMode_) {
       break;
     }
-    if (reloadRegister(registerStore, singleShot)) {
-      // Release thread to allow for higher priority tasks to execute.
-      std::this_thread::yield();
+    if (range.coalesce) {
+      if (reloadRange(range, singleShot)) {
+        // Release thread to allow for higher priority tasks to execute.
+        std::this_thread::yield();
+      }
+      if (range.coalesce) {
+        continue;
+      }
+      // The device rejected the coalesced read, fall back to reading
+      // the registers of the range individually right away.
+    }
+    for (size_t i = range.first; i < range.first + range.count; i++) {
+      if (exclusiveMode_) {
+        break;
+      }
+      if (reloadRegister(info_.registerList[i], singleShot)) {
+        std::this_thread::yield();
+      }
     }
   }
 }
@@ -238,6 +319,9 @@ void ModbusDevice::setActive() {
   for (auto& registerStore : info_.registerList) {
     registerStore.enable();
   }
+  for (auto& range : readRanges_) {
+    range.coalesce = range.count > 1;
+  }
   // Clear the num failures so we consider it active.
   info_.numConsecutiveFailures = 0;
   info_.mode = ModbusDeviceMode::ACTIVE;
@@ -1,6 +1,7 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #pragma once
 #include <nlohmann/json.hpp>
+#include <atomic>
 #include <ctime>
 #include <iostream>
 #include <optional>
@@ -106,7 +107,23 @@ class ModbusDevice {
     setBaudrate(info_.preferredBaudrate);
   }
 
+  // Registers of info_.registerList read in a single transaction.
+  struct RegisterStoreRange {
+    uint16_t begin = 0;
+    uint16_t length = 0;
+    // Index of the first register store of the range and count.
+    size_t first = 0;
+    size_t count = 0;
+    // Cleared when the device rejects the coalesced read, in which
+    // case the registers are read (and disabled) one at a time. Set
+    // again by setActive() from other threads.
+    std::atomic<bool> coalesce{false};
+  };
+  std::vector<RegisterStoreRange> readRanges_{};
+
+  bool reloadDue(RegisterStore& registerStore, time_t now, bool singleShot);
   bool reloadRegister(RegisterStore& registerStore, bool singleShot);
+  bool reloadRange(RegisterStoreRange& range, bool singleShot);
 
  protected:
   virtual time_t getCurrentTime() {
@@ -130,6 +147,11 @@ class ModbusDevice {
     return info_.deviceAddress;
   }
 
+  // Interface (bus) the device is attached to.
+  Modbus& getInterface() const {
+    return interface_;
+  }
+
   const std::string& getDeviceType() const {
     return info_.deviceType;
   }
@@ -2,6 +2,7 @@
 #include "Rackmon.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include "Log.h"
 
@@ -85,6 +86,11 @@ bool Rackmon::probe(Modbus& interface, uint8_t addr) {
     interface.command(
         req, resp, rmap.defaultBaudrate, kProbeTimeout, rmap.parity);
     std::unique_lock lock(devicesMutex_);
+    // Buses are scanned concurrently, the first one to find the
+    // address keeps it.
+    if (devices_.find(addr) != devices_.end()) {
+      return true;
+    }
     devices_[addr] = std::make_unique<ModbusDevice>(interface, addr, rmap);
     logInfo << std::hex << std::setw(2) << std::setfill('0') << "Found "
             << int(addr) << " on " << interface.name() << std::endl;
@@ -137,14 +143,32 @@ void Rackmon::recoverDormant() {
   }
 }
 
+void Rackmon::forEachInterface(const std::function<void(Modbus&)>& func) {
+  if (interfaces_.size() == 1) {
+    func(*interfaces_.front());
+    return;
+  }
+  std::vector<std::future<void>> workers;
+  for (auto& iface : interfaces_) {
+    workers.push_back(
+        std::async(std::launch::async, [&func, &iface]() { func(*iface); }));
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+}
+
 void Rackmon::monitor() {
   std::shared_lock lock(devicesMutex_);
-  for (const auto& dev_it : devices_) {
-    if (!dev_it.second->isActive()) {
-      continue;
+  forEachInterface([this](Modbus& iface) {
+    for (const auto& dev_it : devices_) {
+      if (&dev_it.second->getInterface() != &iface ||
+          !dev_it.second->isActive()) {
+        continue;
+      }
+      dev_it.second->reloadRegisters();
     }
-    dev_it.second->reloadRegisters();
-  }
+  });
   lastMonitorTime_ = std::time(nullptr);
 }
 
@@ -171,21 +195,28 @@ ModbusDevice& Rackmon::getModbusDevice(uint8_t addr) {
 
 void Rackmon::fullScan() {
   logInfo << "Starting scan of all devices" << std::endl;
-  bool atLeastOne = false;
-  for (auto& addr : allPossibleDevAddrs_) {
-    if (isDeviceKnown(addr)) {
-      continue;
-    }
-    for (int i = 0; i < kScanNumRetry; i++) {
-      if (reqForceScan_.load() == false) {
-        logWarn << "Full scan aborted" << std::endl;
-        return;
+  std::atomic<bool> atLeastOne{false};
+  std::atomic<bool> aborted{false};
+  forEachInterface([&](Modbus& iface) {
+    for (auto& addr : allPossibleDevAddrs_) {
+      if (isDeviceKnown(addr)) {
+        continue;
       }
-      if (probe(addr)) {
-        atLeastOne = true;
-        break;
+      for (int i = 0; i < kScanNumRetry; i++) {
+        if (reqForceScan_.load() == false) {
+          aborted = true;
+          return;
+        }
+        if (probe(iface, addr)) {
+          atLeastOne = true;
+          break;
+        }
       }
     }
+  });
+  if (aborted) {
+    logWarn << "Full scan aborted" << std::endl;
+    return;
   }
   // When scan is complete, request for a monitor.
   if (atLeastOne) {
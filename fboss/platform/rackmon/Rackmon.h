@@ -1,6 +1,7 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #pragma once
 #include <atomic>
+#include <functional>
 #include <optional>
 #include <set>
 #include <shared_mutex>
@@ -80,6 +81,11 @@ class Rackmon {
 
   bool isDeviceKnown(uint8_t);
 
+  // Run func for every interface and wait for all of them. Interfaces
+  // are independent buses, so with more than one each gets a worker of
+  // its own instead of every bus waiting on the slowest one.
+  void forEachInterface(const std::function<void(Modbus&)>& func);
+
   // Monitor loop. Blocks forever as long as req_stop is true.
   void monitor();
 
@@ -481,6 +481,32 @@ void from_json(const json& j, BaudrateConfig& m) {
   j.at("baud_value_map").get_to(m.baudValueMap);
 }
 
+std::vector<RegisterRange> planReadRanges(
+    const std::map<uint16_t, RegisterDescriptor>& registerDescriptors,
+    bool coalesce) {
+  std::vector<RegisterRange> ranges;
+  for (const auto& [addr, desc] : registerDescriptors) {
+    // Only extend the last range with a register that directly follows
+    // it, since reading across a gap may hit unsupported addresses.
+    if (coalesce && !ranges.empty()) {
+      auto& last = ranges.back();
+      if (last.begin + last.length == addr && last.interval == desc.interval &&
+          last.length + desc.length <= RegisterRange::kMaxLength) {
+        last.length += desc.length;
+        last.registers.push_back(addr);
+        continue;
+      }
+    }
+    RegisterRange range;
+    range.begin = addr;
+    range.length = desc.length;
+    range.interval = desc.interval;
+    range.registers.push_back(addr);
+    ranges.push_back(std::move(range));
+  }
+  return ranges;
+}
+
 void from_json(const json& j, RegisterMap& m) {
   j.at("address_range").get_to(m.applicableAddresses);
   j.at("probe_register").get_to(m.probeRegister);
@@ -499,6 +525,8 @@ void from_json(const json& j, RegisterMap& m) {
   if (j.contains("baud_config")) {
     j.at("baud_config").get_to(m.baudConfig);
   }
+  m.coalesceReads = j.value("coalesce_reads", true);
+  m.readRanges = planReadRanges(m.registerDescriptors, m.coalesceReads);
 }
 void to_json(json& j, const RegisterMap& m) {
   j["address_range"] = m.applicableAddresses;
@@ -314,6 +314,30 @@ struct AddrRange {
   bool contains(uint8_t) const;
 };
 
+// A span of contiguous registers sharing the same monitoring interval.
+// All of them can be read with a single Read Holding Registers
+// transaction instead of one transaction per register.
+struct RegisterRange {
+  // Maximum number of registers a Read Holding Registers response
+  // can carry.
+  static constexpr uint16_t kMaxLength = 125;
+  // Starting address of the range.
+  uint16_t begin = 0;
+  // Total length of the registers in the range.
+  uint16_t length = 0;
+  // Monitoring interval shared by all the registers in the range.
+  time_t interval = RegisterDescriptor::kDefaultInterval;
+  // Starting address of each of the registers in the range.
+  std::vector<uint16_t> registers{};
+};
+
+// Plans the coalesced read ranges covering every register descriptor,
+// in address order. If coalesce is false, every register gets a range
+// of its own.
+std::vector<RegisterRange> planReadRanges(
+    const std::map<uint16_t, RegisterDescriptor>& registerDescriptors,
+    bool coalesce = true);
+
 // Container of an entire register map. This is the memory
 // representation of each JSON register map descriptors
 // at /etc/rackmon.d.
@@ -327,6 +351,10 @@ struct RegisterMap {
   BaudrateConfig baudConfig{};
   std::vector<SpecialHandlerInfo> specialHandlers;
   std::map<uint16_t, RegisterDescriptor> registerDescriptors;
+  // Whether adjacent registers may be read in one transaction.
+  bool coalesceReads = true;
+  // Read ranges planned from registerDescriptors when the map is loaded.
+  std::vector<RegisterRange> readRanges{};
   const RegisterDescriptor& at(uint16_t reg) const {
     return registerDescriptors.at(reg);
   }
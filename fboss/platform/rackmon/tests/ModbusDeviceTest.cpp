@@ -603,6 +603,137 @@ TEST_F(ModbusDeviceTest, MonitorRawData) {
   EXPECT_EQ(data3["ranges"][0]["readings"][1]["data"], "62636465");
 }
 
+// Our register map has two adjacent registers, which are read with a
+// single transaction, and one more after a gap which is read on its own.
+static constexpr auto kCoalescedRegmap = R"({
+    "name": "orv3_psu",
+    "address_range": [[110, 140]],
+    "probe_register": 104,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": [
+      {
+        "begin": 0,
+        "length": 1,
+        "name": "REG_A"
+      },
+      {
+        "begin": 1,
+        "length": 2,
+        "name": "REG_B"
+      },
+      {
+        "begin": 16,
+        "length": 1,
+        "name": "REG_C"
+      }
+    ]
+  })";
+
+TEST_F(ModbusDeviceTest, MonitorCoalescedReads) {
+  RegisterMap regmap = nlohmann::json::parse(kCoalescedRegmap);
+  // Two transactions per monitor cycle instead of three.
+  EXPECT_CALL(
+      get_modbus(),
+      command(
+          // addr(1) = 0x32,
+          // func(1) = 0x03,
+          // reg_off(2) = 0x0000,
+          // reg_cnt(2) = 0x0003
+          encodeMsgContentEqual(0x320300000003_EM),
+          _,
+          19200,
+          ModbusTime::zero(),
+          _))
+      .Times(2)
+      // addr(1) = 0x32,
+      // func(1) = 0x03,
+      // bytes(1) = 0x06,
+      // data(6) = 0001 0002 0003
+      .WillRepeatedly(SetMsgDecode<1>(0x320306000100020003_EM));
+  EXPECT_CALL(
+      get_modbus(),
+      command(
+          encodeMsgContentEqual(0x320300100001_EM),
+          _,
+          19200,
+          ModbusTime::zero(),
+          _))
+      .Times(2)
+      .WillRepeatedly(SetMsgDecode<1>(0x3203020004_EM));
+
+  constexpr time_t monInterval = RegisterDescriptor::kDefaultInterval;
+  time_t baseTime = std::time(nullptr);
+  ModbusDeviceMockTime dev(get_modbus(), 0x32, regmap, baseTime);
+  dev.reloadRegisters();
+  // Nothing is due yet
+  dev.reloadRegisters();
+  dev.incTime(monInterval);
+  dev.reloadRegisters();
+
+  nlohmann::json data = dev.getRawData();
+  ASSERT_TRUE(data["ranges"].is_array() && data["ranges"].size() == 3);
+  EXPECT_EQ(data["ranges"][0]["begin"], 0);
+  EXPECT_EQ(data["ranges"][0]["readings"][0]["data"], "0001");
+  EXPECT_EQ(data["ranges"][1]["begin"], 1);
+  EXPECT_EQ(data["ranges"][1]["readings"][0]["data"], "00020003");
+  EXPECT_EQ(data["ranges"][2]["begin"], 16);
+  EXPECT_EQ(data["ranges"][2]["readings"][0]["data"], "0004");
+  EXPECT_NEAR(
+      data["ranges"][1]["readings"][0]["time"], baseTime + monInterval, 10);
+}
+
+TEST_F(ModbusDeviceTest, MonitorCoalescedReadRejected) {
+  RegisterMap regmap = nlohmann::json::parse(kCoalescedRegmap);
+  Sequence s;
+  // The device does not support REG_B, so it rejects the coalesced
+  // read. Fall back to reading the registers individually, which
+  // disables REG_B.
+  EXPECT_CALL(
+      get_modbus(),
+      command(encodeMsgContentEqual(0x320300000003_EM), _, _, _, _))
+      .Times(1)
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x328302_EM));
+  EXPECT_CALL(
+      get_modbus(),
+      command(encodeMsgContentEqual(0x320300000001_EM), _, _, _, _))
+      .Times(1)
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x3203020001_EM));
+  EXPECT_CALL(
+      get_modbus(),
+      command(encodeMsgContentEqual(0x320300010002_EM), _, _, _, _))
+      .Times(1)
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x328302_EM));
+  EXPECT_CALL(
+      get_modbus(),
+      command(encodeMsgContentEqual(0x320300100001_EM), _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(SetMsgDecode<1>(0x3203020004_EM));
+  // Next cycle only reads the supported registers.
+  EXPECT_CALL(
+      get_modbus(),
+      command(encodeMsgContentEqual(0x320300000001_EM), _, _, _, _))
+      .Times(1)
+      .InSequence(s)
+      .WillOnce(SetMsgDecode<1>(0x3203020005_EM));
+
+  constexpr time_t monInterval = RegisterDescriptor::kDefaultInterval;
+  time_t baseTime = std::time(nullptr);
+  ModbusDeviceMockTime dev(get_modbus(), 0x32, regmap, baseTime, 1);
+  dev.reloadRegisters();
+  dev.incTime(monInterval);
+  dev.reloadRegisters();
+
+  nlohmann::json data = dev.getRawData();
+  ASSERT_TRUE(data["ranges"].is_array() && data["ranges"].size() == 3);
+  EXPECT_EQ(data["ranges"][0]["readings"].size(), 1);
+  EXPECT_EQ(data["ranges"][0]["readings"][0]["data"], "0005");
+  EXPECT_EQ(data["ranges"][1]["readings"].size(), 0);
+}
+
 class MockModbusDevice : public ModbusDevice {
  public:
   MockModbusDevice(Modbus& m, uint8_t addr, const RegisterMap& rmap)
@@ -2,7 +2,9 @@
 #include "Rackmon.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <fstream>
+#include <thread>
 #include "TempDir.h"
 
 using namespace std;
@@ -65,6 +67,37 @@ class FakeModbus : public Modbus {
   }
 };
 
+// Bus with a single device which takes latency to answer each command.
+class SlowModbus : public Modbus {
+  uint8_t exp_addr;
+  std::chrono::milliseconds latency;
+  Encoder encoder{};
+
+ public:
+  SlowModbus(uint8_t e, std::chrono::milliseconds l)
+      : Modbus(), exp_addr(e), latency(l) {}
+  void initialize(const nlohmann::json& /* unused */) override {}
+  bool isPresent() override {
+    return true;
+  }
+  void command(
+      Msg& req,
+      Msg& resp,
+      uint32_t /* unused */,
+      ModbusTime /* unused */,
+      Parity /* unused */) override {
+    encoder.encode(req);
+    if (req.addr != exp_addr) {
+      throw TimeoutException();
+    }
+    std::this_thread::sleep_for(latency);
+    resp = 0x0003020000_M;
+    resp.addr = exp_addr;
+    Encoder::finalize(resp);
+    Encoder::decode(resp);
+  }
+};
+
 class Mock3Modbus : public Modbus {
  public:
   Mock3Modbus(uint8_t e, uint8_t mina, uint8_t maxa, uint32_t b)
@@ -442,3 +475,56 @@ TEST_F(RackmonTest, DormantRecovery) {
   EXPECT_EQ(devs.size(), 1);
   EXPECT_EQ(devs[0].mode, ModbusDeviceMode::ACTIVE);
 }
+
+TEST_F(RackmonTest, MultiBusMonitor) {
+  constexpr auto kLatency = std::chrono::milliseconds(50);
+  json regmapConfig = R"({
+    "name": "orv2_psu",
+    "address_range": [[160, 163]],
+    "probe_register": 104,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": [
+      {
+        "begin": 0,
+        "length": 1,
+        "name": "MFG_ID",
+        "interval": 0
+      }
+    ]
+  })"_json;
+  // Monitor cycle time with one device on each of numBuses buses.
+  auto monitorCycle = [&](int numBuses) {
+    MockRackmon mon;
+    uint8_t nextAddr = 160;
+    EXPECT_CALL(mon, makeInterface())
+        .Times(numBuses)
+        .WillRepeatedly(Invoke([&nextAddr, &kLatency]() {
+          return std::make_unique<SlowModbus>(nextAddr++, kLatency);
+        }));
+    json ifaceConfig = {{"interfaces", json::array()}};
+    for (int i = 0; i < numBuses; i++) {
+      ifaceConfig["interfaces"].push_back(
+          {{"device_path", "/tmp/blah" + std::to_string(i)},
+           {"baudrate", 19200}});
+    }
+    mon.loadInterface(ifaceConfig);
+    mon.loadRegisterMap(regmapConfig);
+    mon.start();
+    mon.scanTick();
+    EXPECT_EQ(mon.listDevices().size(), numBuses);
+    // Let the monitor triggered by the scan drain first.
+    mon.monitorTick();
+    auto start = std::chrono::steady_clock::now();
+    mon.monitorTick();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    mon.stop(false);
+    return elapsed;
+  };
+  auto oneBus = monitorCycle(1);
+  auto fourBuses = monitorCycle(4);
+  EXPECT_GE(oneBus, kLatency);
+  EXPECT_GE(fourBuses, kLatency);
+  // Polled serially, four buses would take at least four times as long.
+  EXPECT_LT(fourBuses, kLatency * 4);
+}
@@ -131,6 +131,47 @@ TEST(RegisterMapTest, JSONCoversionBaudrate) {
   EXPECT_EQ(rmap.baudConfig.baudValueMap[115200], 3);
 }
 
+TEST(RegisterMapTest, PlanReadRanges) {
+  std::string inp = R"({
+    "name": "orv3_psu",
+    "address_range": [[160, 191]],
+    "probe_register": 104,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": [
+      {"begin": 0, "length": 8, "name": "A"},
+      {"begin": 8, "length": 4, "name": "B"},
+      {"begin": 12, "length": 1, "name": "C", "interval": 10},
+      {"begin": 13, "length": 1, "name": "D", "interval": 10},
+      {"begin": 20, "length": 100, "name": "E"},
+      {"begin": 120, "length": 20, "name": "F"},
+      {"begin": 140, "length": 6, "name": "G"}
+    ]
+  })";
+  nlohmann::json j = nlohmann::json::parse(inp);
+  RegisterMap rmap = j;
+  EXPECT_TRUE(rmap.coalesceReads);
+  // Ranges break at interval changes, gaps and the 125 register limit.
+  ASSERT_EQ(rmap.readRanges.size(), 4);
+  EXPECT_EQ(rmap.readRanges[0].begin, 0);
+  EXPECT_EQ(rmap.readRanges[0].length, 12);
+  EXPECT_EQ(rmap.readRanges[0].registers, std::vector<uint16_t>({0, 8}));
+  EXPECT_EQ(rmap.readRanges[1].begin, 12);
+  EXPECT_EQ(rmap.readRanges[1].length, 2);
+  EXPECT_EQ(rmap.readRanges[1].interval, 10);
+  EXPECT_EQ(rmap.readRanges[1].registers, std::vector<uint16_t>({12, 13}));
+  EXPECT_EQ(rmap.readRanges[2].begin, 20);
+  EXPECT_EQ(rmap.readRanges[2].length, 120);
+  EXPECT_EQ(rmap.readRanges[2].registers, std::vector<uint16_t>({20, 120}));
+  EXPECT_EQ(rmap.readRanges[3].begin, 140);
+  EXPECT_EQ(rmap.readRanges[3].length, 6);
+
+  j["coalesce_reads"] = false;
+  RegisterMap rmap2 = j;
+  EXPECT_FALSE(rmap2.coalesceReads);
+  EXPECT_EQ(rmap2.readRanges.size(), 7);
+}
+
 TEST(RegisterMapTest, JSONCoversionSpecial) {
   std::string inp = R"({
     "name": "orv2_psu",
@@ -11,7 +11,11 @@
 #include <filesystem>
 
 #include <fb303/ServiceData.h>
+#include <fb303/ThreadCachedServiceData.h>
 #include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/json/dynamic.h>
 #include <folly/json/json.h>
 #include <folly/logging/xlog.h>
@@ -28,6 +32,18 @@ DEFINE_int32(
     5,
     "Interval at which stats subscriptions are served");
 
+DEFINE_int32(
+    sensor_read_threads,
+    8,
+    "Number of threads reading sensors. Sensors of the same device are read "
+    "by one thread, different devices are read concurrently");
+
+DEFINE_int32(
+    sensor_read_timeout_ms,
+    2000,
+    "Time a sensor poll waits for reads to complete. Sensors of devices "
+    "which did not answer in time keep their last value and are marked stale");
+
 namespace facebook::fboss::platform::sensor_service {
 
 SensorServiceImpl::SensorServiceImpl() {
@@ -46,6 +62,9 @@ SensorServiceImpl::SensorServiceImpl() {
     }
   }
   fsdbSyncer_ = std::make_unique<FsdbSyncer>();
+  sensorReadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+      FLAGS_sensor_read_threads,
+      std::make_shared<folly::NamedThreadFactory>("SensorRead"));
   XLOG(INFO) << "========================================================";
 }
 
@@ -73,9 +92,9 @@ std::map<std::string, SensorData> SensorServiceImpl::getAllSensorData() {
   return polledData_.copy();
 }
 
-void SensorServiceImpl::fetchSensorData() {
-  std::map<std::string, SensorData> polledData;
-  uint readFailures{0};
+std::vector<SensorServiceImpl::SensorReadInfo>
+SensorServiceImpl::getSensorsToRead() {
+  std::vector<SensorReadInfo> sensors;
   // Not all platforms have new sensor thrift structs.
   // If it's defined, we will use new sensor structs
   // Otherwise fall back to the existing sensors structs.
@@ -104,25 +123,171 @@ void SensorServiceImpl::fetchSensorData() {
           *pmUnitSensors.pmUnitName(),
           pmSensors.size());
       for (const auto& sensor : pmSensors) {
-        fetchSensorDataImpl(sensor, readFailures, polledData);
+        sensors.push_back(SensorReadInfo{
+            *sensor.name(),
+            *sensor.sysfsPath(),
+            *sensor.type(),
+            sensor.thresholds().to_optional(),
+            sensor.compute().to_optional()});
       }
     }
   } else {
     XLOG(INFO) << "Fetching using legacy sensor structs...";
     for (const auto& [fruName, sensorMap] : *sensorConfig_.sensorMapList()) {
       for (const auto& [sensorName, sensor] : sensorMap) {
-        fetchSensorDataImpl(
-            std::make_pair(sensorName, sensor), readFailures, polledData);
+        sensors.push_back(SensorReadInfo{
+            sensorName,
+            *sensor.path(),
+            *sensor.type(),
+            sensor.thresholds().to_optional(),
+            sensor.compute().to_optional()});
       }
     }
   }
+  return sensors;
+}
+
+std::map<std::string, SensorData> SensorServiceImpl::readSensors(
+    const std::vector<SensorReadInfo>& sensors,
+    std::set<std::string>& staleSensors) {
+  std::map<std::string, std::vector<SensorReadInfo>> sensorsByDevice;
+  for (const auto& sensor : sensors) {
+    auto latencyKey = fmt::format(kReadLatency, sensor.name);
+    if (latencyHistograms_.insert(latencyKey).second) {
+      // histogram range [0, 1s], 10ms width
+      fb303::ThreadCachedServiceData::get()->addHistogram(
+          latencyKey, 10000, 0, 1000000);
+      fb303::ThreadCachedServiceData::get()->exportHistogram(
+          latencyKey, 50, 95, 99);
+    }
+    sensorsByDevice[std::filesystem::path(sensor.sysfsPath)
+                        .parent_path()
+                        .string()]
+        .push_back(sensor);
+  }
+
+  std::vector<folly::Future<std::vector<SensorData>>> reads;
+  for (auto& [device, deviceSensors] : sensorsByDevice) {
+    if (!busyDevices_.wlock()->insert(device).second) {
+      reads.push_back(folly::makeFuture<std::vector<SensorData>>(
+          std::runtime_error("previous read is still in progress")));
+      continue;
+    }
+    reads.push_back(folly::via(
+        sensorReadExecutor_.get(),
+        [this, device = device, deviceSensors = deviceSensors]() {
+          SCOPE_EXIT {
+            busyDevices_.wlock()->erase(device);
+          };
+          std::vector<SensorData> deviceData;
+          for (const auto& sensor : deviceSensors) {
+            try {
+              deviceData.push_back(createSensorData(
+                  sensor, fmt::format(kReadLatency, sensor.name)));
+            } catch (const std::exception& ex) {
+              // Report the sensor without a value, as for a failed read
+              XLOG(ERR) << fmt::format(
+                  "Failed to read {} from path:{}, error:{}",
+                  sensor.name,
+                  sensor.sysfsPath,
+                  ex.what());
+              SensorData sensorData{};
+              sensorData.name() = sensor.name;
+              sensorData.thresholds() =
+                  sensor.thresholds ? *sensor.thresholds : Thresholds();
+              sensorData.sensorType() = sensor.sensorType;
+              deviceData.push_back(std::move(sensorData));
+            }
+          }
+          return deviceData;
+        }));
+  }
+
+  std::map<std::string, SensorData> polledData;
+  const auto deadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(FLAGS_sensor_read_timeout_ms);
+  auto read = reads.begin();
+  for (const auto& [device, deviceSensors] : sensorsByDevice) {
+    read->wait(std::chrono::duration_cast<folly::HighResDuration>(
+        std::max(
+            deadline - std::chrono::steady_clock::now(),
+            std::chrono::steady_clock::duration::zero())));
+    if (read->isReady() && read->hasValue()) {
+      for (auto& sensorData : read->value()) {
+        polledData[*sensorData.name()] = std::move(sensorData);
+      }
+    } else {
+      if (read->isReady()) {
+        XLOG(ERR) << fmt::format(
+            "Skipping {} sensors of {}: {}",
+            deviceSensors.size(),
+            device,
+            read->result().exception().what().toStdString());
+      } else {
+        XLOG(ERR) << fmt::format(
+            "Timed out reading {} sensors of {} within {}ms",
+            deviceSensors.size(),
+            device,
+            FLAGS_sensor_read_timeout_ms);
+      }
+      for (const auto& sensor : deviceSensors) {
+        staleSensors.insert(sensor.name);
+      }
+    }
+    ++read;
+  }
+  return polledData;
+}
+
+void SensorServiceImpl::fetchSensorData() {
+  auto sensors = getSensorsToRead();
+  std::set<std::string> staleSensors;
+  auto polledData = readSensors(sensors, staleSensors);
+  uint readFailures{0};
+  auto lastPolledData = polledData_.copy();
+  for (const auto& sensor : sensors) {
+    if (staleSensors.count(sensor.name)) {
+      // Keep reporting the last value along with its timestamp, so that
+      // consumers can tell how old it is.
+      auto it = lastPolledData.find(sensor.name);
+      if (it != lastPolledData.end()) {
+        polledData[sensor.name] = it->second;
+      } else {
+        SensorData sensorData{};
+        sensorData.name() = sensor.name;
+        sensorData.thresholds() =
+            sensor.thresholds ? *sensor.thresholds : Thresholds();
+        sensorData.sensorType() = sensor.sensorType;
+        polledData[sensor.name] = sensorData;
+      }
+    }
+    const auto& sensorData = polledData[sensor.name];
+    bool stale = staleSensors.count(sensor.name) > 0;
+    // We log 0 if there is a read failure.  If we dont log 0 on failure,
+    // fb303 will pick up the last reported (on read success) value and
+    // keep reporting that as the value. For 0 values, it is accurate to
+    // read the value along with the kReadFailure counter. Alternative is
+    // to delete this counter if there is a failure.
+    fb303::fbData->setCounter(
+        fmt::format(kReadValue, sensor.name),
+        stale ? 0 : sensorData.value().value_or(0));
+    fb303::fbData->setCounter(fmt::format(kReadStale, sensor.name), stale);
+    if (stale || !sensorData.value()) {
+      fb303::fbData->setCounter(fmt::format(kReadFailure, sensor.name), 1);
+      readFailures++;
+    } else {
+      fb303::fbData->setCounter(fmt::format(kReadFailure, sensor.name), 0);
+    }
+  }
   fb303::fbData->setCounter(kReadTotal, polledData.size());
   fb303::fbData->setCounter(kTotalReadFailure, readFailures);
   fb303::fbData->setCounter(kHasReadFailure, readFailures > 0 ? 1 : 0);
+  fb303::fbData->setCounter(kTotalReadStale, staleSensors.size());
   XLOG(INFO) << fmt::format(
-      "In Total, Processed {} Sensors. {} Failures.",
+      "In Total, Processed {} Sensors. {} Failures. {} Stale.",
       polledData.size(),
-      readFailures);
+      readFailures,
+      staleSensors.size());
   polledData_.swap(polledData);
 
   if (FLAGS_publish_stats_to_fsdb) {
@@ -139,44 +304,22 @@ void SensorServiceImpl::fetchSensorData() {
   }
 }
 
-template <typename T, typename>
-void SensorServiceImpl::fetchSensorDataImpl(
-    const T& sensor,
-    uint& readFailures,
-    std::map<std::string, SensorData>& polledData) {
-  SensorData sensorData;
-  std::string sensorName;
-  if constexpr (std::is_same_v<T, std::pair<std::string, Sensor>>) {
-    sensorName = sensor.first;
-    sensorData = createSensorData(
-        sensorName,
-        *sensor.second.path(),
-        *sensor.second.type(),
-        sensor.second.thresholds().to_optional(),
-        sensor.second.compute().to_optional());
-  } else {
-    sensorName = *sensor.name();
-    sensorData = createSensorData(
-        sensorName,
-        *sensor.sysfsPath(),
-        *sensor.type(),
-        sensor.thresholds().to_optional(),
-        sensor.compute().to_optional());
-  }
-  polledData[sensorName] = sensorData;
-  // We log 0 if there is a read failure.  If we dont log 0 on failure,
-  // fb303 will pick up the last reported (on read success) value and
-  // keep reporting that as the value. For 0 values, it is accurate to
-  // read the value along with the kReadFailure counter. Alternative is
-  // to delete this counter if there is a failure.
-  fb303::fbData->setCounter(
-      fmt::format(kReadValue, sensorName), sensorData.value().value_or(0));
-  if (!sensorData.value()) {
-    fb303::fbData->setCounter(fmt::format(kReadFailure, sensorName), 1);
-    readFailures++;
-  } else {
-    fb303::fbData->setCounter(fmt::format(kReadFailure, sensorName), 0);
-  }
+SensorData SensorServiceImpl::createSensorData(
+    const SensorReadInfo& sensor,
+    const std::string& latencyKey) {
+  auto start = std::chrono::steady_clock::now();
+  auto sensorData = createSensorData(
+      sensor.name,
+      sensor.sysfsPath,
+      sensor.sensorType,
+      sensor.thresholds,
+      sensor.compute);
+  fb303::ThreadCachedServiceData::get()->addHistogramValue(
+      latencyKey,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  return sensorData;
 }
 
 SensorData SensorServiceImpl::createSensorData(
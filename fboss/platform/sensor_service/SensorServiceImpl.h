@@ -10,11 +10,12 @@
 
 #pragma once
 
+#include <set>
 #include <string>
-#include <type_traits>
 #include <vector>
 
 #include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "fboss/platform/sensor_service/FsdbSyncer.h"
 #include "fboss/platform/sensor_service/PmUnitInfoFetcher.h"
@@ -22,6 +23,8 @@
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
 
 DECLARE_int32(fsdb_statsStream_interval_seconds);
+DECLARE_int32(sensor_read_threads);
+DECLARE_int32(sensor_read_timeout_ms);
 
 namespace facebook::fboss::platform::sensor_service {
 using namespace facebook::fboss::platform::sensor_config;
@@ -33,6 +36,9 @@ class SensorServiceImpl {
   auto static constexpr kReadTotal = "sensor_read.total";
   auto static constexpr kTotalReadFailure = "sensor_read.total.failures";
   auto static constexpr kHasReadFailure = "sensor_read.has.failures";
+  auto static constexpr kReadStale = "sensor_read.{}.stale";
+  auto static constexpr kReadLatency = "sensor_read.{}.latency.us";
+  auto static constexpr kTotalReadStale = "sensor_read.total.stale";
 
   explicit SensorServiceImpl();
   ~SensorServiceImpl();
@@ -47,17 +53,26 @@ class SensorServiceImpl {
   }
 
  private:
-  // Interim function while migrating to PmSensor.
-  // This will be removed once migration is done for all platforms.
-  template <
-      typename T,
-      typename = std::enable_if_t<
-          std::is_same_v<T, std::pair<std::string, Sensor>> ||
-          std::is_same_v<T, PmSensor>>>
-  void fetchSensorDataImpl(
-      const T& sensor,
-      uint& readFailures,
-      std::map<std::string, SensorData>& polledData);
+  // A sensor to read, from either the PmSensor or the legacy Sensor config.
+  struct SensorReadInfo {
+    std::string name;
+    std::string sysfsPath;
+    SensorType sensorType;
+    std::optional<Thresholds> thresholds;
+    std::optional<std::string> compute;
+  };
+
+  std::vector<SensorReadInfo> getSensorsToRead();
+  // Reads sensors grouped by the device (sysfs directory) they belong to.
+  // Devices are read concurrently, each one serially, and the poll waits
+  // for at most FLAGS_sensor_read_timeout_ms. Sensors of a device which did
+  // not answer in time are returned by name in staleSensors.
+  std::map<std::string, SensorData> readSensors(
+      const std::vector<SensorReadInfo>& sensors,
+      std::set<std::string>& staleSensors);
+  SensorData createSensorData(
+      const SensorReadInfo& sensor,
+      const std::string& latencyKey);
   SensorData createSensorData(
       const std::string& name,
       const std::string& sysfsPath,
@@ -71,6 +86,14 @@ class SensorServiceImpl {
       publishedStatsToFsdbAt_;
   SensorConfig sensorConfig_{};
   PmUnitInfoFetcher pmUnitInfoFetcher_{};
+  // Latency histograms exported so far, keyed by counter name.
+  std::set<std::string> latencyHistograms_{};
+  // Devices with a read still in flight, e.g. hung on a slow I2C device.
+  // They are skipped until that read returns.
+  folly::Synchronized<std::set<std::string>> busyDevices_{};
+  // Declared last so that in-flight reads are joined before the members
+  // they use are destroyed.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> sensorReadExecutor_;
 };
 
 } // namespace facebook::fboss::platform::sensor_service
@@ -1,7 +1,10 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
+#include <sys/stat.h>
 #include <filesystem>
+#include <thread>
 
+#include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
 #include <folly/testing/TestUtil.h>
 #include <gtest/gtest.h>
@@ -110,4 +113,122 @@ TEST_F(SensorServiceImplTest, getSomeSensors) {
   EXPECT_GE(*sensorData[0].timeStamp(), now);
 }
 
+TEST_F(SensorServiceImplTest, slowDeviceDoesNotBlockPoll) {
+  gflags::FlagSaver flagSaver;
+  folly::test::TemporaryDirectory tmpDir = folly::test::TemporaryDirectory();
+  auto tmpPath = std::filesystem::path(tmpDir.path().string());
+  // Fake sysfs tree with two devices, one of which will stop responding.
+  auto fastDevice = tmpPath / "hwmon1";
+  auto slowDevice = tmpPath / "hwmon2";
+  std::filesystem::create_directories(fastDevice);
+  std::filesystem::create_directories(slowDevice);
+  auto fastSensorPath = (fastDevice / "temp1_input").string();
+  auto slowSensorPath = (slowDevice / "temp1_input").string();
+  ASSERT_TRUE(folly::writeFile(std::string("25"), fastSensorPath.c_str()));
+  ASSERT_TRUE(folly::writeFile(std::string("50"), slowSensorPath.c_str()));
+
+  SensorConfig config;
+  Sensor fastSensor, slowSensor;
+  fastSensor.path() = fastSensorPath;
+  fastSensor.type() = SensorType::TEMPERTURE;
+  slowSensor.path() = slowSensorPath;
+  slowSensor.type() = SensorType::TEMPERTURE;
+  config.sensorMapList() = {
+      {"MOCK_FRU", {{"FAST_SENSOR", fastSensor}, {"SLOW_SENSOR", slowSensor}}}};
+  auto confFileName = (tmpPath / "sensor_config").string();
+  ASSERT_TRUE(folly::writeFile(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(config),
+      confFileName.c_str()));
+  FLAGS_config_file = confFileName;
+  FLAGS_sensor_read_timeout_ms = 200;
+  auto sensorServiceImpl = std::make_shared<SensorServiceImpl>();
+
+  sensorServiceImpl->fetchSensorData();
+  auto sensorData = sensorServiceImpl->getAllSensorData();
+  EXPECT_EQ(*sensorData["SLOW_SENSOR"].value(), 50);
+  auto slowSensorTimeStamp = *sensorData["SLOW_SENSOR"].timeStamp();
+
+  // A FIFO without writer blocks its reader, like a hung hwmon read.
+  ASSERT_TRUE(std::filesystem::remove(slowSensorPath));
+  ASSERT_EQ(mkfifo(slowSensorPath.c_str(), 0644), 0);
+  ASSERT_TRUE(folly::writeFile(std::string("30"), fastSensorPath.c_str()));
+  auto start = std::chrono::steady_clock::now();
+  sensorServiceImpl->fetchSensorData();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+  sensorData = sensorServiceImpl->getAllSensorData();
+  EXPECT_EQ(*sensorData["FAST_SENSOR"].value(), 30);
+  // The slow sensor keeps its last value and timestamp, and is marked stale.
+  EXPECT_EQ(*sensorData["SLOW_SENSOR"].value(), 50);
+  EXPECT_EQ(*sensorData["SLOW_SENSOR"].timeStamp(), slowSensorTimeStamp);
+  EXPECT_EQ(
+      fb303::fbData->getCounter(
+          fmt::format(SensorServiceImpl::kReadStale, "SLOW_SENSOR")),
+      1);
+  EXPECT_EQ(
+      fb303::fbData->getCounter(
+          fmt::format(SensorServiceImpl::kReadStale, "FAST_SENSOR")),
+      0);
+  EXPECT_EQ(fb303::fbData->getCounter(SensorServiceImpl::kTotalReadStale), 1);
+
+  // While the hung read is in flight, the device is not read again.
+  sensorServiceImpl->fetchSensorData();
+  EXPECT_EQ(fb303::fbData->getCounter(SensorServiceImpl::kTotalReadStale), 1);
+
+  // Unblock the hung read, after which the device recovers.
+  ASSERT_TRUE(folly::writeFile(std::string("60"), slowSensorPath.c_str()));
+  ASSERT_TRUE(std::filesystem::remove(slowSensorPath));
+  ASSERT_TRUE(folly::writeFile(std::string("70"), slowSensorPath.c_str()));
+  for (int i = 0; i < 50; i++) {
+    sensorServiceImpl->fetchSensorData();
+    if (fb303::fbData->getCounter(SensorServiceImpl::kTotalReadStale) == 0) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  sensorData = sensorServiceImpl->getAllSensorData();
+  EXPECT_EQ(*sensorData["SLOW_SENSOR"].value(), 70);
+  EXPECT_EQ(
+      fb303::fbData->getCounter(
+          fmt::format(SensorServiceImpl::kReadStale, "SLOW_SENSOR")),
+      0);
+}
+
+TEST_F(SensorServiceImplTest, badSensorDoesNotFailItsDevice) {
+  gflags::FlagSaver flagSaver;
+  folly::test::TemporaryDirectory tmpDir = folly::test::TemporaryDirectory();
+  auto device = std::filesystem::path(tmpDir.path().string()) / "hwmon1";
+  std::filesystem::create_directories(device);
+  auto goodSensorPath = (device / "temp1_input").string();
+  auto badSensorPath = (device / "temp2_input").string();
+  ASSERT_TRUE(folly::writeFile(std::string("25"), goodSensorPath.c_str()));
+  // Not a number, fails to parse
+  ASSERT_TRUE(folly::writeFile(std::string("N/A"), badSensorPath.c_str()));
+
+  SensorConfig config;
+  Sensor goodSensor, badSensor;
+  goodSensor.path() = goodSensorPath;
+  goodSensor.type() = SensorType::TEMPERTURE;
+  badSensor.path() = badSensorPath;
+  badSensor.type() = SensorType::TEMPERTURE;
+  config.sensorMapList() = {
+      {"MOCK_FRU", {{"GOOD_SENSOR", goodSensor}, {"BAD_SENSOR", badSensor}}}};
+  auto confFileName = (device.parent_path() / "sensor_config").string();
+  ASSERT_TRUE(folly::writeFile(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(config),
+      confFileName.c_str()));
+  FLAGS_config_file = confFileName;
+  auto sensorServiceImpl = std::make_shared<SensorServiceImpl>();
+
+  sensorServiceImpl->fetchSensorData();
+  auto sensorData = sensorServiceImpl->getAllSensorData();
+  EXPECT_EQ(*sensorData["GOOD_SENSOR"].value(), 25);
+  EXPECT_FALSE(sensorData["BAD_SENSOR"].value().has_value());
+  // A failed read is not a stale one, and the device is not left busy
+  EXPECT_EQ(fb303::fbData->getCounter(SensorServiceImpl::kTotalReadStale), 0);
+  ASSERT_TRUE(folly::writeFile(std::string("30"), badSensorPath.c_str()));
+  sensorServiceImpl->fetchSensorData();
+  sensorData = sensorServiceImpl->getAllSensorData();
+  EXPECT_EQ(*sensorData["BAD_SENSOR"].value(), 30);
+}
+
 } // namespace facebook::fboss
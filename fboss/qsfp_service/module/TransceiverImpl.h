@@ -11,8 +11,10 @@
 
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include <folly/String.h>
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 
 #include "fboss/agent/FbossError.h"
@@ -41,6 +43,25 @@ class TransceiverImpl {
       const TransceiverAccessParameter& param,
       uint8_t* fieldValue) = 0;
 
+  /*
+   * Read several ranges, along with the page select writes they need, in
+   * order. Implementations that queue their I2C transactions may return
+   * before the transactions have run and merge adjacent reads, so the
+   * buffers must stay valid until the returned future completes.
+   */
+  virtual folly::SemiFuture<folly::Unit> readTransceiverBatch(
+      const std::vector<TransceiverAccess>& accesses) {
+    return folly::makeSemiFutureWith([&]() {
+      for (const auto& access : accesses) {
+        if (access.isWrite) {
+          writeTransceiver(access.param, access.buf);
+        } else {
+          readTransceiver(access.param, access.buf);
+        }
+      }
+    });
+  }
+
   /*
    * Write to a tranceiver with a specific delay post write.
    * Implementer should add the specified delay (e.g. usleep) after
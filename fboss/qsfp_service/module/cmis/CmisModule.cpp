@@ -4,6 +4,7 @@
 
 #include <boost/assign.hpp>
 #include <boost/bimap.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <string>
@@ -600,6 +601,52 @@ void CmisModule::readCmisField(
       data);
 }
 
+void CmisModule::readCmisFields(
+    const std::vector<std::pair<CmisField, uint8_t*>>& fields) {
+  std::vector<TransceiverAccess> accesses;
+  accesses.reserve(2 * fields.size());
+  // Backs the page select writes until the batch is done
+  std::vector<uint8_t> pageVals;
+  pageVals.reserve(fields.size());
+  std::optional<int> page;
+  // Start of the reads of the current page
+  size_t pageBegin = 0;
+  for (const auto& [field, data] : fields) {
+    int dataLength, dataPage, dataOffset;
+    getQsfpFieldAddress(field, dataPage, dataOffset, dataLength);
+    if (page != dataPage) {
+      page = dataPage;
+      if (static_cast<CmisPages>(dataPage) != CmisPages::LOWER && !flatMem_) {
+        pageVals.push_back(static_cast<uint8_t>(dataPage));
+        accesses.push_back(
+            {{TransceiverAccessParameter::ADDR_QSFP,
+              127,
+              sizeof(uint8_t),
+              static_cast<int>(CmisPages::LOWER)},
+             &pageVals.back(),
+             /*isWrite*/ true});
+      }
+      pageBegin = accesses.size();
+    }
+    accesses.push_back(
+        {{TransceiverAccessParameter::ADDR_QSFP,
+          dataOffset,
+          dataLength,
+          dataPage},
+         data});
+    // Keep the reads of a page in address order so adjacent fields can be
+    // merged
+    std::stable_sort(
+        accesses.begin() + pageBegin,
+        accesses.end(),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.param.offset < rhs.param.offset;
+        });
+  }
+  // Everything is queued before waiting, so the transactions run as one batch
+  qsfpImpl_->readTransceiverBatch(accesses).get();
+}
+
 void CmisModule::writeCmisField(
     CmisField field,
     uint8_t* data,
@@ -2118,11 +2165,14 @@ void CmisModule::updateQsfpData(bool allPages) {
     dirty_ = false;
     setQsfpFlatMem();
 
-    readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    std::vector<std::pair<CmisField, uint8_t*>> pages = {
+        {CmisField::PAGE_UPPER00H, page0_}};
+    if (!flatMem_) {
+      pages.emplace_back(CmisField::PAGE_UPPER10H, page10_);
+      pages.emplace_back(CmisField::PAGE_UPPER11H, page11_);
+    }
+    readCmisFields(pages);
     if (!flatMem_) {
-      readCmisField(CmisField::PAGE_UPPER10H, page10_);
-      readCmisField(CmisField::PAGE_UPPER11H, page11_);
-
       bool isReady =
           ((CmisModuleState)(getSettingsValue(CmisField::MODULE_STATE) >> 1) ==
            CmisModuleState::READY);
@@ -2149,9 +2199,10 @@ void CmisModule::updateQsfpData(bool allPages) {
     }
 
     if (!flatMem_) {
-      readCmisField(CmisField::PAGE_UPPER01H, page01_);
-      readCmisField(CmisField::PAGE_UPPER02H, page02_);
-      readCmisField(CmisField::PAGE_UPPER13H, page13_);
+      readCmisFields(
+          {{CmisField::PAGE_UPPER01H, page01_},
+           {CmisField::PAGE_UPPER02H, page02_},
+           {CmisField::PAGE_UPPER13H, page13_}});
     }
 
     // Update the application capabilities once we have read from eeprom
@@ -2194,11 +2245,14 @@ void CmisModule::setApplicationSelectCode(
   // cache because we may not have got a chance to update in between
   // programming different ports in a sequence
   std::array<uint8_t, 8> laneToActiveCtrlFieldVals;
+  std::vector<std::pair<CmisField, uint8_t*>> activeCtrlFields;
   for (auto it = laneToActiveCtrlField.begin();
        it != laneToActiveCtrlField.end();
        it++) {
-    readCmisField(it->second, &laneToActiveCtrlFieldVals[it->first]);
+    activeCtrlFields.emplace_back(
+        it->second, &laneToActiveCtrlFieldVals[it->first]);
   }
+  readCmisFields(activeCtrlFields);
   for (uint8_t lane = startHostLane; lane < startHostLane + numHostLanes;
        lane++) {
     lanesToConfigure.insert(lane);
@@ -3870,17 +3924,23 @@ void CmisModule::updateVdmCacheLocked() {
     QSFP_LOG(DBG5, this) << "Doesn't support VDM, skip updating VDM cache";
     return;
   }
-  readCmisField(CmisField::PAGE_UPPER20H, page20_);
-  readCmisField(CmisField::PAGE_UPPER21H, page21_);
-  readCmisField(CmisField::PAGE_UPPER24H, page24_);
-  readCmisField(CmisField::PAGE_UPPER25H, page25_);
+  std::vector<std::pair<CmisField, uint8_t*>> pages = {
+      {CmisField::PAGE_UPPER20H, page20_},
+      {CmisField::PAGE_UPPER21H, page21_},
+      {CmisField::PAGE_UPPER24H, page24_},
+      {CmisField::PAGE_UPPER25H, page25_}};
+  bool cacheStaticPages = false;
   if (isVdmSupported(3)) {
     // Cache VDM group 3 page only if it is supported
     if (!staticPagesCached_) {
-      readCmisField(CmisField::PAGE_UPPER22H, page22_);
-      staticPagesCached_ = true;
+      pages.emplace_back(CmisField::PAGE_UPPER22H, page22_);
+      cacheStaticPages = true;
     }
-    readCmisField(CmisField::PAGE_UPPER26H, page26_);
+    pages.emplace_back(CmisField::PAGE_UPPER26H, page26_);
+  }
+  readCmisFields(pages);
+  if (cacheStaticPages) {
+    staticPagesCached_ = true;
   }
 }
 
@@ -468,6 +468,12 @@ class CmisModule : public QsfpModule {
   readCmisField(CmisField field, uint8_t* data, bool skipPageChange = false);
   void
   writeCmisField(CmisField field, uint8_t* data, bool skipPageChange = false);
+  /* Read several fields, changing the page only when the next field is on
+   * another one. The page changes and reads are handed to the transceiver as
+   * one batch, so that they are queued together and adjacent fields of a
+   * page can be fetched with a single I2C transaction. */
+  void readCmisFields(
+      const std::vector<std::pair<CmisField, uint8_t*>>& fields);
 
   void getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue) const;
   /*
@@ -42,6 +42,12 @@ DEFINE_bool(
     false,
     "Enable transceiver I2C logging feature in qsfp_service");
 
+DEFINE_bool(
+    i2c_transaction_scheduler,
+    false,
+    "Queue transceiver I2C transactions per bus so that reads can be merged "
+    "and independent buses are accessed concurrently");
+
 namespace facebook {
 namespace fboss {
 
@@ -162,6 +168,11 @@ void WedgeManager::initQsfpImplMap() {
   } else {
     XLOG(INFO) << "Did not create tcvr i2c log buffers";
   }
+  if (FLAGS_i2c_transaction_scheduler) {
+    XLOG(INFO) << "Scheduling transceiver I2C transactions per bus";
+    i2cScheduler_ =
+        std::make_unique<I2cTransactionScheduler>(wedgeI2cBus_.get());
+  }
   // Create WedgeQsfp for each QSFP module present in the system
   for (int idx = 0; idx < getNumQsfpModules(); idx++) {
     std::unique_ptr<I2cLogBuffer> logBuffer;
@@ -171,7 +182,11 @@ void WedgeManager::initQsfpImplMap() {
       logBuffer = std::make_unique<I2cLogBuffer>(logConfig, fileName);
     }
     qsfpImpls_.push_back(std::make_unique<WedgeQsfp>(
-        idx, wedgeI2cBus_.get(), this, std::move(logBuffer)));
+        idx,
+        wedgeI2cBus_.get(),
+        this,
+        std::move(logBuffer),
+        i2cScheduler_.get()));
   }
 }
 
@@ -190,6 +190,9 @@ class WedgeManager : public TransceiverManager {
 
   // thread safe handle to access bus
   std::unique_ptr<TransceiverI2CApi> wedgeI2cBus_;
+  // Queues and batches the transceiver I2C transactions of every bus, only
+  // created when --i2c_transaction_scheduler is set
+  std::unique_ptr<I2cTransactionScheduler> i2cScheduler_;
 
   PlatformType platformType_;
 
@@ -68,9 +68,11 @@ WedgeQsfp::WedgeQsfp(
     int module,
     TransceiverI2CApi* wedgeI2CBus,
     TransceiverManager* const tcvrManager,
-    std::unique_ptr<I2cLogBuffer> logBuffer)
+    std::unique_ptr<I2cLogBuffer> logBuffer,
+    I2cTransactionScheduler* i2cScheduler)
     : module_(module),
       threadSafeI2CBus_(wedgeI2CBus),
+      i2cScheduler_(i2cScheduler),
       tcvrManager_(tcvrManager),
       logBuffer_(std::move(logBuffer)) {
   moduleName_ = folly::to<std::string>(module);
@@ -96,7 +98,11 @@ int WedgeQsfp::readTransceiver(
       ioStatsRecorder_.recordReadSuccess();
     };
     generateIOErrorForTest("readTransceiver()");
-    threadSafeI2CBus_->moduleRead(module_ + 1, param, fieldValue);
+    if (i2cScheduler_) {
+      i2cScheduler_->read(module_ + 1, param, fieldValue).get();
+    } else {
+      threadSafeI2CBus_->moduleRead(module_ + 1, param, fieldValue);
+    }
     if (logBuffer_) {
       logBuffer_->log(param, fieldValue, I2cLogBuffer::Operation::Read);
     }
@@ -112,6 +118,44 @@ int WedgeQsfp::readTransceiver(
   return len;
 }
 
+folly::SemiFuture<folly::Unit> WedgeQsfp::readTransceiverBatch(
+    const std::vector<TransceiverAccess>& accesses) {
+  if (!i2cScheduler_) {
+    return TransceiverImpl::readTransceiverBatch(accesses);
+  }
+  ioStatsRecorder_.recordReadAttempted();
+  auto submitted = folly::makeSemiFutureWith([&]() {
+    generateIOErrorForTest("readTransceiverBatch()");
+    return i2cScheduler_->submitBatch(module_ + 1, accesses);
+  });
+  // Leave the wait to the caller, so that the whole batch is queued on the
+  // bus before anyone blocks on it
+  return std::move(submitted).defer(
+      [this, accesses](folly::Try<folly::Unit>&& result) {
+        ioStatsRecorder_.updateReadDownTime();
+        if (result.hasValue()) {
+          ioStatsRecorder_.recordReadSuccess();
+        } else {
+          ioStatsRecorder_.recordReadFailed();
+          StatsPublisher::bumpReadFailure();
+          XLOG(ERR) << "Batched access of " << accesses.size()
+                    << " ranges of transceiver " << module_
+                    << " failed: " << result.exception().what();
+        }
+        if (logBuffer_) {
+          for (const auto& access : accesses) {
+            logBuffer_->log(
+                access.param,
+                access.buf,
+                access.isWrite ? I2cLogBuffer::Operation::Write
+                               : I2cLogBuffer::Operation::Read,
+                /*success*/ result.hasValue());
+          }
+        }
+        result.throwUnlessValue();
+      });
+}
+
 int WedgeQsfp::writeTransceiver(
     const TransceiverAccessParameter& param,
     const uint8_t* fieldValue,
@@ -131,7 +175,11 @@ int WedgeQsfp::writeTransceiver(
       ioStatsRecorder_.recordWriteSuccess();
     };
     generateIOErrorForTest("writeTransceiver()");
-    threadSafeI2CBus_->moduleWrite(module_ + 1, param, fieldValue);
+    if (i2cScheduler_) {
+      i2cScheduler_->write(module_ + 1, param, fieldValue).get();
+    } else {
+      threadSafeI2CBus_->moduleWrite(module_ + 1, param, fieldValue);
+    }
     if (logBuffer_) {
       logBuffer_->log(param, fieldValue, I2cLogBuffer::Operation::Write);
     }
@@ -18,6 +18,7 @@
 #include <folly/io/async/EventBase.h>
 
 #include "fboss/lib/IOStatsRecorder.h"
+#include "fboss/lib/i2c/I2cTransactionScheduler.h"
 #include "fboss/qsfp_service/TransceiverManager.h"
 #include "fboss/qsfp_service/module/I2cLogBuffer.h"
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
@@ -36,7 +37,8 @@ class WedgeQsfp : public TransceiverImpl {
       int module,
       TransceiverI2CApi* i2c,
       TransceiverManager* const tcvrManager,
-      std::unique_ptr<I2cLogBuffer> logBuffer);
+      std::unique_ptr<I2cLogBuffer> logBuffer,
+      I2cTransactionScheduler* i2cScheduler = nullptr);
 
   ~WedgeQsfp() override;
 
@@ -45,6 +47,9 @@ class WedgeQsfp : public TransceiverImpl {
       const TransceiverAccessParameter& param,
       uint8_t* fieldValue) override;
 
+  folly::SemiFuture<folly::Unit> readTransceiverBatch(
+      const std::vector<TransceiverAccess>& accesses) override;
+
   /* write to the eeprom (usually to change the page setting) */
   int writeTransceiver(
       const TransceiverAccessParameter& param,
@@ -115,6 +120,8 @@ class WedgeQsfp : public TransceiverImpl {
   int module_;
   std::string moduleName_;
   TransceiverI2CApi* threadSafeI2CBus_;
+  // When set, all I2C transactions of this module go through the scheduler
+  I2cTransactionScheduler* i2cScheduler_;
   TransceiverManager* const tcvrManager_;
   IOStatsRecorder ioStatsRecorder_;
   std::unique_ptr<I2cLogBuffer> logBuffer_;
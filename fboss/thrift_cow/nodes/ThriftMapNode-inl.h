@@ -22,6 +22,10 @@
 
 #include "fboss/agent/state/MapDelta.h"
 
+#include <algorithm>
+#include <atomic>
+#include <set>
+
 namespace facebook::fboss::thrift_cow {
 
 namespace map_helpers {
@@ -38,6 +42,12 @@ struct ExtractTypeClass<
   using value_type = ValueTypeClass;
 };
 
+// Unique id per map node instance, never reused unlike the node's address
+inline uint64_t nextInstanceId() {
+  static std::atomic<uint64_t> nextId{1};
+  return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace map_helpers
 
 template <typename Traits>
@@ -236,6 +246,10 @@ struct ThriftMapFields {
     return storage_.size();
   }
 
+  typename StorageType::key_compare key_comp() const {
+    return storage_.key_comp();
+  }
+
   template <typename Fn>
   void forEachChild(Fn fn) {
     if constexpr (HasChildNodes) {
@@ -291,15 +305,49 @@ class ThriftMapNode
   using PathIter = typename std::vector<std::string>::const_iterator;
   using mapped_type = value_type;
   using const_iterator = typename Fields::const_iterator;
+  using ChangedKeys =
+      std::set<key_type, typename Fields::StorageType::key_compare>;
 
   using BaseT::BaseT;
+  using BaseT::clone;
+
+  /*
+   * Clone this map. If this map is published, the clone journals the keys it
+   * modifies from here on, so that a MapDelta between the two only has to
+   * look at those keys rather than merging both maps entry by entry.
+   */
+  std::shared_ptr<Derived> clone() const {
+    auto cloned = BaseT::clone();
+    if constexpr (Fields::HasChildNodes) {
+      if (this->isPublished()) {
+        Self* clonedSelf = cloned.get();
+        clonedSelf->journal_.baseId = instanceId_;
+      }
+    }
+    return cloned;
+  }
+
+  /*
+   * Keys that may differ between base and this map, or nullptr if this map
+   * was not cloned from base when base was already published, or if it was
+   * modified in a way that could not be journaled. Keys not in the returned
+   * set are guaranteed to map to the same node in both maps.
+   */
+  const ChangedKeys* changedKeysSince(const Self& base) const {
+    if (journal_.baseId == 0 || journal_.baseId != base.instanceId_) {
+      return nullptr;
+    }
+    return &journal_.keys;
+  }
 
   TType toThrift() const {
     return this->getFields()->toThrift();
   }
 
   void fromThrift(const TType& thrift) {
-    return this->writableFields()->fromThrift(thrift);
+    auto fields = this->writableFields();
+    dropJournal();
+    return fields->fromThrift(thrift);
   }
 
 #ifdef ENABLE_DYNAMIC_APIS
@@ -308,7 +356,9 @@ class ThriftMapNode
   }
 
   void fromFollyDynamic(const folly::dynamic& value) {
-    return this->writableFields()->fromDynamic(value);
+    auto fields = this->writableFields();
+    dropJournal();
+    return fields->fromDynamic(value);
   }
 #else
   folly::dynamic toFollyDynamic() const override {
@@ -322,7 +372,9 @@ class ThriftMapNode
 
   void fromEncodedBuf(fsdb::OperProtocol proto, folly::IOBuf&& encoded)
       override {
-    return this->writableFields()->fromEncodedBuf(proto, std::move(encoded));
+    auto fields = this->writableFields();
+    dropJournal();
+    return fields->fromEncodedBuf(proto, std::move(encoded));
   }
 
   value_type at(key_type key) const {
@@ -330,11 +382,11 @@ class ThriftMapNode
   }
 
   value_type& operator[](key_type key) {
-    return this->writableFields()->operator[](key);
+    return journaledFields(key)->operator[](key);
   }
 
   value_type& ref(key_type key) {
-    return this->writableFields()->ref(key);
+    return journaledFields(key)->ref(key);
   }
 
   const value_type& ref(key_type key) const {
@@ -347,7 +399,7 @@ class ThriftMapNode
 
   // prefer safe_ref/safe_cref for safe access
   auto safe_ref(key_type key) {
-    return detail::ref(this->writableFields()->ref(key));
+    return detail::ref(journaledFields(key)->ref(key));
   }
 
   auto safe_cref(key_type key) const {
@@ -357,26 +409,36 @@ class ThriftMapNode
   std::pair<typename Fields::iterator, bool> insert(
       key_type key,
       value_type&& val) {
-    return this->writableFields()->insert(key, std::move(val));
+    return journaledFields(key)->insert(key, std::move(val));
   }
 
   template <typename... Args>
   typename std::pair<typename Fields::iterator, bool> emplace(
       key_type key,
       Args&&... args) {
-    return this->writableFields()->emplace(key, std::forward<Args>(args)...);
+    return journaledFields(key)->emplace(key, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   typename std::pair<typename Fields::iterator, bool> try_emplace(
       key_type key,
       Args&&... args) {
-    return this->writableFields()->try_emplace(
+    return journaledFields(key)->try_emplace(
         key, std::forward<Args>(args)...);
   }
 
   bool remove(const std::string& token) {
-    return this->writableFields()->remove(token);
+    auto fields = this->writableFields();
+    if constexpr (std::is_same_v<
+                      typename Fields::KeyTypeClass,
+                      apache::thrift::type_class::string>) {
+      journalChange(token);
+    } else if (
+        auto key =
+            tryParseKey<key_type, typename Fields::KeyTypeClass>(token)) {
+      journalChange(key.value());
+    }
+    return fields->remove(token);
   }
 
   template <typename T = Fields>
@@ -385,17 +447,22 @@ class ThriftMapNode
                                            typename T::KeyTypeClass,
                                            apache::thrift::type_class::string>,
                                        bool> {
-    return this->writableFields()->remove(key);
+    return journaledFields(key)->remove(key);
   }
 
   auto erase(typename Fields::iterator it) {
-    return this->writableFields()->erase(it);
+    return journaledFields(it->first)->erase(it);
   }
 
   // iterators
 
+  // Entries reached through mutable iterators cannot be journaled, except for
+  // the entry returned by find(). Note that end() is exempt, it is only ever
+  // compared against.
   typename Fields::iterator begin() {
-    return this->writableFields()->begin();
+    auto fields = this->writableFields();
+    dropJournal();
+    return fields->begin();
   }
 
   typename Fields::const_iterator begin() const {
@@ -419,7 +486,7 @@ class ThriftMapNode
   }
 
   typename Fields::iterator find(const key_type& key) {
-    return this->writableFields()->find(key);
+    return journaledFields(key)->find(key);
   }
 
   typename Fields::const_iterator find(const key_type& key) const {
@@ -484,11 +551,49 @@ class ThriftMapNode
   }
 
   void clear() {
-    this->writableFields()->clear();
+    auto fields = this->writableFields();
+    dropJournal();
+    fields->clear();
   }
 
  private:
   friend class CloneAllocator;
+
+  // Once this many keys are journaled, merging both maps is about as cheap
+  // as looking up every journaled key in each of them
+  static constexpr size_t kMinJournalLimit = 64;
+
+  struct ChangeJournal {
+    // instance id of the published map this one was cloned from, 0 if the
+    // journal is not in use
+    uint64_t baseId{0};
+    ChangedKeys keys;
+  };
+
+  Fields* journaledFields(const key_type& key) {
+    auto fields = this->writableFields();
+    journalChange(key);
+    return fields;
+  }
+
+  void journalChange(const key_type& key) {
+    if (journal_.baseId == 0) {
+      return;
+    }
+    journal_.keys.insert(key);
+    if (journal_.keys.size() >
+        std::max(kMinJournalLimit, this->getFields()->size() / 4)) {
+      dropJournal();
+    }
+  }
+
+  void dropJournal() {
+    journal_.baseId = 0;
+    journal_.keys.clear();
+  }
+
+  uint64_t instanceId_{map_helpers::nextInstanceId()};
+  ChangeJournal journal_;
 };
 
 } // namespace facebook::fboss::thrift_cow
@@ -23,6 +23,7 @@
 #include "fboss/agent/state/MapDelta.h"
 
 #include <gtest/gtest.h>
+#include <tuple>
 #include <type_traits>
 
 using namespace facebook::fboss;
@@ -622,3 +623,62 @@ TEST(ThriftMapNodeTests, MapDelta) {
     EXPECT_EQ(newNode->toThrift(), buildPortRange(1001, 1999));
   });
 }
+
+TEST(ThriftMapNodeTests, MapDeltaChangeJournal) {
+  using Map = ThriftMapNode<ThriftMapTraits<
+      apache::thrift::type_class::map<
+          apache::thrift::type_class::enumeration,
+          apache::thrift::type_class::structure>,
+      std::unordered_map<TestEnum, cfg::L4PortRange>>>;
+
+  std::unordered_map<TestEnum, cfg::L4PortRange> data = {
+      {TestEnum::FIRST, buildPortRange(1000, 1999)},
+      {TestEnum::SECOND, buildPortRange(2000, 2999)}};
+
+  auto map = std::make_shared<Map>(data);
+  // clones of unpublished maps are not journaled
+  EXPECT_EQ(map->clone()->changedKeysSince(*map), nullptr);
+
+  map->publish();
+  auto map1 = map->clone();
+  ASSERT_NE(map1->changedKeysSince(*map), nullptr);
+  EXPECT_TRUE(map1->changedKeysSince(*map)->empty());
+
+  map1->remove(TestEnum::FIRST);
+  map1->emplace(TestEnum::FIRST, buildPortRange(1001, 1999));
+  map1->emplace(TestEnum::THIRD, buildPortRange(3000, 3999));
+  // looked up but left unchanged
+  map1->find(TestEnum::SECOND);
+  EXPECT_EQ(
+      *map1->changedKeysSince(*map),
+      Map::ChangedKeys({TestEnum::FIRST, TestEnum::SECOND, TestEnum::THIRD}));
+
+  auto countChanges = [](const Map* oldMap, const Map* newMap) {
+    int added = 0, removed = 0, changed = 0;
+    DeltaFunctions::forEachChanged(
+        ThriftMapDelta(oldMap, newMap),
+        [&](auto, auto) { ++changed; },
+        [&](auto) { ++added; },
+        [&](auto) { ++removed; });
+    return std::make_tuple(added, removed, changed);
+  };
+  EXPECT_EQ(countChanges(map.get(), map1.get()), std::make_tuple(1, 0, 1));
+  // a delta back to the parent map uses the same journal
+  EXPECT_EQ(countChanges(map1.get(), map.get()), std::make_tuple(0, 1, 1));
+
+  // journals only apply to direct parent and child
+  map1->publish();
+  auto map2 = map1->clone();
+  map2->remove(TestEnum::THIRD);
+  EXPECT_EQ(map2->changedKeysSince(*map), nullptr);
+  EXPECT_EQ(countChanges(map.get(), map2.get()), std::make_tuple(0, 0, 1));
+  EXPECT_EQ(countChanges(map1.get(), map2.get()), std::make_tuple(0, 1, 0));
+
+  // mutable iteration can not be journaled
+  auto map3 = map1->clone();
+  for (auto& entry : *map3) {
+    entry.second = entry.second->clone();
+  }
+  EXPECT_EQ(map3->changedKeysSince(*map1), nullptr);
+  EXPECT_EQ(countChanges(map1.get(), map3.get()), std::make_tuple(0, 0, 3));
+}
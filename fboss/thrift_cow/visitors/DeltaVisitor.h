@@ -489,33 +489,56 @@ struct DeltaVisitor<
       Func&& f) {
     bool hasDifferences{false};
 
-    // changed fields
-    for (const auto& [key, val] : oldFields) {
-      traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
-      if (auto it = newFields.find(key); it != newFields.end()) {
-        if (DeltaVisitor<MappedTypeClass>::visit(
-                traverser, val, it->second, options, std::forward<Func>(f))) {
-          hasDifferences = true;
-        }
-      } else {
+    // Both storages are ordered by the same comparator, so walk them
+    // together in a single linear merge instead of doing a lookup per key
+    // in the opposite map. Entries that are identical (same child pointer
+    // or same primitive value) are skipped before any path token is
+    // materialized, which keeps the cost of diffing large maps with few
+    // changes proportional to the number of entries rather than paying a
+    // string conversion for each one.
+    const auto keyLess = oldFields.key_comp();
+    auto oldIt = oldFields.cbegin();
+    auto newIt = newFields.cbegin();
+    while (oldIt != oldFields.cend() || newIt != newFields.cend()) {
+      if (newIt == newFields.cend() ||
+          (oldIt != oldFields.cend() && keyLess(oldIt->first, newIt->first))) {
+        // key only present in old map
+        const auto& [key, val] = *oldIt;
         hasDifferences = true;
+        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
         dv_detail::visitAddedOrRemovedNode<MappedTypeClass>(
             traverser, val, decltype(val){}, options, std::forward<Func>(f));
-      }
-      traverser.pop(TCType<MappedTypeClass>);
-    }
-
-    for (const auto& [key, val] : newFields) {
-      if (oldFields.find(key) == oldFields.end()) {
-        // only look at keys that didn't exist. First loop should handle all
-        // replacement deltas
+        traverser.pop(TCType<MappedTypeClass>);
+        ++oldIt;
+      } else if (
+          oldIt == oldFields.cend() || keyLess(newIt->first, oldIt->first)) {
+        // key only present in new map
+        const auto& [key, val] = *newIt;
         hasDifferences = true;
         traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
-
         dv_detail::visitAddedOrRemovedNode<MappedTypeClass>(
             traverser, decltype(val){}, val, options, std::forward<Func>(f));
-
         traverser.pop(TCType<MappedTypeClass>);
+        ++newIt;
+      } else {
+        // key present in both, only recurse if the entry changed
+        const auto& [key, oldVal] = *oldIt;
+        const auto& newVal = newIt->second;
+        if (oldVal != newVal) {
+          traverser.push(
+              folly::to<std::string>(key), TCType<MappedTypeClass>);
+          if (DeltaVisitor<MappedTypeClass>::visit(
+                  traverser,
+                  oldVal,
+                  newVal,
+                  options,
+                  std::forward<Func>(f))) {
+            hasDifferences = true;
+          }
+          traverser.pop(TCType<MappedTypeClass>);
+        }
+        ++oldIt;
+        ++newIt;
       }
     }
 
@@ -0,0 +1,126 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <fboss/thrift_cow/visitors/DeltaVisitor.h>
+#include "fboss/thrift_cow/nodes/Types.h"
+#include "fboss/thrift_cow/nodes/tests/gen-cpp2/test_fatal_types.h"
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+namespace {
+
+using k = facebook::fboss::test_tags::strings;
+using config_k = facebook::fboss::cfg::switch_config_tags::strings;
+using TestNode = ThriftStructNode<TestStruct>;
+
+std::shared_ptr<TestNode> makeLargeMapNode(int numEntries) {
+  TestStruct s;
+  for (int i = 0; i < numEntries; ++i) {
+    cfg::L4PortRange range;
+    range.min() = i;
+    range.max() = i + 1;
+    s.mapOfI32ToStruct()[i] = std::move(range);
+    s.mapOfI32ToI32()[i] = i;
+  }
+  auto node = std::make_shared<TestNode>(s);
+  node->publish();
+  return node;
+}
+
+size_t countDeltas(
+    const std::shared_ptr<TestNode>& oldNode,
+    const std::shared_ptr<TestNode>& newNode) {
+  size_t numDeltas{0};
+  RootDeltaVisitor::visit(
+      oldNode,
+      newNode,
+      DeltaVisitOptions(DeltaVisitMode::MINIMAL),
+      [&](const std::vector<std::string>& /*path*/,
+          auto&& /*oldValue*/,
+          auto&& /*newValue*/,
+          auto&& /*tag*/) { ++numDeltas; });
+  return numDeltas;
+}
+
+} // namespace
+
+/*
+ * Diff two generations of a large map of structs where only a single
+ * entry differs. All other children are shared between the generations.
+ */
+void DeltaVisitorMapOfStructsOneChange(uint32_t iters, int numEntries) {
+  std::shared_ptr<TestNode> oldNode, newNode;
+  BENCHMARK_SUSPEND {
+    oldNode = makeLargeMapNode(numEntries);
+    newNode = oldNode->clone();
+    auto map = newNode->modify<k::mapOfI32ToStruct>();
+    map->modifyTyped(numEntries / 2);
+    map->at(numEntries / 2)->ref<config_k::max>() = numEntries * 2;
+    newNode->publish();
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(countDeltas(oldNode, newNode));
+  }
+}
+
+/*
+ * Diff two generations of a large map of primitives where only a single
+ * entry differs.
+ */
+void DeltaVisitorMapOfPrimitivesOneChange(uint32_t iters, int numEntries) {
+  std::shared_ptr<TestNode> oldNode, newNode;
+  BENCHMARK_SUSPEND {
+    oldNode = makeLargeMapNode(numEntries);
+    newNode = oldNode->clone();
+    auto map = newNode->modify<k::mapOfI32ToI32>();
+    map->ref(numEntries / 2) = numEntries * 2;
+    newNode->publish();
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(countDeltas(oldNode, newNode));
+  }
+}
+
+/*
+ * Diff two generations where half of the map entries were replaced by
+ * new keys, exercising the added/removed paths of the merge.
+ */
+void DeltaVisitorMapOfStructsHalfReplaced(uint32_t iters, int numEntries) {
+  std::shared_ptr<TestNode> oldNode, newNode;
+  BENCHMARK_SUSPEND {
+    oldNode = makeLargeMapNode(numEntries);
+    newNode = oldNode->clone();
+    auto map = newNode->modify<k::mapOfI32ToStruct>();
+    for (int i = 0; i < numEntries; i += 2) {
+      map->remove(i);
+      cfg::L4PortRange range;
+      range.min() = numEntries + i;
+      map->emplace(numEntries + i, range);
+    }
+    newNode->publish();
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    folly::doNotOptimizeAway(countDeltas(oldNode, newNode));
+  }
+}
+
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsOneChange, 1000);
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsOneChange, 10000);
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsOneChange, 100000);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(DeltaVisitorMapOfPrimitivesOneChange, 1000);
+BENCHMARK_PARAM(DeltaVisitorMapOfPrimitivesOneChange, 10000);
+BENCHMARK_PARAM(DeltaVisitorMapOfPrimitivesOneChange, 100000);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsHalfReplaced, 1000);
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsHalfReplaced, 10000);
+BENCHMARK_PARAM(DeltaVisitorMapOfStructsHalfReplaced, 100000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}